@@ -9,6 +9,18 @@
  * ---------------------------------------------------------------------------------------------------------------------
  */
 
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef ICIRCULARBUFFER_NOTIFY
+#include <sys/eventfd.h>
+#include <unistd.h>
+#endif
+
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && defined( __SSE2__ )
+#include <immintrin.h>
+#endif
+
 #include "CircularBuffer.h"
 
 /**
@@ -17,6 +29,130 @@
  * ---------------------------------------------------------------------------------------------------------------------
  */
 
+/**
+ * @def   CIRCULARBUFFER_STATISTICS_PUSH(pCircularBuffer, requested, count)
+ * @brief Record a push/commit of count out of requested bytes, compiled out unless ICIRCULARBUFFER_STATISTICS.
+ *
+ * @def   CIRCULARBUFFER_STATISTICS_POP(pCircularBuffer, requested, count)
+ * @brief Record a pop/release of count out of requested bytes, compiled out unless ICIRCULARBUFFER_STATISTICS.
+ */
+#ifdef ICIRCULARBUFFER_STATISTICS
+#define CIRCULARBUFFER_STATISTICS_PUSH(pCircularBuffer, requested, count) \
+    CircularBuffer_StatisticsPush( (pCircularBuffer), (requested), (count) )
+#define CIRCULARBUFFER_STATISTICS_POP(pCircularBuffer, requested, count) \
+    CircularBuffer_StatisticsPop( (pCircularBuffer), (requested), (count) )
+#else
+#define CIRCULARBUFFER_STATISTICS_PUSH(pCircularBuffer, requested, count) ( (void)(requested) )
+#define CIRCULARBUFFER_STATISTICS_POP(pCircularBuffer, requested, count)  ( (void)(requested) )
+#endif
+
+/**
+ * @def   CIRCULARBUFFER_NOTIFY(pCircularBuffer)
+ * @brief Update eventfds after the positions changed, compiled out unless ICIRCULARBUFFER_NOTIFY.
+ */
+#ifdef ICIRCULARBUFFER_NOTIFY
+#define CIRCULARBUFFER_NOTIFY(pCircularBuffer) CircularBuffer_Notify( (pCircularBuffer) )
+#else
+#define CIRCULARBUFFER_NOTIFY(pCircularBuffer) ( (void)0 )
+#endif
+
+/**
+ * @def   CIRCULARBUFFER_CLAIM(pCircularBuffer, position)
+ * @brief Tell concurrent readers data up to position is about to be written, compiled out unless
+ *        ICIRCULARBUFFER_READERS.
+ *
+ * @def   CIRCULARBUFFER_PUBLISH(pCircularBuffer, position)
+ * @brief Make data up to position visible to concurrent readers, compiled out unless ICIRCULARBUFFER_READERS.
+ */
+#ifdef ICIRCULARBUFFER_READERS
+#define CIRCULARBUFFER_CLAIM(pCircularBuffer, position)                                      \
+    ( atomic_store_explicit( &(pCircularBuffer)->claimed, (position), memory_order_relaxed ), \
+      atomic_thread_fence( memory_order_release ) )
+#define CIRCULARBUFFER_PUBLISH(pCircularBuffer, position) \
+    atomic_store_explicit( &(pCircularBuffer)->published, (position), memory_order_release )
+#else
+#define CIRCULARBUFFER_CLAIM(pCircularBuffer, position)   ( (void)0 )
+#define CIRCULARBUFFER_PUBLISH(pCircularBuffer, position) ( (void)0 )
+#endif
+
+/**
+ * @def   CIRCULARBUFFER_GROW(pCircularBuffer, count)
+ * @brief Make room for count more bytes if the buffer is growable.
+ *
+ * @def   CIRCULARBUFFER_SHRINK(pCircularBuffer)
+ * @brief Give back buffer memory no longer needed if the buffer is growable.
+ */
+#define CIRCULARBUFFER_GROW(pCircularBuffer, count) \
+    ( ( (pCircularBuffer)->pGrowth != NULL ) ? CircularBuffer_Grow( (pCircularBuffer), (count) ) : (void)0 )
+#define CIRCULARBUFFER_SHRINK(pCircularBuffer) \
+    ( ( (pCircularBuffer)->pGrowth != NULL ) ? CircularBuffer_Shrink( (pCircularBuffer) ) : (void)0 )
+
+/**
+ * @def   CIRCULARBUFFER_BULK(pCircularBuffer, count)
+ * @brief Copy of count bytes is to bypass the cache, as set with ICircularBuffer_SetBulkThreshold.
+ *
+ * @def   CIRCULARBUFFER_COPY(pCircularBuffer, pDestination, pSource, count)
+ * @brief Copy data between buffer memory and caller, streaming it if at or above bulk threshold.
+ */
+#define CIRCULARBUFFER_BULK(pCircularBuffer, count) \
+    ( (pCircularBuffer)->bulkThreshold != 0 && (count) >= (pCircularBuffer)->bulkThreshold )
+#define CIRCULARBUFFER_COPY(pCircularBuffer, pDestination, pSource, count) \
+    ( CIRCULARBUFFER_BULK( (pCircularBuffer), (count) )                    \
+    ? CircularBuffer_CopyBulk( (pDestination), (pSource), (count) )        \
+    : (void)memcpy( (pDestination), (pSource), (count) ) )
+
+/**
+ * @def   CIRCULARBUFFER_COPY_IN(pCircularBuffer, pDestination, pSource, count)
+ * @brief Copy pushed data into buffer memory, updating the running CRC32C on the way if ICIRCULARBUFFER_CRC.
+ *
+ * @def   CIRCULARBUFFER_CRC_UPDATE(pCircularBuffer, pData, count)
+ * @brief Update running CRC32C with data not copied by push, compiled out unless ICIRCULARBUFFER_CRC.
+ */
+#ifdef ICIRCULARBUFFER_CRC
+#define CIRCULARBUFFER_CRC_UPDATE(pCircularBuffer, pData, count) \
+    ( (pCircularBuffer)->crc = CircularBuffer_CopyCrc( NULL, (pData), (count), (pCircularBuffer)->crc ) )
+#define CIRCULARBUFFER_COPY_IN(pCircularBuffer, pDestination, pSource, count)                      \
+    ( CIRCULARBUFFER_BULK( (pCircularBuffer), (count) )                                            \
+    ? ( CIRCULARBUFFER_CRC_UPDATE( (pCircularBuffer), (pSource), (count) ),                        \
+        CircularBuffer_CopyBulk( (pDestination), (pSource), (count) ) )                            \
+    : (void)( (pCircularBuffer)->crc = CircularBuffer_CopyCrc( (pDestination), (pSource), (count), \
+                                                               (pCircularBuffer)->crc ) ) )
+#else
+#define CIRCULARBUFFER_CRC_UPDATE(pCircularBuffer, pData, count) ( (void)0 )
+#define CIRCULARBUFFER_COPY_IN(pCircularBuffer, pDestination, pSource, count) \
+    CIRCULARBUFFER_COPY( (pCircularBuffer), (pDestination), (pSource), (count) )
+#endif
+
+/**
+ * @def   CIRCULARBUFFER_CRC_SSE42
+ * @brief Defined when the running CRC32C can use the SSE4.2 crc32 instruction, if the CPU turns out to have it.
+ */
+#if defined( ICIRCULARBUFFER_CRC ) && defined( __x86_64__ )
+#define CIRCULARBUFFER_CRC_SSE42
+#endif
+
+/**
+ * @def   CIRCULARBUFFER_FIND_SIMD
+ * @brief Defined when byte search can use SSE2, and AVX2 if the CPU turns out to have it.
+ */
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && defined( __SSE2__ )
+#define CIRCULARBUFFER_FIND_SIMD
+#endif
+
+/**
+ * @def   CIRCULARBUFFER_BULK_SIMD
+ * @brief Defined when bulk copies can use SSE2 streaming stores and prefetch, memcpy otherwise.
+ */
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && defined( __SSE2__ )
+#define CIRCULARBUFFER_BULK_SIMD
+#endif
+
+/**
+ * @def   CIRCULARBUFFER_BULK_PREFETCH
+ * @brief How far ahead of the bulk copy the source is prefetched, in bytes.
+ */
+#define CIRCULARBUFFER_BULK_PREFETCH 512
+
 /**
  * ---------------------------------------------------------------------------------------------------------------------
  * Types
@@ -30,7 +166,7 @@
  */
 
 /**
- * @brief     Get number of bytes until either write pointer or end of buffer.
+ * @brief     Get number of bytes until either write position or end of buffer.
  *
  * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
  *
@@ -39,12 +175,279 @@
  */
 size_t CircularBuffer_BytesUntilEnd( CircularBuffer_t *pCircularBuffer );
 
+/**
+ * @brief     Get number of bytes of contiguous buffer memory from position.
+ *
+ * @attention For a mirrored buffer the memory continues past the end, so a full buffer size is always contiguous.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     position[in]        Free-running position (read or write).
+ *
+ * @return
+ *      - Number of contiguous bytes from position.
+ */
+size_t CircularBuffer_ContiguousFrom( CircularBuffer_t *pCircularBuffer, uint64_t position );
+
+/**
+ * @brief     Split count bytes starting at position into segments before and after end of buffer memory.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     position[in]        Free-running position of start of range (read or write).
+ * @param     count[in]           Number of bytes in range.
+ * @param     pSegments[out]      Array of ICIRCULARBUFFER_SEGMENT_COUNT segments to fill in.
+ */
+void CircularBuffer_Split( CircularBuffer_t *pCircularBuffer, uint64_t position, size_t count, CircularBufferSegment_t *pSegments );
+
+/**
+ * @brief     Check whether data at position matches pattern, which may be split by end of buffer memory.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     position[in]        Free-running position to compare at, with at least length bytes readable.
+ * @param     pPattern[in]        Bytes to compare with.
+ * @param     length[in]          Number of bytes in pattern.
+ *
+ * @return
+ *      - true:  Match.
+ *      - false: No match.
+ */
+bool CircularBuffer_Matches( CircularBuffer_t *pCircularBuffer, uint64_t position, uint8_t const *pPattern, size_t length );
+
+/**
+ * @brief     Find first occurrence of a byte in contiguous memory, with the fastest kernel the CPU supports.
+ *
+ * @param     pData[in]           Memory to search.
+ * @param     size[in]            Number of bytes to search.
+ * @param     value[in]           Byte to search for.
+ *
+ * @return
+ *      - Index of byte, or size if not found.
+ */
+size_t CircularBuffer_FindByte( uint8_t const *pData, size_t size, uint8_t value );
+
+/**
+ * @brief     Find first occurrence of a byte in contiguous memory, one byte at a time.
+ *
+ * @param     pData[in]           Memory to search.
+ * @param     size[in]            Number of bytes to search.
+ * @param     value[in]           Byte to search for.
+ *
+ * @return
+ *      - Index of byte, or size if not found.
+ */
+size_t CircularBuffer_FindByteScalar( uint8_t const *pData, size_t size, uint8_t value );
+
+#ifdef CIRCULARBUFFER_FIND_SIMD
+/**
+ * @brief     Find first occurrence of a byte in contiguous memory, 16 bytes at a time with SSE2.
+ *
+ * @param     pData[in]           Memory to search.
+ * @param     size[in]            Number of bytes to search.
+ * @param     value[in]           Byte to search for.
+ *
+ * @return
+ *      - Index of byte, or size if not found.
+ */
+size_t CircularBuffer_FindByteSse2( uint8_t const *pData, size_t size, uint8_t value );
+
+/**
+ * @brief     Find first occurrence of a byte in contiguous memory, 64 bytes at a time with AVX2.
+ *
+ * @attention Only call if the CPU supports AVX2.
+ *
+ * @param     pData[in]           Memory to search.
+ * @param     size[in]            Number of bytes to search.
+ * @param     value[in]           Byte to search for.
+ *
+ * @return
+ *      - Index of byte, or size if not found.
+ */
+size_t CircularBuffer_FindByteAvx2( uint8_t const *pData, size_t size, uint8_t value );
+#endif
+
+/**
+ * @brief     Copy contiguous memory with non-temporal stores, prefetching the source ahead, so neither is left in
+ *            cache. Plain memcpy without SSE2.
+ *
+ * @param     pDestination[out]   Where data is to be copied to.
+ * @param     pSource[in]         Where data is to be copied from.
+ * @param     size[in]            Number of bytes.
+ */
+void CircularBuffer_CopyBulk( uint8_t *pDestination, uint8_t const *pSource, size_t size );
+
+/**
+ * @brief     Grow buffer memory of a growable buffer, if count more bytes would fill it above the high watermark.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     count[in]           Number of bytes about to be added.
+ */
+void CircularBuffer_Grow( CircularBuffer_t *pCircularBuffer, size_t count );
+
+/**
+ * @brief     Shrink buffer memory of a growable buffer, while data fills it below the low watermark.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ */
+void CircularBuffer_Shrink( CircularBuffer_t *pCircularBuffer );
+
+/**
+ * @brief     Move data of a growable buffer to new buffer memory of another size, to its start.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     bufferSize[in]      New size of buffer memory, at least the number of bytes in buffer.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Out of memory, buffer unchanged.
+ */
+bool CircularBuffer_Resize( CircularBuffer_t *pCircularBuffer, size_t bufferSize );
+
+/**
+ * @brief     Push data in overwrite mode, dropping the oldest data to make room.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     pData[in]           Where data is to be copied from.
+ * @param     count[in]           Number of bytes to push.
+ *
+ * @return
+ *      - Number of bytes pushed, always count.
+ */
+size_t CircularBuffer_PushOverwrite( CircularBuffer_t *pCircularBuffer, uint8_t *pData, size_t count );
+
+#ifdef ICIRCULARBUFFER_STATISTICS
+/**
+ * @brief     Update statistics after bytes were added to buffer.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     requested[in]       Number of bytes caller wanted to add.
+ * @param     count[in]           Number of bytes added.
+ */
+void CircularBuffer_StatisticsPush( CircularBuffer_t *pCircularBuffer, size_t requested, size_t count );
+
+/**
+ * @brief     Update statistics after bytes were removed from buffer.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     requested[in]       Number of bytes caller wanted to remove.
+ * @param     count[in]           Number of bytes removed.
+ */
+void CircularBuffer_StatisticsPop( CircularBuffer_t *pCircularBuffer, size_t requested, size_t count );
+
+/**
+ * @brief     Count current number of bytes in buffer in occupancy histogram.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ */
+void CircularBuffer_StatisticsOccupancy( CircularBuffer_t *pCircularBuffer );
+#endif
+
+#ifdef ICIRCULARBUFFER_NOTIFY
+/**
+ * @brief     Signal or drain eventfds whose condition changed. Costs no system call if nothing changed.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ */
+void CircularBuffer_Notify( CircularBuffer_t *pCircularBuffer );
+
+/**
+ * @brief     Make eventfd readable or not, by adding to or draining its count.
+ *
+ * @param     fd[in]              Eventfd to update.
+ * @param     signal[in]          true to make readable, false to drain.
+ */
+void CircularBuffer_NotifySet( int fd, bool signal );
+#endif
+
+#ifdef ICIRCULARBUFFER_CRC
+/**
+ * @brief     Update CRC32C register with data, copying it to destination on the way, in the same pass.
+ *
+ * @param     pDestination[out]   Where data is to be copied to, NULL to only update the CRC.
+ * @param     pSource[in]         Where data is to be copied from.
+ * @param     count[in]           Number of bytes.
+ * @param     crc[in]             CRC32C register before data, not inverted.
+ *
+ * @return
+ *      - CRC32C register after data, not inverted.
+ */
+uint32_t CircularBuffer_CopyCrc( uint8_t *pDestination, uint8_t const *pSource, size_t count, uint32_t crc );
+
+/**
+ * @brief     Update CRC32C register with data a byte at a time from a lookup table, then copy it if wanted.
+ *
+ * @param     pDestination[out]   Where data is to be copied to, NULL to only update the CRC.
+ * @param     pSource[in]         Where data is to be copied from.
+ * @param     count[in]           Number of bytes.
+ * @param     crc[in]             CRC32C register before data, not inverted.
+ *
+ * @return
+ *      - CRC32C register after data, not inverted.
+ */
+uint32_t CircularBuffer_CopyCrcTable( uint8_t *pDestination, uint8_t const *pSource, size_t count, uint32_t crc );
+
+#ifdef CIRCULARBUFFER_CRC_SSE42
+/**
+ * @brief     Update CRC32C register with data 8 bytes at a time with SSE4.2, copying it to destination on the way.
+ *
+ * @attention Only call if the CPU supports SSE4.2.
+ *
+ * @param     pDestination[out]   Where data is to be copied to, NULL to only update the CRC.
+ * @param     pSource[in]         Where data is to be copied from.
+ * @param     count[in]           Number of bytes.
+ * @param     crc[in]             CRC32C register before data, not inverted.
+ *
+ * @return
+ *      - CRC32C register after data, not inverted.
+ */
+uint32_t CircularBuffer_CopyCrcSse42( uint8_t *pDestination, uint8_t const *pSource, size_t count, uint32_t crc );
+#endif
+#endif
+
 /**
  * ---------------------------------------------------------------------------------------------------------------------
  * Variables
  * ---------------------------------------------------------------------------------------------------------------------
  */
 
+#ifdef ICIRCULARBUFFER_CRC
+/**
+ * CRC32C of every byte value, reflected polynomial 0x82F63B78
+ */
+static uint32_t const crc32cTable[ 256 ] = {
+    0x00000000u, 0xF26B8303u, 0xE13B70F7u, 0x1350F3F4u, 0xC79A971Fu, 0x35F1141Cu, 0x26A1E7E8u, 0xD4CA64EBu,
+    0x8AD958CFu, 0x78B2DBCCu, 0x6BE22838u, 0x9989AB3Bu, 0x4D43CFD0u, 0xBF284CD3u, 0xAC78BF27u, 0x5E133C24u,
+    0x105EC76Fu, 0xE235446Cu, 0xF165B798u, 0x030E349Bu, 0xD7C45070u, 0x25AFD373u, 0x36FF2087u, 0xC494A384u,
+    0x9A879FA0u, 0x68EC1CA3u, 0x7BBCEF57u, 0x89D76C54u, 0x5D1D08BFu, 0xAF768BBCu, 0xBC267848u, 0x4E4DFB4Bu,
+    0x20BD8EDEu, 0xD2D60DDDu, 0xC186FE29u, 0x33ED7D2Au, 0xE72719C1u, 0x154C9AC2u, 0x061C6936u, 0xF477EA35u,
+    0xAA64D611u, 0x580F5512u, 0x4B5FA6E6u, 0xB93425E5u, 0x6DFE410Eu, 0x9F95C20Du, 0x8CC531F9u, 0x7EAEB2FAu,
+    0x30E349B1u, 0xC288CAB2u, 0xD1D83946u, 0x23B3BA45u, 0xF779DEAEu, 0x05125DADu, 0x1642AE59u, 0xE4292D5Au,
+    0xBA3A117Eu, 0x4851927Du, 0x5B016189u, 0xA96AE28Au, 0x7DA08661u, 0x8FCB0562u, 0x9C9BF696u, 0x6EF07595u,
+    0x417B1DBCu, 0xB3109EBFu, 0xA0406D4Bu, 0x522BEE48u, 0x86E18AA3u, 0x748A09A0u, 0x67DAFA54u, 0x95B17957u,
+    0xCBA24573u, 0x39C9C670u, 0x2A993584u, 0xD8F2B687u, 0x0C38D26Cu, 0xFE53516Fu, 0xED03A29Bu, 0x1F682198u,
+    0x5125DAD3u, 0xA34E59D0u, 0xB01EAA24u, 0x42752927u, 0x96BF4DCCu, 0x64D4CECFu, 0x77843D3Bu, 0x85EFBE38u,
+    0xDBFC821Cu, 0x2997011Fu, 0x3AC7F2EBu, 0xC8AC71E8u, 0x1C661503u, 0xEE0D9600u, 0xFD5D65F4u, 0x0F36E6F7u,
+    0x61C69362u, 0x93AD1061u, 0x80FDE395u, 0x72966096u, 0xA65C047Du, 0x5437877Eu, 0x4767748Au, 0xB50CF789u,
+    0xEB1FCBADu, 0x197448AEu, 0x0A24BB5Au, 0xF84F3859u, 0x2C855CB2u, 0xDEEEDFB1u, 0xCDBE2C45u, 0x3FD5AF46u,
+    0x7198540Du, 0x83F3D70Eu, 0x90A324FAu, 0x62C8A7F9u, 0xB602C312u, 0x44694011u, 0x5739B3E5u, 0xA55230E6u,
+    0xFB410CC2u, 0x092A8FC1u, 0x1A7A7C35u, 0xE811FF36u, 0x3CDB9BDDu, 0xCEB018DEu, 0xDDE0EB2Au, 0x2F8B6829u,
+    0x82F63B78u, 0x709DB87Bu, 0x63CD4B8Fu, 0x91A6C88Cu, 0x456CAC67u, 0xB7072F64u, 0xA457DC90u, 0x563C5F93u,
+    0x082F63B7u, 0xFA44E0B4u, 0xE9141340u, 0x1B7F9043u, 0xCFB5F4A8u, 0x3DDE77ABu, 0x2E8E845Fu, 0xDCE5075Cu,
+    0x92A8FC17u, 0x60C37F14u, 0x73938CE0u, 0x81F80FE3u, 0x55326B08u, 0xA759E80Bu, 0xB4091BFFu, 0x466298FCu,
+    0x1871A4D8u, 0xEA1A27DBu, 0xF94AD42Fu, 0x0B21572Cu, 0xDFEB33C7u, 0x2D80B0C4u, 0x3ED04330u, 0xCCBBC033u,
+    0xA24BB5A6u, 0x502036A5u, 0x4370C551u, 0xB11B4652u, 0x65D122B9u, 0x97BAA1BAu, 0x84EA524Eu, 0x7681D14Du,
+    0x2892ED69u, 0xDAF96E6Au, 0xC9A99D9Eu, 0x3BC21E9Du, 0xEF087A76u, 0x1D63F975u, 0x0E330A81u, 0xFC588982u,
+    0xB21572C9u, 0x407EF1CAu, 0x532E023Eu, 0xA145813Du, 0x758FE5D6u, 0x87E466D5u, 0x94B49521u, 0x66DF1622u,
+    0x38CC2A06u, 0xCAA7A905u, 0xD9F75AF1u, 0x2B9CD9F2u, 0xFF56BD19u, 0x0D3D3E1Au, 0x1E6DCDEEu, 0xEC064EEDu,
+    0xC38D26C4u, 0x31E6A5C7u, 0x22B65633u, 0xD0DDD530u, 0x0417B1DBu, 0xF67C32D8u, 0xE52CC12Cu, 0x1747422Fu,
+    0x49547E0Bu, 0xBB3FFD08u, 0xA86F0EFCu, 0x5A048DFFu, 0x8ECEE914u, 0x7CA56A17u, 0x6FF599E3u, 0x9D9E1AE0u,
+    0xD3D3E1ABu, 0x21B862A8u, 0x32E8915Cu, 0xC083125Fu, 0x144976B4u, 0xE622F5B7u, 0xF5720643u, 0x07198540u,
+    0x590AB964u, 0xAB613A67u, 0xB831C993u, 0x4A5A4A90u, 0x9E902E7Bu, 0x6CFBAD78u, 0x7FAB5E8Cu, 0x8DC0DD8Fu,
+    0xE330A81Au, 0x115B2B19u, 0x020BD8EDu, 0xF0605BEEu, 0x24AA3F05u, 0xD6C1BC06u, 0xC5914FF2u, 0x37FACCF1u,
+    0x69E9F0D5u, 0x9B8273D6u, 0x88D28022u, 0x7AB90321u, 0xAE7367CAu, 0x5C18E4C9u, 0x4F48173Du, 0xBD23943Eu,
+    0xF36E6F75u, 0x0105EC76u, 0x12551F82u, 0xE03E9C81u, 0x34F4F86Au, 0xC69F7B69u, 0xD5CF889Du, 0x27A40B9Eu,
+    0x79B737BAu, 0x8BDCB4B9u, 0x988C474Du, 0x6AE7C44Eu, 0xBE2DA0A5u, 0x4C4623A6u, 0x5F16D052u, 0xAD7D5351u,
+};
+#endif
+
 /**
  * ---------------------------------------------------------------------------------------------------------------------
  * Interface functions
@@ -72,8 +475,31 @@ bool ICircularBuffer_Init( CircularBuffer_t *pCircularBuffer, uint8_t *pBuffer,
 
     pCircularBuffer->bufferSize = bufferSize;
     pCircularBuffer->pBuffer    = pBuffer;
-    pCircularBuffer->pWrite     = pBuffer;
-    pCircularBuffer->pRead      = pBuffer;
+    pCircularBuffer->write      = 0;
+    pCircularBuffer->read       = 0;
+    pCircularBuffer->mirrored   = false;
+    pCircularBuffer->overwrite  = false;
+    pCircularBuffer->overwritten = 0;
+    pCircularBuffer->pGrowth     = NULL;
+    pCircularBuffer->bulkThreshold = 0;
+#ifdef ICIRCULARBUFFER_READERS
+    atomic_init( &pCircularBuffer->claimed,   0 );
+    atomic_init( &pCircularBuffer->published, 0 );
+#endif
+#ifdef ICIRCULARBUFFER_STATISTICS
+    memset( &pCircularBuffer->statistics, 0, sizeof( pCircularBuffer->statistics ) );
+#endif
+#ifdef ICIRCULARBUFFER_NOTIFY
+    pCircularBuffer->dataFd         = -1;
+    pCircularBuffer->spaceFd        = -1;
+    pCircularBuffer->spaceThreshold = 0;
+    pCircularBuffer->dataSignalled  = false;
+    pCircularBuffer->spaceSignalled = false;
+#endif
+#ifdef ICIRCULARBUFFER_CRC
+    pCircularBuffer->crc      = UINT32_MAX;
+    pCircularBuffer->crcStart = 0;
+#endif
 
     return true;
 }
@@ -83,27 +509,61 @@ bool ICircularBuffer_Init( CircularBuffer_t *pCircularBuffer, uint8_t *pBuffer,
  * Function
  * *********************************************************************************************************************
  */
-size_t ICircularBuffer_GetCount( CircularBuffer_t *pCircularBuffer )
+bool ICircularBuffer_InitOverwrite( CircularBuffer_t *pCircularBuffer, uint8_t *pBuffer, size_t bufferSize )
 {
-    if ( pCircularBuffer == NULL )
+    if ( !ICircularBuffer_Init( pCircularBuffer, pBuffer, bufferSize ) )
     {
-        return 0;
+        return false;
     }
 
-    size_t count = 0;
-    if ( pCircularBuffer->pWrite >= pCircularBuffer->pRead )
+    pCircularBuffer->overwrite = true;
+
+    return true;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBuffer_InitGrowable( CircularBuffer_t *pCircularBuffer, CircularBufferGrowth_t const *pGrowth )
+{
+    if ( pCircularBuffer == NULL || pGrowth == NULL )
     {
-        count = ( pCircularBuffer->pRead - pCircularBuffer->pWrite );
+        return false;
     }
-    else
+
+    size_t minSize = pGrowth->minSize;
+    size_t maxSize = pGrowth->maxSize;
+    if ( minSize < 2 || ( minSize & ( minSize - 1 ) ) != 0 || maxSize < minSize || ( maxSize & ( maxSize - 1 ) ) != 0 )
     {
-        // Remaining from read pointer to end of data buffer
-        count = ( ( pCircularBuffer->pBuffer + pCircularBuffer->bufferSize ) - pCircularBuffer->pRead );
-        // Add bytes from start of databuffer to write pointer
-        count += ( pCircularBuffer->pWrite - pCircularBuffer->pBuffer );
+        // Sizes are 0 or not power of 2
+        return false;
     }
 
-    return count;
+    if ( pGrowth->highWatermark == 0 || pGrowth->highWatermark > 100
+         || ( 2 * pGrowth->lowWatermark ) >= pGrowth->highWatermark )
+    {
+        // Without hysteresis a halved buffer could be grown straight back
+        return false;
+    }
+
+    if ( ( pGrowth->allocator.pAllocate == NULL ) != ( pGrowth->allocator.pFree == NULL ) )
+    {
+        return false;
+    }
+
+    uint8_t *pBuffer = ( pGrowth->allocator.pAllocate != NULL )
+                     ? pGrowth->allocator.pAllocate( minSize, pGrowth->allocator.pContext )
+                     : malloc( minSize );
+    if ( !ICircularBuffer_Init( pCircularBuffer, pBuffer, minSize ) )
+    {
+        return false;
+    }
+
+    pCircularBuffer->pGrowth = pGrowth;
+
+    return true;
 }
 
 /**
@@ -111,20 +571,30 @@ size_t ICircularBuffer_GetCount( CircularBuffer_t *pCircularBuffer )
  * Function
  * *********************************************************************************************************************
  */
-size_t ICircularBuffer_Peek( CircularBuffer_t *pCircularBuffer, uint8_t const **ppData )
+bool ICircularBuffer_DeinitGrowable( CircularBuffer_t *pCircularBuffer )
 {
-    if ( pCircularBuffer == NULL || ppData == NULL )
+    if ( pCircularBuffer == NULL || pCircularBuffer->pGrowth == NULL )
     {
-        return 0;
+        return false;
     }
 
-    size_t bytesToEnd = CircularBuffer_BytesUntilEnd( pCircularBuffer );
-    if ( bytesToEnd > 0 )
+    CircularBufferGrowth_t const *pGrowth = pCircularBuffer->pGrowth;
+    if ( pGrowth->allocator.pFree != NULL )
     {
-        *ppData = pCircularBuffer->pRead;
+        pGrowth->allocator.pFree( pCircularBuffer->pBuffer, pCircularBuffer->bufferSize, pGrowth->allocator.pContext );
+    }
+    else
+    {
+        free( pCircularBuffer->pBuffer );
     }
 
-    return bytesToEnd;
+    pCircularBuffer->pBuffer    = NULL;
+    pCircularBuffer->write      = 0;
+    pCircularBuffer->read       = 0;
+    pCircularBuffer->bufferSize = 0;
+    pCircularBuffer->pGrowth    = NULL;
+
+    return true;
 }
 
 /**
@@ -132,10 +602,16 @@ size_t ICircularBuffer_Peek( CircularBuffer_t *pCircularBuffer, uint8_t const **
  * Function
  * *********************************************************************************************************************
  */
-size_t ICircularBuffer_Pop( CircularBuffer_t *pCircularBuffer, uint8_t *pData, size_t count  )
+bool ICircularBuffer_SetBulkThreshold( CircularBuffer_t *pCircularBuffer, size_t threshold )
 {
-    // TODO: Implement me
-    return 0;
+    if ( pCircularBuffer == NULL )
+    {
+        return false;
+    }
+
+    pCircularBuffer->bulkThreshold = threshold;
+
+    return true;
 }
 
 /**
@@ -143,10 +619,14 @@ size_t ICircularBuffer_Pop( CircularBuffer_t *pCircularBuffer, uint8_t *pData, s
  * Function
  * *********************************************************************************************************************
  */
-size_t ICircularBuffer_Push( CircularBuffer_t *pCircularBuffer, uint8_t *pData, size_t count  )
+size_t ICircularBuffer_GetSize( CircularBuffer_t *pCircularBuffer )
 {
-    // TODO: Implement me
-    return 0;
+    if ( pCircularBuffer == NULL )
+    {
+        return 0;
+    }
+
+    return pCircularBuffer->bufferSize;
 }
 
 /**
@@ -154,40 +634,1167 @@ size_t ICircularBuffer_Push( CircularBuffer_t *pCircularBuffer, uint8_t *pData,
  * Function
  * *********************************************************************************************************************
  */
-bool ICircularBuffer_Clear( CircularBuffer_t *pCircularBuffer )
+size_t ICircularBuffer_GetCount( CircularBuffer_t *pCircularBuffer )
 {
-    // TODO: Implement me
-    return false;
+    if ( pCircularBuffer == NULL )
+    {
+        return 0;
+    }
+
+    // Free-running positions never wrap in practice, so the difference is always the fill level
+    return (size_t)( pCircularBuffer->write - pCircularBuffer->read );
 }
 
 /**
- * ---------------------------------------------------------------------------------------------------------------------
- * Private functions
- * ---------------------------------------------------------------------------------------------------------------------
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
  */
+size_t ICircularBuffer_Peek( CircularBuffer_t *pCircularBuffer, uint8_t const **ppData )
+{
+    if ( pCircularBuffer == NULL || ppData == NULL )
+    {
+        return 0;
+    }
+
+    size_t bytesToEnd = CircularBuffer_BytesUntilEnd( pCircularBuffer );
+    if ( bytesToEnd > 0 )
+    {
+        *ppData = pCircularBuffer->pBuffer + ( pCircularBuffer->read & ( pCircularBuffer->bufferSize - 1 ) );
+    }
+
+    return bytesToEnd;
+}
 
 /**
  * *********************************************************************************************************************
  * Function
  * *********************************************************************************************************************
  */
-size_t CircularBuffer_BytesUntilEnd( CircularBuffer_t *pCircularBuffer )
+size_t ICircularBuffer_PeekV( CircularBuffer_t *pCircularBuffer, CircularBufferSegment_t *pSegments )
 {
-    // TODO: Use SOFTWARE_EXCEPTION, assert or alike instead... This is an internal function and should never get NULL.
-    if ( pCircularBuffer == NULL )
+    if ( pCircularBuffer == NULL || pSegments == NULL )
     {
         return 0;
     }
 
-    size_t count = 0;
-    if ( pCircularBuffer->pRead < pCircularBuffer->pWrite )
-    {   // Count up to write pointer
-        count = ( pCircularBuffer->pWrite - pCircularBuffer->pRead );
-    }
-    else
-    {   // Count to end of data buffer
-        count = ( ( pCircularBuffer->pBuffer + pCircularBuffer->bufferSize ) - pCircularBuffer->pRead );
-    }
+    size_t count = ICircularBuffer_GetCount( pCircularBuffer );
+    CircularBuffer_Split( pCircularBuffer, pCircularBuffer->read, count, pSegments );
 
     return count;
-}
\ No newline at end of file
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBuffer_Find( CircularBuffer_t *pCircularBuffer, uint8_t value, size_t from, size_t *pOffset )
+{
+    if ( pCircularBuffer == NULL || pOffset == NULL )
+    {
+        return false;
+    }
+
+    size_t count = ICircularBuffer_GetCount( pCircularBuffer );
+    if ( from >= count )
+    {
+        return false;
+    }
+
+    CircularBufferSegment_t segments[ ICIRCULARBUFFER_SEGMENT_COUNT ];
+    CircularBuffer_Split( pCircularBuffer, pCircularBuffer->read + from, count - from, segments );
+
+    size_t offset = from;
+    for ( size_t i = 0; i < ICIRCULARBUFFER_SEGMENT_COUNT; ++i )
+    {
+        size_t index = CircularBuffer_FindByte( segments[ i ].pData, segments[ i ].size, value );
+        if ( index < segments[ i ].size )
+        {
+            *pOffset = offset + index;
+            return true;
+        }
+        offset += segments[ i ].size;
+    }
+
+    return false;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBuffer_FindPattern( CircularBuffer_t *pCircularBuffer, uint8_t const *pPattern, size_t length, size_t from,
+                                  size_t *pOffset )
+{
+    if ( pCircularBuffer == NULL || pPattern == NULL || pOffset == NULL || length == 0 )
+    {
+        return false;
+    }
+
+    size_t count = ICircularBuffer_GetCount( pCircularBuffer );
+    if ( from >= count || length > ( count - from ) )
+    {
+        return false;
+    }
+
+    // Search for the first byte where a whole pattern could still start, then compare the rest across the wrap
+    CircularBufferSegment_t segments[ ICIRCULARBUFFER_SEGMENT_COUNT ];
+    CircularBuffer_Split( pCircularBuffer, pCircularBuffer->read + from, count - from - length + 1, segments );
+
+    size_t offset = from;
+    for ( size_t i = 0; i < ICIRCULARBUFFER_SEGMENT_COUNT; ++i )
+    {
+        size_t index = 0;
+        while ( index < segments[ i ].size )
+        {
+            index += CircularBuffer_FindByte( segments[ i ].pData + index, segments[ i ].size - index, pPattern[ 0 ] );
+            if ( index == segments[ i ].size )
+            {
+                break;
+            }
+
+            if ( CircularBuffer_Matches( pCircularBuffer, pCircularBuffer->read + offset + index, pPattern, length ) )
+            {
+                *pOffset = offset + index;
+                return true;
+            }
+            ++index;
+        }
+        offset += segments[ i ].size;
+    }
+
+    return false;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBuffer_Pop( CircularBuffer_t *pCircularBuffer, uint8_t *pData, size_t count  )
+{
+    if ( pCircularBuffer == NULL || pData == NULL )
+    {
+        return 0;
+    }
+
+    size_t requested = count;
+    size_t available = ICircularBuffer_GetCount( pCircularBuffer );
+    if ( count > available )
+    {
+        count = available;
+    }
+
+    // Copy up to end of data buffer, then the rest from the start (second segment empty if no wraparound)
+    CircularBufferSegment_t segments[ ICIRCULARBUFFER_SEGMENT_COUNT ];
+    CircularBuffer_Split( pCircularBuffer, pCircularBuffer->read, count, segments );
+    CIRCULARBUFFER_COPY( pCircularBuffer, pData, segments[ 0 ].pData, segments[ 0 ].size );
+    if ( segments[ 1 ].size > 0 )
+    {
+        CIRCULARBUFFER_COPY( pCircularBuffer, pData + segments[ 0 ].size, segments[ 1 ].pData, segments[ 1 ].size );
+    }
+
+    pCircularBuffer->read += count;
+    CIRCULARBUFFER_SHRINK( pCircularBuffer );
+    CIRCULARBUFFER_STATISTICS_POP( pCircularBuffer, requested, count );
+    CIRCULARBUFFER_NOTIFY( pCircularBuffer );
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBuffer_Push( CircularBuffer_t *pCircularBuffer, uint8_t *pData, size_t count  )
+{
+    if ( pCircularBuffer == NULL || pData == NULL )
+    {
+        return 0;
+    }
+
+    if ( pCircularBuffer->overwrite )
+    {
+        return CircularBuffer_PushOverwrite( pCircularBuffer, pData, count );
+    }
+
+    CIRCULARBUFFER_GROW( pCircularBuffer, count );
+
+    size_t requested = count;
+    size_t available = pCircularBuffer->bufferSize - ICircularBuffer_GetCount( pCircularBuffer );
+    if ( count > available )
+    {
+        count = available;
+    }
+
+    // Copy up to end of data buffer, then the rest to the start (second segment empty if no wraparound)
+    CircularBufferSegment_t segments[ ICIRCULARBUFFER_SEGMENT_COUNT ];
+    CircularBuffer_Split( pCircularBuffer, pCircularBuffer->write, count, segments );
+    CIRCULARBUFFER_COPY_IN( pCircularBuffer, segments[ 0 ].pData, pData, segments[ 0 ].size );
+    if ( segments[ 1 ].size > 0 )
+    {
+        CIRCULARBUFFER_COPY_IN( pCircularBuffer, segments[ 1 ].pData, pData + segments[ 0 ].size, segments[ 1 ].size );
+    }
+
+    pCircularBuffer->write += count;
+    CIRCULARBUFFER_STATISTICS_PUSH( pCircularBuffer, requested, count );
+    CIRCULARBUFFER_NOTIFY( pCircularBuffer );
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBuffer_ReadAt( CircularBuffer_t *pCircularBuffer, uint64_t *pPosition, uint8_t *pData, size_t count,
+                               uint64_t *pLost )
+{
+#ifdef ICIRCULARBUFFER_READERS
+    if ( pCircularBuffer == NULL || pPosition == NULL || pData == NULL || !pCircularBuffer->overwrite )
+    {
+        return 0;
+    }
+
+    uint64_t position = *pPosition;
+    uint64_t lost     = 0;
+    size_t   read;
+
+    for ( ;; )
+    {
+        // Published is stored after claimed, so loading it first keeps claimed at or ahead of it
+        uint64_t published = atomic_load_explicit( &pCircularBuffer->published, memory_order_acquire );
+        uint64_t claimed   = atomic_load_explicit( &pCircularBuffer->claimed,   memory_order_relaxed );
+
+        // Anything older than one buffer behind the producer is (being) overwritten, skip to oldest valid data
+        if ( claimed > position && ( claimed - position ) > pCircularBuffer->bufferSize )
+        {
+            lost     += ( claimed - pCircularBuffer->bufferSize ) - position;
+            position  = ( claimed - pCircularBuffer->bufferSize );
+        }
+
+        read = ( position < published ) ? (size_t)( published - position ) : 0;
+        if ( count < read )
+        {
+            read = count;
+        }
+
+        CircularBufferSegment_t segments[ ICIRCULARBUFFER_SEGMENT_COUNT ];
+        CircularBuffer_Split( pCircularBuffer, position, read, segments );
+        memcpy( pData, segments[ 0 ].pData, segments[ 0 ].size );
+        memcpy( pData + segments[ 0 ].size, segments[ 1 ].pData, segments[ 1 ].size );
+
+        // Seqlock style check: if the producer started overwriting what was copied, throw the copy away and retry
+        atomic_thread_fence( memory_order_acquire );
+        claimed = atomic_load_explicit( &pCircularBuffer->claimed, memory_order_relaxed );
+        if ( claimed <= position || ( claimed - position ) <= pCircularBuffer->bufferSize )
+        {
+            break;
+        }
+    }
+
+    *pPosition = position + read;
+    if ( pLost != NULL )
+    {
+        *pLost = lost;
+    }
+
+    return read;
+#else
+    (void)pCircularBuffer;
+    (void)pPosition;
+    (void)pData;
+    (void)count;
+    (void)pLost;
+    return 0;
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+uint64_t ICircularBuffer_GetOverwritten( CircularBuffer_t *pCircularBuffer )
+{
+    if ( pCircularBuffer == NULL )
+    {
+        return 0;
+    }
+
+    return pCircularBuffer->overwritten;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBuffer_Reserve( CircularBuffer_t *pCircularBuffer, uint8_t **ppData, size_t count )
+{
+    if ( pCircularBuffer == NULL || ppData == NULL )
+    {
+        return 0;
+    }
+
+    CIRCULARBUFFER_GROW( pCircularBuffer, count );
+
+    // Limited by free space and by end of data buffer
+    size_t available  = pCircularBuffer->bufferSize - ICircularBuffer_GetCount( pCircularBuffer );
+    size_t bytesToEnd = CircularBuffer_ContiguousFrom( pCircularBuffer, pCircularBuffer->write );
+    if ( available > bytesToEnd )
+    {
+        available = bytesToEnd;
+    }
+    if ( count > available )
+    {
+        count = available;
+    }
+
+    if ( count > 0 )
+    {
+        *ppData = pCircularBuffer->pBuffer + ( pCircularBuffer->write & ( pCircularBuffer->bufferSize - 1 ) );
+    }
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBuffer_ReserveV( CircularBuffer_t *pCircularBuffer, CircularBufferSegment_t *pSegments, size_t count )
+{
+    if ( pCircularBuffer == NULL || pSegments == NULL )
+    {
+        return 0;
+    }
+
+    CIRCULARBUFFER_GROW( pCircularBuffer, count );
+
+    size_t available = pCircularBuffer->bufferSize - ICircularBuffer_GetCount( pCircularBuffer );
+    if ( count > available )
+    {
+        count = available;
+    }
+
+    CircularBuffer_Split( pCircularBuffer, pCircularBuffer->write, count, pSegments );
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBuffer_Commit( CircularBuffer_t *pCircularBuffer, size_t count )
+{
+    if ( pCircularBuffer == NULL )
+    {
+        return 0;
+    }
+
+    size_t requested = count;
+    size_t available = pCircularBuffer->bufferSize - ICircularBuffer_GetCount( pCircularBuffer );
+    if ( count > available )
+    {
+        count = available;
+    }
+
+#ifdef ICIRCULARBUFFER_CRC
+    // Data was written in place by the caller, checksum it from buffer memory while it is still in cache
+    CircularBufferSegment_t segments[ ICIRCULARBUFFER_SEGMENT_COUNT ];
+    CircularBuffer_Split( pCircularBuffer, pCircularBuffer->write, count, segments );
+    CIRCULARBUFFER_CRC_UPDATE( pCircularBuffer, segments[ 0 ].pData, segments[ 0 ].size );
+    CIRCULARBUFFER_CRC_UPDATE( pCircularBuffer, segments[ 1 ].pData, segments[ 1 ].size );
+#endif
+
+    pCircularBuffer->write += count;
+    CIRCULARBUFFER_STATISTICS_PUSH( pCircularBuffer, requested, count );
+    CIRCULARBUFFER_NOTIFY( pCircularBuffer );
+
+    if ( pCircularBuffer->overwrite )
+    {
+        // Committed data only ever fills free space, so it is published without overwriting anything
+        CIRCULARBUFFER_CLAIM( pCircularBuffer, pCircularBuffer->write );
+        CIRCULARBUFFER_PUBLISH( pCircularBuffer, pCircularBuffer->write );
+    }
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBuffer_Release( CircularBuffer_t *pCircularBuffer, size_t count )
+{
+    if ( pCircularBuffer == NULL )
+    {
+        return 0;
+    }
+
+    size_t requested = count;
+    size_t available = ICircularBuffer_GetCount( pCircularBuffer );
+    if ( count > available )
+    {
+        count = available;
+    }
+
+    pCircularBuffer->read += count;
+    CIRCULARBUFFER_SHRINK( pCircularBuffer );
+    CIRCULARBUFFER_STATISTICS_POP( pCircularBuffer, requested, count );
+    CIRCULARBUFFER_NOTIFY( pCircularBuffer );
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBuffer_Clear( CircularBuffer_t *pCircularBuffer )
+{
+    if ( pCircularBuffer == NULL )
+    {
+        return false;
+    }
+
+    if ( pCircularBuffer->overwrite )
+    {
+        // Concurrent readers detect being lapped by comparing positions, so these never move backwards
+        pCircularBuffer->read = pCircularBuffer->write;
+    }
+    else
+    {
+        pCircularBuffer->write = 0;
+        pCircularBuffer->read  = 0;
+    }
+    pCircularBuffer->overwritten = 0;
+#ifdef ICIRCULARBUFFER_CRC
+    pCircularBuffer->crc      = UINT32_MAX;
+    pCircularBuffer->crcStart = pCircularBuffer->write;
+#endif
+    CIRCULARBUFFER_SHRINK( pCircularBuffer );
+    CIRCULARBUFFER_NOTIFY( pCircularBuffer );
+
+    return true;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBuffer_GetStatistics( CircularBuffer_t *pCircularBuffer, CircularBufferStatistics_t *pStatistics )
+{
+    if ( pCircularBuffer == NULL || pStatistics == NULL )
+    {
+        return false;
+    }
+
+#ifdef ICIRCULARBUFFER_STATISTICS
+    *pStatistics = pCircularBuffer->statistics;
+
+    return true;
+#else
+    memset( pStatistics, 0, sizeof( *pStatistics ) );
+
+    return false;
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBuffer_ResetStatistics( CircularBuffer_t *pCircularBuffer )
+{
+    if ( pCircularBuffer == NULL )
+    {
+        return false;
+    }
+
+#ifdef ICIRCULARBUFFER_STATISTICS
+    memset( &pCircularBuffer->statistics, 0, sizeof( pCircularBuffer->statistics ) );
+    pCircularBuffer->statistics.highWaterMark = ICircularBuffer_GetCount( pCircularBuffer );
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int ICircularBuffer_OpenDataFd( CircularBuffer_t *pCircularBuffer )
+{
+    if ( pCircularBuffer == NULL )
+    {
+        return -1;
+    }
+
+#ifdef ICIRCULARBUFFER_NOTIFY
+    if ( pCircularBuffer->dataFd < 0 )
+    {
+        pCircularBuffer->dataFd = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+        if ( pCircularBuffer->dataFd < 0 )
+        {
+            return -1;
+        }
+        pCircularBuffer->dataSignalled = false;
+        CircularBuffer_Notify( pCircularBuffer );
+    }
+
+    return pCircularBuffer->dataFd;
+#else
+    return -1;
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int ICircularBuffer_OpenSpaceFd( CircularBuffer_t *pCircularBuffer, size_t threshold )
+{
+    if ( pCircularBuffer == NULL || threshold == 0 || threshold > pCircularBuffer->bufferSize )
+    {
+        return -1;
+    }
+
+#ifdef ICIRCULARBUFFER_NOTIFY
+    if ( pCircularBuffer->spaceFd < 0 )
+    {
+        pCircularBuffer->spaceFd = eventfd( 0, EFD_NONBLOCK | EFD_CLOEXEC );
+        if ( pCircularBuffer->spaceFd < 0 )
+        {
+            return -1;
+        }
+        pCircularBuffer->spaceSignalled = false;
+    }
+
+    pCircularBuffer->spaceThreshold = threshold;
+    CircularBuffer_Notify( pCircularBuffer );
+
+    return pCircularBuffer->spaceFd;
+#else
+    return -1;
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBuffer_CloseNotify( CircularBuffer_t *pCircularBuffer )
+{
+    if ( pCircularBuffer == NULL )
+    {
+        return false;
+    }
+
+#ifdef ICIRCULARBUFFER_NOTIFY
+    if ( pCircularBuffer->dataFd >= 0 )
+    {
+        close( pCircularBuffer->dataFd );
+    }
+    if ( pCircularBuffer->spaceFd >= 0 )
+    {
+        close( pCircularBuffer->spaceFd );
+    }
+
+    pCircularBuffer->dataFd         = -1;
+    pCircularBuffer->spaceFd        = -1;
+    pCircularBuffer->dataSignalled  = false;
+    pCircularBuffer->spaceSignalled = false;
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBuffer_CrcBegin( CircularBuffer_t *pCircularBuffer )
+{
+    if ( pCircularBuffer == NULL )
+    {
+        return false;
+    }
+
+#ifdef ICIRCULARBUFFER_CRC
+    pCircularBuffer->crc      = UINT32_MAX;
+    pCircularBuffer->crcStart = pCircularBuffer->write;
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBuffer_CrcGet( CircularBuffer_t *pCircularBuffer, uint32_t *pCrc, uint64_t *pLength )
+{
+    if ( pCircularBuffer == NULL || pCrc == NULL )
+    {
+        return false;
+    }
+
+#ifdef ICIRCULARBUFFER_CRC
+    *pCrc = ~pCircularBuffer->crc;
+    if ( pLength != NULL )
+    {
+        *pLength = ( pCircularBuffer->write - pCircularBuffer->crcStart );
+    }
+
+    return true;
+#else
+    (void)pLength;
+    return false;
+#endif
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Private functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t CircularBuffer_BytesUntilEnd( CircularBuffer_t *pCircularBuffer )
+{
+    // TODO: Use SOFTWARE_EXCEPTION, assert or alike instead... This is an internal function and should never get NULL.
+    if ( pCircularBuffer == NULL )
+    {
+        return 0;
+    }
+
+    size_t count      = ICircularBuffer_GetCount( pCircularBuffer );
+    size_t bytesToEnd = CircularBuffer_ContiguousFrom( pCircularBuffer, pCircularBuffer->read );
+
+    return ( count < bytesToEnd ) ? count : bytesToEnd;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t CircularBuffer_ContiguousFrom( CircularBuffer_t *pCircularBuffer, uint64_t position )
+{
+    if ( pCircularBuffer->mirrored )
+    {
+        return pCircularBuffer->bufferSize;
+    }
+
+    return pCircularBuffer->bufferSize - (size_t)( position & ( pCircularBuffer->bufferSize - 1 ) );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void CircularBuffer_Split( CircularBuffer_t *pCircularBuffer, uint64_t position, size_t count, CircularBufferSegment_t *pSegments )
+{
+    size_t bytesToEnd = CircularBuffer_ContiguousFrom( pCircularBuffer, position );
+    size_t first      = ( count > bytesToEnd ) ? bytesToEnd : count;
+
+    pSegments[ 0 ].pData = pCircularBuffer->pBuffer + ( position & ( pCircularBuffer->bufferSize - 1 ) );
+    pSegments[ 0 ].size  = first;
+    pSegments[ 1 ].pData = pCircularBuffer->pBuffer;
+    pSegments[ 1 ].size  = ( count - first );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool CircularBuffer_Matches( CircularBuffer_t *pCircularBuffer, uint64_t position, uint8_t const *pPattern, size_t length )
+{
+    CircularBufferSegment_t segments[ ICIRCULARBUFFER_SEGMENT_COUNT ];
+    CircularBuffer_Split( pCircularBuffer, position, length, segments );
+
+    return ( memcmp( segments[ 0 ].pData, pPattern,                    segments[ 0 ].size ) == 0 )
+        && ( memcmp( segments[ 1 ].pData, pPattern + segments[ 0 ].size, segments[ 1 ].size ) == 0 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t CircularBuffer_FindByte( uint8_t const *pData, size_t size, uint8_t value )
+{
+#ifdef CIRCULARBUFFER_FIND_SIMD
+    // Cached by libgcc at startup, so checking on every call costs a load
+    if ( __builtin_cpu_supports( "avx2" ) )
+    {
+        return CircularBuffer_FindByteAvx2( pData, size, value );
+    }
+    return CircularBuffer_FindByteSse2( pData, size, value );
+#else
+    return CircularBuffer_FindByteScalar( pData, size, value );
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t CircularBuffer_FindByteScalar( uint8_t const *pData, size_t size, uint8_t value )
+{
+    size_t index = 0;
+    while ( index < size && pData[ index ] != value )
+    {
+        ++index;
+    }
+
+    return index;
+}
+
+#ifdef CIRCULARBUFFER_FIND_SIMD
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t CircularBuffer_FindByteSse2( uint8_t const *pData, size_t size, uint8_t value )
+{
+    __m128i needle = _mm_set1_epi8( (char)value );
+    size_t  index  = 0;
+
+    for ( ; ( index + 16 ) <= size; index += 16 )
+    {
+        __m128i  block = _mm_loadu_si128( (__m128i const *)( pData + index ) );
+        unsigned mask  = (unsigned)_mm_movemask_epi8( _mm_cmpeq_epi8( block, needle ) );
+        if ( mask != 0 )
+        {
+            return index + (size_t)__builtin_ctz( mask );
+        }
+    }
+
+    return index + CircularBuffer_FindByteScalar( pData + index, size - index, value );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+__attribute__(( target( "avx2" ) ))
+size_t CircularBuffer_FindByteAvx2( uint8_t const *pData, size_t size, uint8_t value )
+{
+    __m256i needle = _mm256_set1_epi8( (char)value );
+    size_t  index  = 0;
+
+    // Two blocks per round, one branch on both, then find out which one hit
+    for ( ; ( index + 64 ) <= size; index += 64 )
+    {
+        __m256i low  = _mm256_cmpeq_epi8( _mm256_loadu_si256( (__m256i const *)( pData + index ) ),      needle );
+        __m256i high = _mm256_cmpeq_epi8( _mm256_loadu_si256( (__m256i const *)( pData + index + 32 ) ), needle );
+        if ( !_mm256_testz_si256( _mm256_or_si256( low, high ), _mm256_or_si256( low, high ) ) )
+        {
+            uint64_t mask = (uint32_t)_mm256_movemask_epi8( low )
+                          | ( (uint64_t)(uint32_t)_mm256_movemask_epi8( high ) << 32 );
+            return index + (size_t)__builtin_ctzll( mask );
+        }
+    }
+
+    return index + CircularBuffer_FindByteSse2( pData + index, size - index, value );
+}
+#endif
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void CircularBuffer_CopyBulk( uint8_t *pDestination, uint8_t const *pSource, size_t size )
+{
+#ifdef CIRCULARBUFFER_BULK_SIMD
+    // Streaming stores need an aligned destination, copy up to the first 16 byte boundary the normal way
+    size_t head = (size_t)( -(uintptr_t)pDestination & 15u );
+    if ( head > size )
+    {
+        head = size;
+    }
+    memcpy( pDestination, pSource, head );
+    pDestination += head;
+    pSource      += head;
+    size         -= head;
+
+    // A cache line per round, prefetched without polluting the outer caches; prefetch past the end never faults
+    for ( ; size >= 64; size -= 64, pSource += 64, pDestination += 64 )
+    {
+        _mm_prefetch( (char const *)( pSource + CIRCULARBUFFER_BULK_PREFETCH ), _MM_HINT_NTA );
+        __m128i a = _mm_loadu_si128( (__m128i const *)( pSource ) );
+        __m128i b = _mm_loadu_si128( (__m128i const *)( pSource + 16 ) );
+        __m128i c = _mm_loadu_si128( (__m128i const *)( pSource + 32 ) );
+        __m128i d = _mm_loadu_si128( (__m128i const *)( pSource + 48 ) );
+        _mm_stream_si128( (__m128i *)( pDestination ),      a );
+        _mm_stream_si128( (__m128i *)( pDestination + 16 ), b );
+        _mm_stream_si128( (__m128i *)( pDestination + 32 ), c );
+        _mm_stream_si128( (__m128i *)( pDestination + 48 ), d );
+    }
+
+    // Streaming stores are weakly ordered, fence so they are visible before any position published after the copy
+    _mm_sfence();
+#endif
+    memcpy( pDestination, pSource, size );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void CircularBuffer_Grow( CircularBuffer_t *pCircularBuffer, size_t count )
+{
+    CircularBufferGrowth_t const *pGrowth = pCircularBuffer->pGrowth;
+
+    // Double until data stays below the high watermark, in 64 bits so percentages of large sizes cannot overflow
+    uint64_t needed     = (uint64_t)ICircularBuffer_GetCount( pCircularBuffer ) + count;
+    size_t   bufferSize = pCircularBuffer->bufferSize;
+    while ( bufferSize < pGrowth->maxSize && ( needed * 100 ) > ( (uint64_t)bufferSize * pGrowth->highWatermark ) )
+    {
+        bufferSize *= 2;
+    }
+
+    if ( bufferSize != pCircularBuffer->bufferSize )
+    {
+        CircularBuffer_Resize( pCircularBuffer, bufferSize );
+    }
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void CircularBuffer_Shrink( CircularBuffer_t *pCircularBuffer )
+{
+    CircularBufferGrowth_t const *pGrowth = pCircularBuffer->pGrowth;
+
+    uint64_t count      = ICircularBuffer_GetCount( pCircularBuffer );
+    size_t   bufferSize = pCircularBuffer->bufferSize;
+    while ( bufferSize > pGrowth->minSize && ( count * 100 ) < ( (uint64_t)bufferSize * pGrowth->lowWatermark ) )
+    {
+        bufferSize /= 2;
+    }
+
+    if ( bufferSize != pCircularBuffer->bufferSize )
+    {
+        CircularBuffer_Resize( pCircularBuffer, bufferSize );
+    }
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool CircularBuffer_Resize( CircularBuffer_t *pCircularBuffer, size_t bufferSize )
+{
+    CircularBufferAllocator_t const *pAllocator = &pCircularBuffer->pGrowth->allocator;
+
+    uint8_t *pBuffer = ( pAllocator->pAllocate != NULL ) ? pAllocator->pAllocate( bufferSize, pAllocator->pContext )
+                                                         : malloc( bufferSize );
+    if ( pBuffer == NULL )
+    {
+        return false;
+    }
+
+    // Linearize, oldest byte first at the start of the new memory, so nothing is reordered
+    size_t                  count = ICircularBuffer_GetCount( pCircularBuffer );
+    CircularBufferSegment_t segments[ ICIRCULARBUFFER_SEGMENT_COUNT ];
+    CircularBuffer_Split( pCircularBuffer, pCircularBuffer->read, count, segments );
+    memcpy( pBuffer, segments[ 0 ].pData, segments[ 0 ].size );
+    memcpy( pBuffer + segments[ 0 ].size, segments[ 1 ].pData, segments[ 1 ].size );
+
+    if ( pAllocator->pFree != NULL )
+    {
+        pAllocator->pFree( pCircularBuffer->pBuffer, pCircularBuffer->bufferSize, pAllocator->pContext );
+    }
+    else
+    {
+        free( pCircularBuffer->pBuffer );
+    }
+
+#ifdef ICIRCULARBUFFER_CRC
+    // Checksum range keeps its length, it still ends at the write position
+    pCircularBuffer->crcStart = count - ( pCircularBuffer->write - pCircularBuffer->crcStart );
+#endif
+    pCircularBuffer->pBuffer    = pBuffer;
+    pCircularBuffer->bufferSize = bufferSize;
+    pCircularBuffer->read       = 0;
+    pCircularBuffer->write      = count;
+#ifdef ICIRCULARBUFFER_NOTIFY
+    // A threshold above the size could never be met, an empty buffer is as much free space as there will be
+    if ( pCircularBuffer->spaceThreshold > bufferSize )
+    {
+        pCircularBuffer->spaceThreshold = bufferSize;
+    }
+#endif
+
+    return true;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t CircularBuffer_PushOverwrite( CircularBuffer_t *pCircularBuffer, uint8_t *pData, size_t count )
+{
+    size_t   requested = count;
+    uint64_t write     = pCircularBuffer->write + count;
+
+    // Positions advance by all of count, but only the last buffer size bytes of a larger push can be kept
+    if ( count > pCircularBuffer->bufferSize )
+    {
+        CIRCULARBUFFER_CRC_UPDATE( pCircularBuffer, pData, count - pCircularBuffer->bufferSize );
+        pData += ( count - pCircularBuffer->bufferSize );
+        count  = pCircularBuffer->bufferSize;
+    }
+
+    if ( ( write - pCircularBuffer->read ) > pCircularBuffer->bufferSize )
+    {
+        pCircularBuffer->overwritten += ( write - pCircularBuffer->read ) - pCircularBuffer->bufferSize;
+        pCircularBuffer->read         = ( write - pCircularBuffer->bufferSize );
+    }
+
+    // Claim the range before copying, so a concurrent reader can tell its copy may have been overwritten
+    CIRCULARBUFFER_CLAIM( pCircularBuffer, write );
+
+    CircularBufferSegment_t segments[ ICIRCULARBUFFER_SEGMENT_COUNT ];
+    CircularBuffer_Split( pCircularBuffer, write - count, count, segments );
+    CIRCULARBUFFER_COPY_IN( pCircularBuffer, segments[ 0 ].pData, pData, segments[ 0 ].size );
+    if ( segments[ 1 ].size > 0 )
+    {
+        CIRCULARBUFFER_COPY_IN( pCircularBuffer, segments[ 1 ].pData, pData + segments[ 0 ].size, segments[ 1 ].size );
+    }
+
+    pCircularBuffer->write = write;
+    CIRCULARBUFFER_PUBLISH( pCircularBuffer, write );
+    CIRCULARBUFFER_STATISTICS_PUSH( pCircularBuffer, requested, requested );
+    CIRCULARBUFFER_NOTIFY( pCircularBuffer );
+
+    return requested;
+}
+
+#ifdef ICIRCULARBUFFER_STATISTICS
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void CircularBuffer_StatisticsPush( CircularBuffer_t *pCircularBuffer, size_t requested, size_t count )
+{
+    CircularBufferStatistics_t *pStatistics = &pCircularBuffer->statistics;
+    size_t                     used         = ICircularBuffer_GetCount( pCircularBuffer );
+
+    pStatistics->bytesPushed += count;
+    if ( count < requested )
+    {
+        ++pStatistics->shortPushes;
+    }
+    if ( used > pStatistics->highWaterMark )
+    {
+        pStatistics->highWaterMark = used;
+    }
+
+    CircularBuffer_StatisticsOccupancy( pCircularBuffer );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void CircularBuffer_StatisticsPop( CircularBuffer_t *pCircularBuffer, size_t requested, size_t count )
+{
+    CircularBufferStatistics_t *pStatistics = &pCircularBuffer->statistics;
+
+    pStatistics->bytesPopped += count;
+    if ( requested > 0 && count == 0 )
+    {
+        ++pStatistics->emptyPops;
+    }
+
+    CircularBuffer_StatisticsOccupancy( pCircularBuffer );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void CircularBuffer_StatisticsOccupancy( CircularBuffer_t *pCircularBuffer )
+{
+    size_t used = ICircularBuffer_GetCount( pCircularBuffer );
+    size_t bin  = 0;
+
+    // Bin is the number of significant bits, so every bin covers twice the range of the one before
+    while ( used > 0 )
+    {
+        ++bin;
+        used >>= 1;
+    }
+
+    ++pCircularBuffer->statistics.occupancy[ bin ];
+}
+#endif
+
+#ifdef ICIRCULARBUFFER_NOTIFY
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void CircularBuffer_Notify( CircularBuffer_t *pCircularBuffer )
+{
+    size_t used = ICircularBuffer_GetCount( pCircularBuffer );
+
+    // Only edges touch the fds, so a burst of pushes writes once and the pops that empty the buffer drain once
+    if ( pCircularBuffer->dataFd >= 0 && ( used > 0 ) != pCircularBuffer->dataSignalled )
+    {
+        pCircularBuffer->dataSignalled = ( used > 0 );
+        CircularBuffer_NotifySet( pCircularBuffer->dataFd, pCircularBuffer->dataSignalled );
+    }
+
+    bool space = ( ( pCircularBuffer->bufferSize - used ) >= pCircularBuffer->spaceThreshold );
+    if ( pCircularBuffer->spaceFd >= 0 && space != pCircularBuffer->spaceSignalled )
+    {
+        pCircularBuffer->spaceSignalled = space;
+        CircularBuffer_NotifySet( pCircularBuffer->spaceFd, space );
+    }
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void CircularBuffer_NotifySet( int fd, bool signal )
+{
+    eventfd_t value = 1;
+
+    // Non-blocking, so draining an already empty eventfd just fails with EAGAIN
+    if ( signal )
+    {
+        (void)eventfd_write( fd, value );
+    }
+    else
+    {
+        (void)eventfd_read( fd, &value );
+    }
+}
+#endif
+
+#ifdef ICIRCULARBUFFER_CRC
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+uint32_t CircularBuffer_CopyCrc( uint8_t *pDestination, uint8_t const *pSource, size_t count, uint32_t crc )
+{
+#ifdef CIRCULARBUFFER_CRC_SSE42
+    // Cached by libgcc at startup, so checking on every call costs a load
+    if ( __builtin_cpu_supports( "sse4.2" ) )
+    {
+        return CircularBuffer_CopyCrcSse42( pDestination, pSource, count, crc );
+    }
+#endif
+    return CircularBuffer_CopyCrcTable( pDestination, pSource, count, crc );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+uint32_t CircularBuffer_CopyCrcTable( uint8_t *pDestination, uint8_t const *pSource, size_t count, uint32_t crc )
+{
+    for ( size_t i = 0; i < count; ++i )
+    {
+        crc = crc32cTable[ ( crc ^ pSource[ i ] ) & 0xFF ] ^ ( crc >> 8 );
+    }
+
+    // A table lookup per byte is the slow part, memcpy on top of it adds next to nothing
+    if ( pDestination != NULL && count > 0 )
+    {
+        memcpy( pDestination, pSource, count );
+    }
+
+    return crc;
+}
+
+#ifdef CIRCULARBUFFER_CRC_SSE42
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+__attribute__(( target( "sse4.2" ) ))
+uint32_t CircularBuffer_CopyCrcSse42( uint8_t *pDestination, uint8_t const *pSource, size_t count, uint32_t crc )
+{
+    uint64_t crc64 = crc;
+    size_t   i     = 0;
+
+    // Each word is loaded once, for both the store and the checksum
+    for ( ; ( i + sizeof( uint64_t ) ) <= count; i += sizeof( uint64_t ) )
+    {
+        uint64_t word;
+        memcpy( &word, pSource + i, sizeof( word ) );
+        if ( pDestination != NULL )
+        {
+            memcpy( pDestination + i, &word, sizeof( word ) );
+        }
+        crc64 = _mm_crc32_u64( crc64, word );
+    }
+
+    crc = (uint32_t)crc64;
+    for ( ; i < count; ++i )
+    {
+        if ( pDestination != NULL )
+        {
+            pDestination[ i ] = pSource[ i ];
+        }
+        crc = _mm_crc32_u8( crc, pSource[ i ] );
+    }
+
+    return crc;
+}
+#endif
+#endif
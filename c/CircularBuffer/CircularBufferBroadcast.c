@@ -0,0 +1,321 @@
+/**
+ * @file  CircularBufferBroadcast.c
+ * @brief Implementation of module CircularBufferBroadcast.
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include <string.h>
+
+#include "CircularBufferBroadcast.h"
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @brief     Get number of bytes readable by a reader, loading the write index only if the cached copy is short.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferBroadcast struct to use.
+ * @param     pReader[in]         Pointer to cursor of reader.
+ * @param     read[in]            Current read index of reader.
+ * @param     wanted[in]          Number of bytes reader would like to read.
+ *
+ * @return
+ *      - Number of bytes readable, may be less than actually available when wanted is satisfied.
+ */
+size_t CircularBufferBroadcast_Readable( CircularBufferBroadcast_t *pCircularBuffer, CircularBufferBroadcastReader_t *pReader,
+                                         size_t read, size_t wanted );
+
+/**
+ * @brief     Get number of bytes writable by producer, scanning all readers only if the cached slowest is short.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferBroadcast struct to use.
+ * @param     write[in]           Current write index.
+ * @param     wanted[in]          Number of bytes producer would like to write.
+ *
+ * @return
+ *      - Number of bytes writable, may be less than actually free when wanted is satisfied.
+ */
+size_t CircularBufferBroadcast_Writable( CircularBufferBroadcast_t *pCircularBuffer, size_t write, size_t wanted );
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Variables
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Interface functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferBroadcast_Init( CircularBufferBroadcast_t *pCircularBuffer, uint8_t *pBuffer, size_t bufferSize,
+                                    CircularBufferBroadcastReader_t *pReaders, size_t readerCount )
+{
+    if ( pCircularBuffer == NULL || pBuffer == NULL || pReaders == NULL )
+    {
+        // NULL pointers not accepted
+        return false;
+    }
+
+    if ( bufferSize < 2 || ( ( bufferSize & ~( bufferSize - 1 ) ) != bufferSize ) )
+    {
+        // bufferSize is 0 or not power of 2
+        return false;
+    }
+
+    if ( readerCount == 0 )
+    {
+        return false;
+    }
+
+    pCircularBuffer->bufferSize  = bufferSize;
+    pCircularBuffer->pBuffer     = pBuffer;
+    pCircularBuffer->pReaders    = pReaders;
+    pCircularBuffer->readerCount = readerCount;
+    pCircularBuffer->readCache   = 0;
+    atomic_init( &pCircularBuffer->write, 0 );
+
+    for ( size_t i = 0; i < readerCount; ++i )
+    {
+        pReaders[ i ].writeCache = 0;
+        atomic_init( &pReaders[ i ].read, 0 );
+    }
+
+    return true;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferBroadcast_GetCount( CircularBufferBroadcast_t *pCircularBuffer, size_t reader )
+{
+    if ( pCircularBuffer == NULL || reader >= pCircularBuffer->readerCount )
+    {
+        return 0;
+    }
+
+    // Load read first, write can only move away from it, so the difference never goes negative
+    size_t read  = atomic_load_explicit( &pCircularBuffer->pReaders[ reader ].read, memory_order_acquire );
+    size_t write = atomic_load_explicit( &pCircularBuffer->write,                  memory_order_acquire );
+
+    return ( write - read );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferBroadcast_Peek( CircularBufferBroadcast_t *pCircularBuffer, size_t reader, uint8_t const **ppData )
+{
+    if ( pCircularBuffer == NULL || ppData == NULL || reader >= pCircularBuffer->readerCount )
+    {
+        return 0;
+    }
+
+    CircularBufferBroadcastReader_t *pReader = &pCircularBuffer->pReaders[ reader ];
+
+    size_t read       = atomic_load_explicit( &pReader->read, memory_order_relaxed );
+    size_t offset     = ( read & ( pCircularBuffer->bufferSize - 1 ) );
+    size_t bytesToEnd = ( pCircularBuffer->bufferSize - offset );
+    size_t count      = CircularBufferBroadcast_Readable( pCircularBuffer, pReader, read, bytesToEnd );
+    if ( count > bytesToEnd )
+    {
+        count = bytesToEnd;
+    }
+
+    if ( count > 0 )
+    {
+        *ppData = ( pCircularBuffer->pBuffer + offset );
+    }
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferBroadcast_Pop( CircularBufferBroadcast_t *pCircularBuffer, size_t reader, uint8_t *pData, size_t count )
+{
+    if ( pCircularBuffer == NULL || pData == NULL || reader >= pCircularBuffer->readerCount )
+    {
+        return 0;
+    }
+
+    CircularBufferBroadcastReader_t *pReader = &pCircularBuffer->pReaders[ reader ];
+
+    size_t read      = atomic_load_explicit( &pReader->read, memory_order_relaxed );
+    size_t available = CircularBufferBroadcast_Readable( pCircularBuffer, pReader, read, count );
+    if ( count > available )
+    {
+        count = available;
+    }
+
+    if ( count > 0 )
+    {
+        size_t offset = ( read & ( pCircularBuffer->bufferSize - 1 ) );
+        size_t first  = ( pCircularBuffer->bufferSize - offset );
+        if ( first > count )
+        {
+            first = count;
+        }
+
+        memcpy( pData, pCircularBuffer->pBuffer + offset, first );
+        memcpy( pData + first, pCircularBuffer->pBuffer, count - first );
+
+        // Release hands the bytes back to the producer only after data has been copied out
+        atomic_store_explicit( &pReader->read, read + count, memory_order_release );
+    }
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferBroadcast_Release( CircularBufferBroadcast_t *pCircularBuffer, size_t reader, size_t count )
+{
+    if ( pCircularBuffer == NULL || reader >= pCircularBuffer->readerCount )
+    {
+        return 0;
+    }
+
+    CircularBufferBroadcastReader_t *pReader = &pCircularBuffer->pReaders[ reader ];
+
+    size_t read      = atomic_load_explicit( &pReader->read, memory_order_relaxed );
+    size_t available = CircularBufferBroadcast_Readable( pCircularBuffer, pReader, read, count );
+    if ( count > available )
+    {
+        count = available;
+    }
+
+    if ( count > 0 )
+    {
+        atomic_store_explicit( &pReader->read, read + count, memory_order_release );
+    }
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferBroadcast_Push( CircularBufferBroadcast_t *pCircularBuffer, uint8_t const *pData, size_t count )
+{
+    if ( pCircularBuffer == NULL || pData == NULL )
+    {
+        return 0;
+    }
+
+    size_t write     = atomic_load_explicit( &pCircularBuffer->write, memory_order_relaxed );
+    size_t available = CircularBufferBroadcast_Writable( pCircularBuffer, write, count );
+    if ( count > available )
+    {
+        count = available;
+    }
+
+    if ( count > 0 )
+    {
+        size_t offset = ( write & ( pCircularBuffer->bufferSize - 1 ) );
+        size_t first  = ( pCircularBuffer->bufferSize - offset );
+        if ( first > count )
+        {
+            first = count;
+        }
+
+        memcpy( pCircularBuffer->pBuffer + offset, pData, first );
+        memcpy( pCircularBuffer->pBuffer, pData + first, count - first );
+
+        // Release publishes the data to every reader at once
+        atomic_store_explicit( &pCircularBuffer->write, write + count, memory_order_release );
+    }
+
+    return count;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Private functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t CircularBufferBroadcast_Readable( CircularBufferBroadcast_t *pCircularBuffer, CircularBufferBroadcastReader_t *pReader,
+                                         size_t read, size_t wanted )
+{
+    size_t available = ( pReader->writeCache - read );
+    if ( available < wanted )
+    {
+        // Looks too empty, acquire on write index makes the producers data visible
+        pReader->writeCache = atomic_load_explicit( &pCircularBuffer->write, memory_order_acquire );
+        available           = ( pReader->writeCache - read );
+    }
+
+    return available;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t CircularBufferBroadcast_Writable( CircularBufferBroadcast_t *pCircularBuffer, size_t write, size_t wanted )
+{
+    size_t available = ( pCircularBuffer->bufferSize - ( write - pCircularBuffer->readCache ) );
+    if ( available < wanted )
+    {
+        // Looks too full, find the slowest reader. Distance from write index handles wraparound of the indices
+        size_t slowest = write;
+        for ( size_t i = 0; i < pCircularBuffer->readerCount; ++i )
+        {
+            size_t read = atomic_load_explicit( &pCircularBuffer->pReaders[ i ].read, memory_order_acquire );
+            if ( ( write - read ) > ( write - slowest ) )
+            {
+                slowest = read;
+            }
+        }
+
+        pCircularBuffer->readCache = slowest;
+        available                  = ( pCircularBuffer->bufferSize - ( write - slowest ) );
+    }
+
+    return available;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file  CircularBufferBroadcast.h
+ * @brief Private header for module CircularBufferBroadcast.
+ */
+
+#ifndef CIRCULARBUFFERBROADCAST_H
+#define CIRCULARBUFFERBROADCAST_H
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include "ICircularBufferBroadcast.h"
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#endif  // CIRCULARBUFFERBROADCAST_H
\ No newline at end of file
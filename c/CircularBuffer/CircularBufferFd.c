@@ -0,0 +1,177 @@
+/**
+ * @file  CircularBufferFd.c
+ * @brief Implementation of module CircularBufferFd.
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include <errno.h>
+#include <sys/uio.h>
+
+#include "CircularBufferFd.h"
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @brief     Convert buffer segments to iovecs, leaving out an empty second segment.
+ *
+ * @param     pSegments[in]       Array of ICIRCULARBUFFER_SEGMENT_COUNT segments.
+ * @param     pIovecs[out]        Array of ICIRCULARBUFFER_SEGMENT_COUNT iovecs to fill in.
+ *
+ * @return
+ *      - Number of iovecs filled in.
+ */
+int CircularBufferFd_ToIovecs( CircularBufferSegment_t const *pSegments, struct iovec *pIovecs );
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Variables
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Interface functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+ssize_t ICircularBufferFd_ReadFromFd( CircularBuffer_t *pCircularBuffer, int fd, size_t max )
+{
+    if ( pCircularBuffer == NULL )
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if ( max == 0 )
+    {
+        return 0;
+    }
+
+    CircularBufferSegment_t segments[ ICIRCULARBUFFER_SEGMENT_COUNT ];
+    if ( ICircularBuffer_ReserveV( pCircularBuffer, segments, max ) == 0 )
+    {
+        // A 0 from readv would look like end of file, so a full buffer is an error of its own
+        errno = ENOBUFS;
+        return -1;
+    }
+
+    struct iovec iovecs[ ICIRCULARBUFFER_SEGMENT_COUNT ];
+    int          iovecCount = CircularBufferFd_ToIovecs( segments, iovecs );
+    ssize_t      result;
+    do
+    {
+        result = readv( fd, iovecs, iovecCount );
+    } while ( result < 0 && errno == EINTR );
+
+    if ( result > 0 )
+    {
+        ICircularBuffer_Commit( pCircularBuffer, (size_t)result );
+    }
+
+    return result;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+ssize_t ICircularBufferFd_WriteToFd( CircularBuffer_t *pCircularBuffer, int fd, size_t max )
+{
+    if ( pCircularBuffer == NULL )
+    {
+        errno = EINVAL;
+        return -1;
+    }
+
+    CircularBufferSegment_t segments[ ICIRCULARBUFFER_SEGMENT_COUNT ];
+    size_t                  count = ICircularBuffer_PeekV( pCircularBuffer, segments );
+    if ( count > max )
+    {
+        // Cut the segments down to max bytes
+        if ( segments[ 0 ].size >= max )
+        {
+            segments[ 0 ].size = max;
+            segments[ 1 ].size = 0;
+        }
+        else
+        {
+            segments[ 1 ].size = ( max - segments[ 0 ].size );
+        }
+        count = max;
+    }
+
+    if ( count == 0 )
+    {
+        return 0;
+    }
+
+    struct iovec iovecs[ ICIRCULARBUFFER_SEGMENT_COUNT ];
+    int          iovecCount = CircularBufferFd_ToIovecs( segments, iovecs );
+    ssize_t      result;
+    do
+    {
+        result = writev( fd, iovecs, iovecCount );
+    } while ( result < 0 && errno == EINTR );
+
+    if ( result > 0 )
+    {
+        ICircularBuffer_Release( pCircularBuffer, (size_t)result );
+    }
+
+    return result;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Private functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int CircularBufferFd_ToIovecs( CircularBufferSegment_t const *pSegments, struct iovec *pIovecs )
+{
+    int iovecCount = 0;
+
+    for ( size_t i = 0; i < ICIRCULARBUFFER_SEGMENT_COUNT; ++i )
+    {
+        if ( pSegments[ i ].size > 0 )
+        {
+            pIovecs[ iovecCount ].iov_base = pSegments[ i ].pData;
+            pIovecs[ iovecCount ].iov_len  = pSegments[ i ].size;
+            ++iovecCount;
+        }
+    }
+
+    return iovecCount;
+}
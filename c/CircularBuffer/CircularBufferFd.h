@@ -0,0 +1,35 @@
+/**
+ * @file  CircularBufferFd.h
+ * @brief Private header for module CircularBufferFd.
+ */
+
+#ifndef CIRCULARBUFFERFD_H
+#define CIRCULARBUFFERFD_H
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include "ICircularBufferFd.h"
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#endif  // CIRCULARBUFFERFD_H
\ No newline at end of file
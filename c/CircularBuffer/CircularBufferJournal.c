@@ -0,0 +1,529 @@
+/**
+ * @file  CircularBufferJournal.c
+ * @brief Implementation of module CircularBufferJournal.
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#define _DEFAULT_SOURCE // fsync, clock_gettime, flock
+
+#include <fcntl.h>
+#include <stdatomic.h>
+#include <string.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "CircularBufferJournal.h"
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @brief     Write out header of a journal file being created, magic last so a crash leaves it unrecognized.
+ *
+ * @param     pJournal[in]        Pointer to CircularBufferJournal struct to use.
+ * @param     fd[in]              File descriptor of journal file.
+ * @param     dataOffset[in]      Offset of buffer memory from start of file.
+ *
+ * @return
+ *      - true:  Header on disk.
+ *      - false: Failed.
+ */
+bool CircularBufferJournal_Create( CircularBufferJournal_t *pJournal, int fd, size_t dataOffset );
+
+/**
+ * @brief     Sync after a push or pop if the sync policy says so.
+ *
+ * @param     pJournal[in]        Pointer to CircularBufferJournal struct to use.
+ *
+ * @return
+ *      - true:  Synced or no sync due.
+ *      - false: Sync failed.
+ */
+bool CircularBufferJournal_Committed( CircularBufferJournal_t *pJournal );
+
+/**
+ * @brief     Write out buffer memory between two free-running positions to disk.
+ *
+ * @param     pJournal[in]        Pointer to CircularBufferJournal struct to use.
+ * @param     from[in]            Position of first byte to write out.
+ * @param     to[in]              Position after last byte to write out.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool CircularBufferJournal_SyncData( CircularBufferJournal_t *pJournal, uint64_t from, uint64_t to );
+
+/**
+ * @brief     Write out part of the mapping to disk, widened to whole pages.
+ *
+ * @param     pMemory[in]         Start of memory to write out, within the mapping.
+ * @param     length[in]          Number of bytes to write out.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool CircularBufferJournal_SyncRange( uint8_t *pMemory, size_t length );
+
+/**
+ * @brief     Get CLOCK_MONOTONIC time.
+ *
+ * @return
+ *      - Time in nanoseconds.
+ */
+uint64_t CircularBufferJournal_Now( void );
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Variables
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Interface functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferJournal_Open( CircularBufferJournal_t *pJournal, char const *pPath, size_t bufferSize,
+                                  CircularBufferJournalSync_t const *pSync )
+{
+    if ( pJournal == NULL || pPath == NULL )
+    {
+        // NULL pointers not accepted
+        return false;
+    }
+
+    if ( bufferSize < 2 || ( ( bufferSize & ~( bufferSize - 1 ) ) != bufferSize ) )
+    {
+        // bufferSize is 0 or not power of 2
+        return false;
+    }
+
+    if ( pSync != NULL && pSync->mode > ICIRCULARBUFFERJOURNAL_SYNC_INTERVAL )
+    {
+        return false;
+    }
+
+    // Buffer memory starts on a page of its own, so syncing data never has to write out the header and vice versa
+    size_t pageSize   = (size_t)sysconf( _SC_PAGESIZE );
+    size_t dataOffset = ( ( sizeof( CircularBufferJournalHeader_t ) + pageSize - 1 ) / pageSize ) * pageSize;
+    size_t mappedSize = dataOffset + bufferSize;
+
+    int fd = open( pPath, O_RDWR | O_CREAT | O_CLOEXEC, 0600 );
+    if ( fd < 0 )
+    {
+        return false;
+    }
+
+    // Held until close, a second process opening the file would move positions behind this one's back
+    struct stat status;
+    if ( flock( fd, LOCK_EX | LOCK_NB ) != 0 || fstat( fd, &status ) != 0 )
+    {
+        close( fd );
+        return false;
+    }
+
+    bool create = ( status.st_size == 0 );
+    if (
+        ( create && ftruncate( fd, (off_t)mappedSize ) != 0 ) ||
+        ( !create && (size_t)status.st_size != mappedSize )
+    )
+    {
+        close( fd );
+        return false;
+    }
+
+    void *pMemory = mmap( NULL, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    if ( pMemory == MAP_FAILED )
+    {
+        close( fd );
+        return false;
+    }
+
+    memset( pJournal, 0, sizeof( *pJournal ) );
+    pJournal->pHeader    = (CircularBufferJournalHeader_t*)pMemory;
+    pJournal->fd         = fd;
+    pJournal->pBuffer    = (uint8_t*)pMemory + dataOffset;
+    pJournal->bufferSize = bufferSize;
+    pJournal->mappedSize = mappedSize;
+    pJournal->sync.mode  = ICIRCULARBUFFERJOURNAL_SYNC_NONE;
+    if ( pSync != NULL )
+    {
+        pJournal->sync = *pSync;
+    }
+
+    // No magic means creation never finished, nothing was ever pushed so it is safe to start over
+    CircularBufferJournalHeader_t *pHeader = pJournal->pHeader;
+    if ( create || pHeader->magic == 0 )
+    {
+        if ( !CircularBufferJournal_Create( pJournal, fd, dataOffset ) )
+        {
+            close( fd );
+            munmap( pMemory, mappedSize );
+            memset( pJournal, 0, sizeof( *pJournal ) );
+            return false;
+        }
+    }
+
+    // Header must be of a layout we know and describe this buffer, positions must be within it
+    if (
+        ( pHeader->magic != ICIRCULARBUFFERJOURNAL_MAGIC ) ||
+        ( pHeader->version != ICIRCULARBUFFERJOURNAL_VERSION ) ||
+        ( pHeader->bufferSize != bufferSize ) ||
+        ( pHeader->dataOffset != dataOffset ) ||
+        ( ( pHeader->write - pHeader->read ) > bufferSize )
+    )
+    {
+        close( fd );
+        munmap( pMemory, mappedSize );
+        memset( pJournal, 0, sizeof( *pJournal ) );
+        return false;
+    }
+
+    pJournal->syncedWrite = pHeader->write;
+    pJournal->syncedRead  = pHeader->read;
+    pJournal->syncedTime  = CircularBufferJournal_Now();
+
+    return true;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferJournal_Close( CircularBufferJournal_t *pJournal )
+{
+    if ( pJournal == NULL || pJournal->pHeader == NULL )
+    {
+        return false;
+    }
+
+    // Unmap even if sync fails, the page cache still writes the data out eventually
+    bool synced = ICircularBufferJournal_Sync( pJournal );
+    if ( munmap( pJournal->pHeader, pJournal->mappedSize ) != 0 )
+    {
+        return false;
+    }
+
+    close( pJournal->fd );
+    memset( pJournal, 0, sizeof( *pJournal ) );
+
+    return synced;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferJournal_Sync( CircularBufferJournal_t *pJournal )
+{
+    if ( pJournal == NULL || pJournal->pHeader == NULL )
+    {
+        return false;
+    }
+
+    uint64_t write = pJournal->pHeader->write;
+    uint64_t read  = pJournal->pHeader->read;
+
+    // Data first, the header on disk must never cover bytes that are not
+    if (
+        ( !CircularBufferJournal_SyncData( pJournal, pJournal->syncedWrite, write ) ) ||
+        ( !CircularBufferJournal_SyncRange( (uint8_t*)pJournal->pHeader, sizeof( CircularBufferJournalHeader_t ) ) )
+    )
+    {
+        return false;
+    }
+
+    pJournal->syncedWrite = write;
+    pJournal->syncedRead  = read;
+    pJournal->syncedTime  = CircularBufferJournal_Now();
+
+    return true;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferJournal_GetCount( CircularBufferJournal_t *pJournal )
+{
+    if ( pJournal == NULL || pJournal->pHeader == NULL )
+    {
+        return 0;
+    }
+
+    return (size_t)( pJournal->pHeader->write - pJournal->pHeader->read );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferJournal_Pop( CircularBufferJournal_t *pJournal, uint8_t *pData, size_t count )
+{
+    if ( pJournal == NULL || pJournal->pHeader == NULL || pData == NULL )
+    {
+        return 0;
+    }
+
+    CircularBufferJournalHeader_t *pHeader = pJournal->pHeader;
+
+    uint64_t read      = pHeader->read;
+    size_t   available = (size_t)( pHeader->write - read );
+    if ( count > available )
+    {
+        count = available;
+    }
+
+    if ( count > 0 )
+    {
+        size_t offset = (size_t)( read & ( pJournal->bufferSize - 1 ) );
+        size_t first  = ( pJournal->bufferSize - offset );
+        if ( first > count )
+        {
+            first = count;
+        }
+
+        memcpy( pData, pJournal->pBuffer + offset, first );
+        memcpy( pData + first, pJournal->pBuffer, count - first );
+
+        // Keep the compiler from moving the position store ahead of the copy, a kill in between would lose data
+        atomic_signal_fence( memory_order_release );
+        pHeader->read = read + count;
+
+        // Pop is done either way, the caller finds out from ICircularBufferJournal_SyncFailed
+        if ( !CircularBufferJournal_Committed( pJournal ) )
+        {
+            pJournal->syncFailed = true;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferJournal_Push( CircularBufferJournal_t *pJournal, uint8_t const *pData, size_t count )
+{
+    if ( pJournal == NULL || pJournal->pHeader == NULL || pData == NULL )
+    {
+        return 0;
+    }
+
+    CircularBufferJournalHeader_t *pHeader = pJournal->pHeader;
+
+    uint64_t write     = pHeader->write;
+    size_t   available = pJournal->bufferSize - (size_t)( write - pHeader->read );
+    if ( count > available )
+    {
+        count = available;
+    }
+
+    if ( count > 0 )
+    {
+        size_t offset = (size_t)( write & ( pJournal->bufferSize - 1 ) );
+        size_t first  = ( pJournal->bufferSize - offset );
+        if ( first > count )
+        {
+            first = count;
+        }
+
+        memcpy( pJournal->pBuffer + offset, pData, first );
+        memcpy( pJournal->pBuffer, pData + first, count - first );
+
+        // Writeback may write the header page out at any time, so with a sync per push the data has to be on disk
+        // before the position covering it is even stored. If it can not be, nothing is pushed
+        if ( pJournal->sync.mode == ICIRCULARBUFFERJOURNAL_SYNC_COMMIT )
+        {
+            if ( !CircularBufferJournal_SyncData( pJournal, pJournal->syncedWrite, write + count ) )
+            {
+                pJournal->syncFailed = true;
+                return 0;
+            }
+            pJournal->syncedWrite = write + count;
+        }
+
+        // Keep the compiler from moving the position store ahead of the copy, a kill in between would expose garbage
+        atomic_signal_fence( memory_order_release );
+        pHeader->write = write + count;
+
+        // Push is done either way, the caller finds out from ICircularBufferJournal_SyncFailed
+        if ( !CircularBufferJournal_Committed( pJournal ) )
+        {
+            pJournal->syncFailed = true;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferJournal_SyncFailed( CircularBufferJournal_t *pJournal )
+{
+    if ( pJournal == NULL || pJournal->pHeader == NULL )
+    {
+        return false;
+    }
+
+    return pJournal->syncFailed;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Private functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool CircularBufferJournal_Create( CircularBufferJournal_t *pJournal, int fd, size_t dataOffset )
+{
+    CircularBufferJournalHeader_t *pHeader = pJournal->pHeader;
+
+    pHeader->magic      = 0;
+    pHeader->version    = ICIRCULARBUFFERJOURNAL_VERSION;
+    pHeader->bufferSize = pJournal->bufferSize;
+    pHeader->dataOffset = dataOffset;
+    pHeader->write      = 0;
+    pHeader->read       = 0;
+
+    // File size has to reach disk as well, msync alone does not cover metadata
+    if (
+        ( !CircularBufferJournal_SyncRange( (uint8_t*)pHeader, sizeof( *pHeader ) ) ) ||
+        ( fsync( fd ) != 0 )
+    )
+    {
+        return false;
+    }
+
+    pHeader->magic = ICIRCULARBUFFERJOURNAL_MAGIC;
+
+    return CircularBufferJournal_SyncRange( (uint8_t*)pHeader, sizeof( *pHeader ) );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool CircularBufferJournal_Committed( CircularBufferJournal_t *pJournal )
+{
+    CircularBufferJournalHeader_t *pHeader = pJournal->pHeader;
+    bool                          due      = false;
+
+    switch ( pJournal->sync.mode )
+    {
+        case ICIRCULARBUFFERJOURNAL_SYNC_COMMIT:
+            due = true;
+            break;
+        case ICIRCULARBUFFERJOURNAL_SYNC_BYTES:
+            due = ( ( pHeader->write - pJournal->syncedWrite ) + ( pHeader->read - pJournal->syncedRead ) )
+                  >= pJournal->sync.threshold;
+            break;
+        case ICIRCULARBUFFERJOURNAL_SYNC_INTERVAL:
+            due = ( CircularBufferJournal_Now() - pJournal->syncedTime ) >= pJournal->sync.threshold;
+            break;
+        default:
+            break;
+    }
+
+    return ( !due || ICircularBufferJournal_Sync( pJournal ) );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool CircularBufferJournal_SyncData( CircularBufferJournal_t *pJournal, uint64_t from, uint64_t to )
+{
+    uint64_t count = ( to - from );
+    if ( count >= pJournal->bufferSize )
+    {
+        // Wrapped all the way around since last sync, everything is dirty
+        return CircularBufferJournal_SyncRange( pJournal->pBuffer, pJournal->bufferSize );
+    }
+
+    size_t offset = (size_t)( from & ( pJournal->bufferSize - 1 ) );
+    size_t first  = ( pJournal->bufferSize - offset );
+    if ( first > count )
+    {
+        first = (size_t)count;
+    }
+
+    return (
+        ( first == 0 || CircularBufferJournal_SyncRange( pJournal->pBuffer + offset, first ) ) &&
+        ( count == first || CircularBufferJournal_SyncRange( pJournal->pBuffer, (size_t)count - first ) )
+    );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool CircularBufferJournal_SyncRange( uint8_t *pMemory, size_t length )
+{
+    // msync wants a page aligned start, the mapping itself is, so rounding down stays within it
+    uintptr_t pageSize = (uintptr_t)sysconf( _SC_PAGESIZE );
+    uintptr_t start    = (uintptr_t)pMemory & ~( pageSize - 1 );
+
+    return ( msync( (void*)start, (size_t)( (uintptr_t)pMemory + length - start ), MS_SYNC ) == 0 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+uint64_t CircularBufferJournal_Now( void )
+{
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+
+    return ( (uint64_t)now.tv_sec * 1000000000u ) + (uint64_t)now.tv_nsec;
+}
@@ -0,0 +1,35 @@
+/**
+ * @file  CircularBufferJournal.h
+ * @brief Private header for module CircularBufferJournal.
+ */
+
+#ifndef CIRCULARBUFFERJOURNAL_H
+#define CIRCULARBUFFERJOURNAL_H
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include "ICircularBufferJournal.h"
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#endif  // CIRCULARBUFFERJOURNAL_H
\ No newline at end of file
@@ -0,0 +1,252 @@
+/**
+ * @file  CircularBufferLatency.c
+ * @brief Implementation of module CircularBufferLatency.
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include "CircularBufferLatency.h"
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @brief     Get index of bucket a value is counted in.
+ *
+ * @param     value[in]           Value to look up.
+ *
+ * @return
+ *      - Index of bucket, below ICIRCULARBUFFERLATENCY_BUCKETS.
+ */
+size_t CircularBufferLatency_Bucket( uint64_t value );
+
+/**
+ * @brief     Get largest value counted in a bucket.
+ *
+ * @param     bucket[in]          Index of bucket.
+ *
+ * @return
+ *      - Largest value of bucket.
+ */
+uint64_t CircularBufferLatency_Top( size_t bucket );
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Variables
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Interface functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferLatency_Init( CircularBufferLatency_t *pLatency )
+{
+    if ( pLatency == NULL )
+    {
+        return false;
+    }
+
+    for ( size_t i = 0; i < ICIRCULARBUFFERLATENCY_BUCKETS; ++i )
+    {
+        atomic_init( &pLatency->buckets[ i ], 0 );
+    }
+    atomic_init( &pLatency->count, 0 );
+    atomic_init( &pLatency->max,   0 );
+
+    return true;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferLatency_Reset( CircularBufferLatency_t *pLatency )
+{
+    if ( pLatency == NULL )
+    {
+        return false;
+    }
+
+    // Count first, so a concurrent percentile read sees at most fewer values than the buckets hold, never more
+    atomic_store_explicit( &pLatency->count, 0, memory_order_relaxed );
+    for ( size_t i = 0; i < ICIRCULARBUFFERLATENCY_BUCKETS; ++i )
+    {
+        atomic_store_explicit( &pLatency->buckets[ i ], 0, memory_order_relaxed );
+    }
+    atomic_store_explicit( &pLatency->max, 0, memory_order_relaxed );
+
+    return true;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferLatency_Record( CircularBufferLatency_t *pLatency, uint64_t value )
+{
+    if ( pLatency == NULL )
+    {
+        return false;
+    }
+
+    // Counters are only ever read for statistics, nothing else is ordered by them
+    atomic_fetch_add_explicit( &pLatency->buckets[ CircularBufferLatency_Bucket( value ) ], 1, memory_order_relaxed );
+    atomic_fetch_add_explicit( &pLatency->count, 1, memory_order_relaxed );
+
+    // New maximums get rare quickly, so the compare and swap is almost never reached
+    uint64_t max = atomic_load_explicit( &pLatency->max, memory_order_relaxed );
+    while ( value > max )
+    {
+        if ( atomic_compare_exchange_weak_explicit( &pLatency->max, &max, value,
+                                                    memory_order_relaxed, memory_order_relaxed ) )
+        {
+            break;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+uint64_t ICircularBufferLatency_GetCount( CircularBufferLatency_t *pLatency )
+{
+    if ( pLatency == NULL )
+    {
+        return 0;
+    }
+
+    return atomic_load_explicit( &pLatency->count, memory_order_relaxed );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferLatency_GetPercentile( CircularBufferLatency_t *pLatency, double percentile, uint64_t *pValue )
+{
+    if ( pLatency == NULL || pValue == NULL || !( percentile >= 0.0 && percentile <= 100.0 ) )
+    {
+        return false;
+    }
+
+    uint64_t count = atomic_load_explicit( &pLatency->count, memory_order_relaxed );
+    if ( count == 0 )
+    {
+        return false;
+    }
+
+    // Rank of the value wanted, counting from 1, rounded up so p99 of 100 values is the 99th
+    uint64_t rank = (uint64_t)( ( percentile / 100.0 ) * (double)count );
+    if ( (double)rank < ( percentile / 100.0 ) * (double)count )
+    {
+        ++rank;
+    }
+    if ( rank == 0 )
+    {
+        rank = 1;
+    }
+
+    uint64_t max = atomic_load_explicit( &pLatency->max, memory_order_relaxed );
+    if ( rank >= count )
+    {
+        // Highest rank is the maximum, which is kept exact
+        *pValue = max;
+        return true;
+    }
+
+    uint64_t seen = 0;
+    for ( size_t i = 0; i < ICIRCULARBUFFERLATENCY_BUCKETS; ++i )
+    {
+        seen += atomic_load_explicit( &pLatency->buckets[ i ], memory_order_relaxed );
+        if ( seen >= rank )
+        {
+            // Top of a bucket may lie above anything actually recorded in it
+            uint64_t top = CircularBufferLatency_Top( i );
+            *pValue = ( top < max ) ? top : max;
+            return true;
+        }
+    }
+
+    // Values recorded while reading moved the count ahead of the buckets seen
+    *pValue = max;
+
+    return true;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Private functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t CircularBufferLatency_Bucket( uint64_t value )
+{
+    if ( value < ICIRCULARBUFFERLATENCY_SUB_BUCKETS )
+    {
+        // Small values get a bucket each
+        return (size_t)value;
+    }
+
+    // Highest set bit picks the power of 2 range, the next SUB_BITS bits the bucket within it
+    unsigned shift = (unsigned)( 63 - __builtin_clzll( value ) ) - ICIRCULARBUFFERLATENCY_SUB_BITS;
+    return ( (size_t)( shift + 1 ) * ICIRCULARBUFFERLATENCY_SUB_BUCKETS )
+         + (size_t)( ( value >> shift ) - ICIRCULARBUFFERLATENCY_SUB_BUCKETS );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+uint64_t CircularBufferLatency_Top( size_t bucket )
+{
+    if ( bucket < ICIRCULARBUFFERLATENCY_SUB_BUCKETS )
+    {
+        return (uint64_t)bucket;
+    }
+
+    unsigned shift = (unsigned)( bucket / ICIRCULARBUFFERLATENCY_SUB_BUCKETS ) - 1;
+    uint64_t sub   = ( bucket % ICIRCULARBUFFERLATENCY_SUB_BUCKETS ) + ICIRCULARBUFFERLATENCY_SUB_BUCKETS;
+
+    // One below the start of the next bucket, written so the very last bucket does not overflow
+    return ( sub << shift ) + ( ( (uint64_t)1 << shift ) - 1 );
+}
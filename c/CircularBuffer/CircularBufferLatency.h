@@ -0,0 +1,35 @@
+/**
+ * @file  CircularBufferLatency.h
+ * @brief Private header for module CircularBufferLatency.
+ */
+
+#ifndef CIRCULARBUFFERLATENCY_H
+#define CIRCULARBUFFERLATENCY_H
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include "ICircularBufferLatency.h"
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#endif  // CIRCULARBUFFERLATENCY_H
\ No newline at end of file
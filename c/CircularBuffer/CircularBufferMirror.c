@@ -0,0 +1,148 @@
+/**
+ * @file  CircularBufferMirror.c
+ * @brief Implementation of module CircularBufferMirror.
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#define _GNU_SOURCE // memfd_create
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "CircularBufferMirror.h"
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Variables
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Interface functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferMirror_Init( CircularBuffer_t *pCircularBuffer, size_t bufferSize )
+{
+    if ( pCircularBuffer == NULL )
+    {
+        // NULL pointers not accepted
+        return false;
+    }
+
+    long pageSize = sysconf( _SC_PAGESIZE );
+    if ( pageSize <= 0 || ( bufferSize % (size_t)pageSize ) != 0 )
+    {
+        // Both mappings have to start on a page boundary
+        return false;
+    }
+
+    if ( bufferSize < 2 || ( ( bufferSize & ~( bufferSize - 1 ) ) != bufferSize ) )
+    {
+        // bufferSize is 0 or not power of 2
+        return false;
+    }
+
+    int fd = memfd_create( "CircularBuffer", MFD_CLOEXEC );
+    if ( fd < 0 )
+    {
+        return false;
+    }
+
+    if ( ftruncate( fd, (off_t)bufferSize ) != 0 )
+    {
+        close( fd );
+        return false;
+    }
+
+    // Reserve address space for both copies, then map the same pages into each half
+    uint8_t *pBuffer = mmap( NULL, 2 * bufferSize, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+    if ( pBuffer == MAP_FAILED )
+    {
+        close( fd );
+        return false;
+    }
+
+    if (
+        ( mmap( pBuffer,              bufferSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0 ) == MAP_FAILED ) ||
+        ( mmap( pBuffer + bufferSize, bufferSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0 ) == MAP_FAILED )
+    )
+    {
+        munmap( pBuffer, 2 * bufferSize );
+        close( fd );
+        return false;
+    }
+
+    // Mappings keep the memory alive on their own
+    close( fd );
+
+    if ( !ICircularBuffer_Init( pCircularBuffer, pBuffer, bufferSize ) )
+    {
+        munmap( pBuffer, 2 * bufferSize );
+        return false;
+    }
+    pCircularBuffer->mirrored = true;
+
+    return true;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferMirror_Deinit( CircularBuffer_t *pCircularBuffer )
+{
+    if ( pCircularBuffer == NULL || !pCircularBuffer->mirrored )
+    {
+        return false;
+    }
+
+    if ( munmap( pCircularBuffer->pBuffer, 2 * pCircularBuffer->bufferSize ) != 0 )
+    {
+        return false;
+    }
+
+    pCircularBuffer->pBuffer    = NULL;
+    pCircularBuffer->write      = 0;
+    pCircularBuffer->read       = 0;
+    pCircularBuffer->bufferSize = 0;
+    pCircularBuffer->mirrored   = false;
+
+    return true;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Private functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
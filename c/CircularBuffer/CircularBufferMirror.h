@@ -0,0 +1,35 @@
+/**
+ * @file  CircularBufferMirror.h
+ * @brief Private header for module CircularBufferMirror.
+ */
+
+#ifndef CIRCULARBUFFERMIRROR_H
+#define CIRCULARBUFFERMIRROR_H
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include "ICircularBufferMirror.h"
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#endif  // CIRCULARBUFFERMIRROR_H
\ No newline at end of file
@@ -0,0 +1,239 @@
+/**
+ * @file  CircularBufferMpmc.c
+ * @brief Implementation of module CircularBufferMpmc.
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include <string.h>
+
+#include "CircularBufferMpmc.h"
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @brief     Get sequence number of slot at position.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferMpmc struct to use.
+ * @param     position[in]        Free-running position of slot.
+ *
+ * @return
+ *      - Pointer to sequence number of slot.
+ */
+atomic_size_t *CircularBufferMpmc_GetSequence( CircularBufferMpmc_t *pCircularBuffer, size_t position );
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Variables
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Interface functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferMpmc_Init( CircularBufferMpmc_t *pCircularBuffer, uint8_t *pBuffer, size_t slotCount, size_t elementSize )
+{
+    if ( pCircularBuffer == NULL || pBuffer == NULL )
+    {
+        // NULL pointers not accepted
+        return false;
+    }
+
+    if ( slotCount < 2 || ( ( slotCount & ~( slotCount - 1 ) ) != slotCount ) )
+    {
+        // slotCount is 0 or not power of 2
+        return false;
+    }
+
+    if ( elementSize == 0 || ( (uintptr_t)pBuffer % _Alignof( atomic_size_t ) ) != 0 )
+    {
+        // Nothing to store or sequence numbers would end up misaligned
+        return false;
+    }
+
+    pCircularBuffer->pBuffer     = pBuffer;
+    pCircularBuffer->slotCount   = slotCount;
+    pCircularBuffer->slotSize    = ICIRCULARBUFFERMPMC_SLOT_SIZE( elementSize );
+    pCircularBuffer->elementSize = elementSize;
+
+    // Slot n is free for the producer claiming position n
+    for ( size_t i = 0; i < slotCount; ++i )
+    {
+        atomic_init( CircularBufferMpmc_GetSequence( pCircularBuffer, i ), i );
+    }
+
+    atomic_init( &pCircularBuffer->enqueuePos, 0 );
+    atomic_init( &pCircularBuffer->dequeuePos, 0 );
+
+    return true;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferMpmc_GetCount( CircularBufferMpmc_t *pCircularBuffer )
+{
+    if ( pCircularBuffer == NULL )
+    {
+        return 0;
+    }
+
+    size_t dequeuePos = atomic_load_explicit( &pCircularBuffer->dequeuePos, memory_order_acquire );
+    size_t enqueuePos = atomic_load_explicit( &pCircularBuffer->enqueuePos, memory_order_acquire );
+
+    // Positions are claimed before slots are filled, so count includes elements still being written
+    size_t count = ( enqueuePos - dequeuePos );
+    if ( count > pCircularBuffer->slotCount )
+    {
+        // Consumers raced past the snapshot of enqueuePos
+        count = 0;
+    }
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferMpmc_Pop( CircularBufferMpmc_t *pCircularBuffer, uint8_t *pElement )
+{
+    if ( pCircularBuffer == NULL || pElement == NULL )
+    {
+        return false;
+    }
+
+    atomic_size_t *pSequence = NULL;
+    size_t        position   = atomic_load_explicit( &pCircularBuffer->dequeuePos, memory_order_relaxed );
+    for ( ;; )
+    {
+        pSequence = CircularBufferMpmc_GetSequence( pCircularBuffer, position );
+        size_t   sequence   = atomic_load_explicit( pSequence, memory_order_acquire );
+        intptr_t difference = (intptr_t)sequence - (intptr_t)( position + 1 );
+
+        if ( difference == 0 )
+        {
+            // Slot is filled for this position, try to claim it
+            if ( atomic_compare_exchange_weak_explicit( &pCircularBuffer->dequeuePos, &position, position + 1,
+                                                        memory_order_relaxed, memory_order_relaxed ) )
+            {
+                break;
+            }
+        }
+        else if ( difference < 0 )
+        {
+            // Slot not yet written, buffer is empty
+            return false;
+        }
+        else
+        {
+            // Another consumer claimed the position, reload and retry
+            position = atomic_load_explicit( &pCircularBuffer->dequeuePos, memory_order_relaxed );
+        }
+    }
+
+    memcpy( pElement, (uint8_t*)pSequence + sizeof( atomic_size_t ), pCircularBuffer->elementSize );
+
+    // Hand slot back to the producer claiming it one lap later
+    atomic_store_explicit( pSequence, position + pCircularBuffer->slotCount, memory_order_release );
+
+    return true;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferMpmc_Push( CircularBufferMpmc_t *pCircularBuffer, uint8_t const *pElement )
+{
+    if ( pCircularBuffer == NULL || pElement == NULL )
+    {
+        return false;
+    }
+
+    atomic_size_t *pSequence = NULL;
+    size_t        position   = atomic_load_explicit( &pCircularBuffer->enqueuePos, memory_order_relaxed );
+    for ( ;; )
+    {
+        pSequence = CircularBufferMpmc_GetSequence( pCircularBuffer, position );
+        size_t   sequence   = atomic_load_explicit( pSequence, memory_order_acquire );
+        intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+        if ( difference == 0 )
+        {
+            // Slot is free for this position, try to claim it
+            if ( atomic_compare_exchange_weak_explicit( &pCircularBuffer->enqueuePos, &position, position + 1,
+                                                        memory_order_relaxed, memory_order_relaxed ) )
+            {
+                break;
+            }
+        }
+        else if ( difference < 0 )
+        {
+            // Slot not yet consumed since last lap, buffer is full
+            return false;
+        }
+        else
+        {
+            // Another producer claimed the position, reload and retry
+            position = atomic_load_explicit( &pCircularBuffer->enqueuePos, memory_order_relaxed );
+        }
+    }
+
+    memcpy( (uint8_t*)pSequence + sizeof( atomic_size_t ), pElement, pCircularBuffer->elementSize );
+
+    // Publish element to the consumer claiming this position
+    atomic_store_explicit( pSequence, position + 1, memory_order_release );
+
+    return true;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Private functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+atomic_size_t *CircularBufferMpmc_GetSequence( CircularBufferMpmc_t *pCircularBuffer, size_t position )
+{
+    size_t slot = ( position & ( pCircularBuffer->slotCount - 1 ) );
+
+    return (atomic_size_t*)( pCircularBuffer->pBuffer + ( slot * pCircularBuffer->slotSize ) );
+}
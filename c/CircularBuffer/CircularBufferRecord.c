@@ -0,0 +1,257 @@
+/**
+ * @file  CircularBufferRecord.c
+ * @brief Implementation of module CircularBufferRecord.
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include <string.h>
+
+#include "CircularBufferRecord.h"
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @brief     Find record at or after position, stepping over a skip marker.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     pPosition[in,out]   Free-running position of header to start at, set to position after the record.
+ * @param     pRecord[out]        Set to payload and length of record.
+ *
+ * @return
+ *      - true:  Record found.
+ *      - false: No record before write position.
+ */
+bool CircularBufferRecord_Next( CircularBuffer_t *pCircularBuffer, uint64_t *pPosition, CircularBufferSegment_t *pRecord );
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Variables
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Interface functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferRecord_Push( CircularBuffer_t *pCircularBuffer, uint8_t const *pData, size_t length )
+{
+    // A resize copies raw bytes, skip markers included, and frees memory a peeked record may still point into
+    if ( pCircularBuffer == NULL || ( pData == NULL && length > 0 ) || pCircularBuffer->overwrite
+         || pCircularBuffer->pGrowth != NULL )
+    {
+        return false;
+    }
+
+    if ( pCircularBuffer->bufferSize < ICIRCULARBUFFERRECORD_ALIGNMENT
+         || length > ( pCircularBuffer->bufferSize - sizeof( uint32_t ) ) || length >= ICIRCULARBUFFERRECORD_SKIP )
+    {
+        // Would never fit, or header could not hold length (buffers above 4 GiB) or would read as a skip marker
+        return false;
+    }
+
+    size_t   size = ICIRCULARBUFFERRECORD_SIZE( length );
+    size_t   skip = 0;
+    uint8_t *pRecord;
+    if ( size > pCircularBuffer->bufferSize )
+    {
+        return false;
+    }
+
+    if ( ICircularBuffer_Reserve( pCircularBuffer, &pRecord, size ) < size )
+    {
+        size_t count = ICircularBuffer_GetCount( pCircularBuffer );
+        if ( count == 0 )
+        {
+            // Nothing to keep, skip ahead to the beginning of buffer memory where the whole buffer is contiguous.
+            // Positions only move forward, and skipped space was never pushed so it stays out of the checksum range
+            size_t skipped = pCircularBuffer->bufferSize
+                             - (size_t)( pCircularBuffer->write & ( pCircularBuffer->bufferSize - 1 ) );
+            pCircularBuffer->write += skipped;
+            pCircularBuffer->read   = pCircularBuffer->write;
+#ifdef ICIRCULARBUFFER_CRC
+            pCircularBuffer->crcStart += skipped;
+#endif
+        }
+        else
+        {
+            // A mirrored buffer is contiguous up to free space, so short here means full
+            size_t offset = (size_t)( pCircularBuffer->write & ( pCircularBuffer->bufferSize - 1 ) );
+            skip = ( pCircularBuffer->bufferSize - offset );
+            if ( pCircularBuffer->mirrored || ( skip + size ) > ( pCircularBuffer->bufferSize - count ) )
+            {
+                return false;
+            }
+
+            uint32_t marker = ICIRCULARBUFFERRECORD_SKIP;
+            memcpy( pCircularBuffer->pBuffer + offset, &marker, sizeof( marker ) );
+        }
+
+        pRecord = pCircularBuffer->pBuffer;
+    }
+
+    uint32_t header = (uint32_t)length;
+    memcpy( pRecord, &header, sizeof( header ) );
+    if ( length > 0 )
+    {
+        memcpy( pRecord + sizeof( header ), pData, length );
+    }
+
+    // Skip marker and record are committed together, a reader never sees one without the other
+    ICircularBuffer_Commit( pCircularBuffer, skip + size );
+
+    return true;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferRecord_Peek( CircularBuffer_t *pCircularBuffer, uint8_t const **ppData, size_t *pLength )
+{
+    if ( pCircularBuffer == NULL || ppData == NULL || pLength == NULL )
+    {
+        return false;
+    }
+
+    uint64_t                position = pCircularBuffer->read;
+    CircularBufferSegment_t record;
+    if ( !CircularBufferRecord_Next( pCircularBuffer, &position, &record ) )
+    {
+        return false;
+    }
+
+    *ppData  = record.pData;
+    *pLength = record.size;
+
+    return true;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferRecord_PeekBatch( CircularBuffer_t *pCircularBuffer, CircularBufferSegment_t *pRecords, size_t max )
+{
+    if ( pCircularBuffer == NULL || pRecords == NULL )
+    {
+        return 0;
+    }
+
+    uint64_t position = pCircularBuffer->read;
+    size_t   count    = 0;
+    while ( count < max && CircularBufferRecord_Next( pCircularBuffer, &position, &pRecords[ count ] ) )
+    {
+        ++count;
+    }
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferRecord_Pop( CircularBuffer_t *pCircularBuffer )
+{
+    return ( ICircularBufferRecord_PopBatch( pCircularBuffer, 1 ) == 1 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferRecord_PopBatch( CircularBuffer_t *pCircularBuffer, size_t count )
+{
+    if ( pCircularBuffer == NULL )
+    {
+        return 0;
+    }
+
+    uint64_t                position = pCircularBuffer->read;
+    CircularBufferSegment_t record;
+    size_t                  popped   = 0;
+    while ( popped < count && CircularBufferRecord_Next( pCircularBuffer, &position, &record ) )
+    {
+        ++popped;
+    }
+
+    if ( popped > 0 )
+    {
+        ICircularBuffer_Release( pCircularBuffer, (size_t)( position - pCircularBuffer->read ) );
+    }
+
+    return popped;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Private functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool CircularBufferRecord_Next( CircularBuffer_t *pCircularBuffer, uint64_t *pPosition, CircularBufferSegment_t *pRecord )
+{
+    uint64_t position = *pPosition;
+    uint32_t header;
+    size_t   offset;
+
+    // At most one skip marker in a row, the record after it always starts at offset 0
+    for ( int i = 0; i < 2; ++i )
+    {
+        if ( position == pCircularBuffer->write )
+        {
+            return false;
+        }
+
+        offset = (size_t)( position & ( pCircularBuffer->bufferSize - 1 ) );
+        memcpy( &header, pCircularBuffer->pBuffer + offset, sizeof( header ) );
+        if ( header != ICIRCULARBUFFERRECORD_SKIP )
+        {
+            pRecord->pData = pCircularBuffer->pBuffer + offset + sizeof( header );
+            pRecord->size  = header;
+            *pPosition     = position + ICIRCULARBUFFERRECORD_SIZE( header );
+            return true;
+        }
+
+        position += ( pCircularBuffer->bufferSize - offset );
+    }
+
+    return false;
+}
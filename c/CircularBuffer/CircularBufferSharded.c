@@ -0,0 +1,357 @@
+/**
+ * @file  CircularBufferSharded.c
+ * @brief Implementation of module CircularBufferSharded.
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include "CircularBufferSharded.h"
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @brief     Find shard with the most data in it, among home or other shards of a consumer.
+ *
+ * @param     pSharded[in]        Pointer to CircularBufferSharded struct to use.
+ * @param     consumer[in]        Index of consumer.
+ * @param     home[in]            Look at the consumer's home shards if true, at all other shards if false.
+ *
+ * @return
+ *      - Index of shard holding at least one element and not being popped from, shard count if none.
+ */
+size_t CircularBufferSharded_Fullest( CircularBufferSharded_t *pSharded, size_t consumer, bool home );
+
+/**
+ * @brief     Pop whole elements from one shard, unless another consumer is popping from it.
+ *
+ * @param     pSharded[in]        Pointer to CircularBufferSharded struct to use.
+ * @param     shard[in]           Index of shard to pop from.
+ * @param     pData[out]          Where data is to be copied to.
+ * @param     count[in]           Maximum number of bytes to pop.
+ *
+ * @return
+ *      - Number of bytes copied/popped.
+ */
+size_t CircularBufferSharded_PopShard( CircularBufferSharded_t *pSharded, size_t shard, uint8_t *pData, size_t count );
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Variables
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Interface functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferSharded_Init( CircularBufferSharded_t *pSharded, CircularBufferShard_t *pShards, size_t shardCount,
+                                  uint8_t *pBuffer, size_t bufferSize, size_t elementSize, size_t consumerCount,
+                                  CircularBufferShardedPick_t pick )
+{
+    if ( pSharded == NULL || pShards == NULL || pBuffer == NULL )
+    {
+        // NULL pointers not accepted
+        return false;
+    }
+
+    if (
+        ( shardCount == 0 ) ||
+        ( consumerCount == 0 ) ||
+        ( consumerCount > shardCount ) ||
+        ( elementSize == 0 ) ||
+        ( pick > ICIRCULARBUFFERSHARDED_PICK_LEAST_LOADED )
+    )
+    {
+        return false;
+    }
+
+    size_t shardSize = bufferSize / shardCount;
+    if ( ( shardSize * shardCount ) != bufferSize || shardSize < elementSize )
+    {
+        // Buffer memory does not split evenly, or a shard would not hold a single element
+        return false;
+    }
+
+    for ( size_t i = 0; i < shardCount; ++i )
+    {
+        // Power of 2 is checked here, once per shard
+        if ( !ICircularBufferSpsc_Init( &pShards[ i ].ring, pBuffer + ( i * shardSize ), shardSize ) )
+        {
+            return false;
+        }
+        atomic_init( &pShards[ i ].attached, false );
+        atomic_init( &pShards[ i ].locked,   false );
+    }
+
+    pSharded->pShards       = pShards;
+    pSharded->shardCount    = shardCount;
+    pSharded->shardSize     = shardSize;
+    pSharded->elementSize   = elementSize;
+    pSharded->consumerCount = consumerCount;
+    pSharded->pick          = pick;
+    atomic_init( &pSharded->next, 0 );
+
+    return true;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferSharded_Attach( CircularBufferSharded_t *pSharded, size_t *pShard )
+{
+    if ( pSharded == NULL || pShard == NULL )
+    {
+        return false;
+    }
+
+    size_t start = 0;
+    if ( pSharded->pick == ICIRCULARBUFFERSHARDED_PICK_ROUND_ROBIN )
+    {
+        start = atomic_fetch_add_explicit( &pSharded->next, 1, memory_order_relaxed ) % pSharded->shardCount;
+    }
+
+    // A lost race for a shard only costs another look, every loop either attaches or sees one more shard taken
+    for ( size_t attempt = 0; attempt < pSharded->shardCount; ++attempt )
+    {
+        size_t shard = pSharded->shardCount;
+        size_t least = SIZE_MAX;
+        for ( size_t i = 0; i < pSharded->shardCount; ++i )
+        {
+            size_t                index       = ( start + i ) % pSharded->shardCount;
+            CircularBufferShard_t *pCandidate = &pSharded->pShards[ index ];
+            if ( atomic_load_explicit( &pCandidate->attached, memory_order_relaxed ) )
+            {
+                continue;
+            }
+
+            size_t count = ( pSharded->pick == ICIRCULARBUFFERSHARDED_PICK_LEAST_LOADED )
+                         ? ICircularBufferSpsc_GetCount( &pCandidate->ring )
+                         : 0;
+            if ( count < least )
+            {
+                shard = index;
+                least = count;
+                if ( pSharded->pick == ICIRCULARBUFFERSHARDED_PICK_ROUND_ROBIN )
+                {
+                    break;
+                }
+            }
+        }
+
+        if ( shard == pSharded->shardCount )
+        {
+            // All taken
+            return false;
+        }
+
+        // Acquire pairs with the release in detach, producer state of the ring is handed over with the shard
+        bool expected = false;
+        if ( atomic_compare_exchange_strong_explicit( &pSharded->pShards[ shard ].attached, &expected, true,
+                                                      memory_order_acquire, memory_order_relaxed ) )
+        {
+            *pShard = shard;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferSharded_Detach( CircularBufferSharded_t *pSharded, size_t shard )
+{
+    if ( pSharded == NULL || shard >= pSharded->shardCount )
+    {
+        return false;
+    }
+
+    bool expected = true;
+    return atomic_compare_exchange_strong_explicit( &pSharded->pShards[ shard ].attached, &expected, false,
+                                                    memory_order_release, memory_order_relaxed );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferSharded_GetCount( CircularBufferSharded_t *pSharded )
+{
+    if ( pSharded == NULL )
+    {
+        return 0;
+    }
+
+    size_t count = 0;
+    for ( size_t i = 0; i < pSharded->shardCount; ++i )
+    {
+        count += ICircularBufferSpsc_GetCount( &pSharded->pShards[ i ].ring );
+    }
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferSharded_Pop( CircularBufferSharded_t *pSharded, size_t consumer, uint8_t *pData, size_t count,
+                                   size_t *pShard )
+{
+    if ( pSharded == NULL || pData == NULL || consumer >= pSharded->consumerCount )
+    {
+        return 0;
+    }
+
+    // Home shards first, only an idle consumer steals. Losing the lock race to another consumer only costs another
+    // look, as Fullest skips locked shards, so every shard of a group gets a chance before moving on to the next
+    for ( int home = 1; home >= 0; --home )
+    {
+        for ( size_t attempt = 0; attempt < pSharded->shardCount; ++attempt )
+        {
+            size_t shard = CircularBufferSharded_Fullest( pSharded, consumer, ( home != 0 ) );
+            if ( shard >= pSharded->shardCount )
+            {
+                break;
+            }
+
+            size_t popped = CircularBufferSharded_PopShard( pSharded, shard, pData, count );
+            if ( popped > 0 )
+            {
+                if ( pShard != NULL )
+                {
+                    *pShard = shard;
+                }
+                return popped;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferSharded_Push( CircularBufferSharded_t *pSharded, size_t shard, uint8_t const *pData,
+                                    size_t count )
+{
+    if ( pSharded == NULL || pData == NULL || shard >= pSharded->shardCount )
+    {
+        return 0;
+    }
+
+    CircularBufferSpsc_t *pRing = &pSharded->pShards[ shard ].ring;
+
+    // Free space only grows behind the producer's back, so whole elements that fit now still fit when pushed
+    size_t available = pSharded->shardSize - ICircularBufferSpsc_GetCount( pRing );
+    if ( count > available )
+    {
+        count = available;
+    }
+    count -= ( count % pSharded->elementSize );
+
+    return ( count > 0 ) ? ICircularBufferSpsc_Push( pRing, pData, count ) : 0;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Private functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t CircularBufferSharded_Fullest( CircularBufferSharded_t *pSharded, size_t consumer, bool home )
+{
+    size_t fullest = pSharded->shardCount;
+    size_t most    = pSharded->elementSize - 1;
+
+    for ( size_t i = 0; i < pSharded->shardCount; ++i )
+    {
+        CircularBufferShard_t *pShard = &pSharded->pShards[ i ];
+        if ( ( ( i % pSharded->consumerCount ) == consumer ) != home )
+        {
+            continue;
+        }
+
+        // Skip shards another consumer is busy with, rather than wait for them
+        size_t count = ICircularBufferSpsc_GetCount( &pShard->ring );
+        if ( count > most && !atomic_load_explicit( &pShard->locked, memory_order_relaxed ) )
+        {
+            fullest = i;
+            most    = count;
+        }
+    }
+
+    return fullest;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t CircularBufferSharded_PopShard( CircularBufferSharded_t *pSharded, size_t shard, uint8_t *pData, size_t count )
+{
+    CircularBufferShard_t *pShard = &pSharded->pShards[ shard ];
+
+    // Acquire pairs with the release below, consumer state of the ring is handed over with the lock
+    if ( atomic_exchange_explicit( &pShard->locked, true, memory_order_acquire ) )
+    {
+        return 0;
+    }
+
+    // Data only grows behind the consumer's back, so whole elements available now are still there when popped
+    size_t available = ICircularBufferSpsc_GetCount( &pShard->ring );
+    if ( count > available )
+    {
+        count = available;
+    }
+    count -= ( count % pSharded->elementSize );
+
+    size_t popped = ( count > 0 ) ? ICircularBufferSpsc_Pop( &pShard->ring, pData, count ) : 0;
+
+    atomic_store_explicit( &pShard->locked, false, memory_order_release );
+
+    return popped;
+}
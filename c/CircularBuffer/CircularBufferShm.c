@@ -0,0 +1,414 @@
+/**
+ * @file  CircularBufferShm.c
+ * @brief Implementation of module CircularBufferShm.
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#define _DEFAULT_SOURCE // shm_open, fstat
+
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "CircularBufferShm.h"
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @def   CIRCULARBUFFERSHM_DATA_OFFSET
+ * @brief Offset of buffer memory from start of shared memory, header rounded up to whole cache lines.
+ */
+#define CIRCULARBUFFERSHM_DATA_OFFSET \
+    ( ( sizeof( CircularBufferShmHeader_t ) + ( ICIRCULARBUFFERSHM_CACHE_LINE_SIZE - 1 ) ) & ~(size_t)( ICIRCULARBUFFERSHM_CACHE_LINE_SIZE - 1 ) )
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @brief     Map shared memory object and set up process-local handle.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferShm struct to initialize.
+ * @param     fd[in]              File descriptor of shared memory object.
+ * @param     mappedSize[in]      Size of shared memory object.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool CircularBufferShm_Map( CircularBufferShm_t *pCircularBuffer, int fd, size_t mappedSize );
+
+/**
+ * @brief     Get number of bytes readable by consumer, loading the write index only if the cached copy is short.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferShm struct to use.
+ * @param     read[in]            Current read index.
+ * @param     wanted[in]          Number of bytes consumer would like to read.
+ *
+ * @return
+ *      - Number of bytes readable, may be less than actually available when wanted is satisfied.
+ */
+size_t CircularBufferShm_Readable( CircularBufferShm_t *pCircularBuffer, uint64_t read, size_t wanted );
+
+/**
+ * @brief     Get number of bytes writable by producer, loading the read index only if the cached copy is short.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferShm struct to use.
+ * @param     write[in]           Current write index.
+ * @param     wanted[in]          Number of bytes producer would like to write.
+ *
+ * @return
+ *      - Number of bytes writable, may be less than actually free when wanted is satisfied.
+ */
+size_t CircularBufferShm_Writable( CircularBufferShm_t *pCircularBuffer, uint64_t write, size_t wanted );
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Variables
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Interface functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferShm_Create( CircularBufferShm_t *pCircularBuffer, char const *pName, size_t bufferSize )
+{
+    if ( pCircularBuffer == NULL || pName == NULL )
+    {
+        // NULL pointers not accepted
+        return false;
+    }
+
+    if ( bufferSize < 2 || ( ( bufferSize & ~( bufferSize - 1 ) ) != bufferSize ) )
+    {
+        // bufferSize is 0 or not power of 2
+        return false;
+    }
+
+    int fd = shm_open( pName, O_RDWR | O_CREAT | O_EXCL, 0600 );
+    if ( fd < 0 )
+    {
+        return false;
+    }
+
+    size_t mappedSize = CIRCULARBUFFERSHM_DATA_OFFSET + bufferSize;
+    if ( ftruncate( fd, (off_t)mappedSize ) != 0 || !CircularBufferShm_Map( pCircularBuffer, fd, mappedSize ) )
+    {
+        close( fd );
+        shm_unlink( pName );
+        return false;
+    }
+    close( fd );
+
+    // Indices have to be lock-free to work across processes
+    CircularBufferShmHeader_t *pHeader = pCircularBuffer->pHeader;
+    if ( !atomic_is_lock_free( &pHeader->write ) )
+    {
+        ICircularBufferShm_Detach( pCircularBuffer );
+        shm_unlink( pName );
+        return false;
+    }
+
+    pHeader->version    = ICIRCULARBUFFERSHM_VERSION;
+    pHeader->bufferSize = bufferSize;
+    pHeader->dataOffset = CIRCULARBUFFERSHM_DATA_OFFSET;
+    atomic_init( &pHeader->write, 0 );
+    atomic_init( &pHeader->read,  0 );
+
+    pCircularBuffer->pBuffer    = (uint8_t*)pHeader + CIRCULARBUFFERSHM_DATA_OFFSET;
+    pCircularBuffer->bufferSize = bufferSize;
+
+    // Magic last, so an attaching process never sees a half set up header
+    atomic_store_explicit( &pHeader->magic, ICIRCULARBUFFERSHM_MAGIC, memory_order_release );
+
+    return true;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferShm_Attach( CircularBufferShm_t *pCircularBuffer, char const *pName )
+{
+    if ( pCircularBuffer == NULL || pName == NULL )
+    {
+        // NULL pointers not accepted
+        return false;
+    }
+
+    int fd = shm_open( pName, O_RDWR, 0 );
+    if ( fd < 0 )
+    {
+        return false;
+    }
+
+    struct stat status;
+    if (
+        ( fstat( fd, &status ) != 0 ) ||
+        ( (size_t)status.st_size < sizeof( CircularBufferShmHeader_t ) ) ||
+        ( !CircularBufferShm_Map( pCircularBuffer, fd, (size_t)status.st_size ) )
+    )
+    {
+        close( fd );
+        return false;
+    }
+    close( fd );
+
+    // Header must be complete and of a layout we know, and describe memory that is actually there. It is written by
+    // another process, so each field is read once and the checks can not overflow
+    CircularBufferShmHeader_t *pHeader = pCircularBuffer->pHeader;
+    if ( atomic_load_explicit( &pHeader->magic, memory_order_acquire ) != ICIRCULARBUFFERSHM_MAGIC )
+    {
+        ICircularBufferShm_Detach( pCircularBuffer );
+        return false;
+    }
+
+    uint64_t dataOffset = pHeader->dataOffset;
+    uint64_t bufferSize = pHeader->bufferSize;
+    if (
+        ( pHeader->version != ICIRCULARBUFFERSHM_VERSION ) ||
+        ( dataOffset < sizeof( CircularBufferShmHeader_t ) ) ||
+        ( ( dataOffset & ( ICIRCULARBUFFERSHM_CACHE_LINE_SIZE - 1 ) ) != 0 ) ||
+        ( bufferSize < 2 ) ||
+        ( ( bufferSize & ( bufferSize - 1 ) ) != 0 ) ||
+        ( dataOffset > pCircularBuffer->mappedSize ) ||
+        ( bufferSize > pCircularBuffer->mappedSize - dataOffset )
+    )
+    {
+        ICircularBufferShm_Detach( pCircularBuffer );
+        return false;
+    }
+
+    pCircularBuffer->pBuffer    = (uint8_t*)pHeader + dataOffset;
+    pCircularBuffer->bufferSize = (size_t)bufferSize;
+    pCircularBuffer->readCache  = atomic_load_explicit( &pHeader->read,  memory_order_acquire );
+    pCircularBuffer->writeCache = atomic_load_explicit( &pHeader->write, memory_order_acquire );
+
+    return true;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferShm_Detach( CircularBufferShm_t *pCircularBuffer )
+{
+    if ( pCircularBuffer == NULL || pCircularBuffer->pHeader == NULL )
+    {
+        return false;
+    }
+
+    if ( munmap( pCircularBuffer->pHeader, pCircularBuffer->mappedSize ) != 0 )
+    {
+        return false;
+    }
+
+    memset( pCircularBuffer, 0, sizeof( *pCircularBuffer ) );
+
+    return true;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferShm_Unlink( char const *pName )
+{
+    if ( pName == NULL )
+    {
+        return false;
+    }
+
+    return ( shm_unlink( pName ) == 0 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferShm_GetCount( CircularBufferShm_t *pCircularBuffer )
+{
+    if ( pCircularBuffer == NULL || pCircularBuffer->pHeader == NULL )
+    {
+        return 0;
+    }
+
+    // Load read first, write can only move away from it, so the difference never goes negative
+    uint64_t read  = atomic_load_explicit( &pCircularBuffer->pHeader->read,  memory_order_acquire );
+    uint64_t write = atomic_load_explicit( &pCircularBuffer->pHeader->write, memory_order_acquire );
+
+    return (size_t)( write - read );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferShm_Pop( CircularBufferShm_t *pCircularBuffer, uint8_t *pData, size_t count )
+{
+    if ( pCircularBuffer == NULL || pCircularBuffer->pHeader == NULL || pData == NULL )
+    {
+        return 0;
+    }
+
+    CircularBufferShmHeader_t *pHeader = pCircularBuffer->pHeader;
+
+    uint64_t read      = atomic_load_explicit( &pHeader->read, memory_order_relaxed );
+    size_t   available = CircularBufferShm_Readable( pCircularBuffer, read, count );
+    if ( count > available )
+    {
+        count = available;
+    }
+
+    if ( count > 0 )
+    {
+        size_t offset = (size_t)( read & ( pCircularBuffer->bufferSize - 1 ) );
+        size_t first  = ( pCircularBuffer->bufferSize - offset );
+        if ( first > count )
+        {
+            first = count;
+        }
+
+        memcpy( pData, pCircularBuffer->pBuffer + offset, first );
+        memcpy( pData + first, pCircularBuffer->pBuffer, count - first );
+
+        // Release hands the bytes back to the producer only after data has been copied out
+        atomic_store_explicit( &pHeader->read, read + count, memory_order_release );
+    }
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferShm_Push( CircularBufferShm_t *pCircularBuffer, uint8_t const *pData, size_t count )
+{
+    if ( pCircularBuffer == NULL || pCircularBuffer->pHeader == NULL || pData == NULL )
+    {
+        return 0;
+    }
+
+    CircularBufferShmHeader_t *pHeader = pCircularBuffer->pHeader;
+
+    uint64_t write     = atomic_load_explicit( &pHeader->write, memory_order_relaxed );
+    size_t   available = CircularBufferShm_Writable( pCircularBuffer, write, count );
+    if ( count > available )
+    {
+        count = available;
+    }
+
+    if ( count > 0 )
+    {
+        size_t offset = (size_t)( write & ( pCircularBuffer->bufferSize - 1 ) );
+        size_t first  = ( pCircularBuffer->bufferSize - offset );
+        if ( first > count )
+        {
+            first = count;
+        }
+
+        memcpy( pCircularBuffer->pBuffer + offset, pData, first );
+        memcpy( pCircularBuffer->pBuffer, pData + first, count - first );
+
+        // Release publishes the data before the consumer can observe the new write index
+        atomic_store_explicit( &pHeader->write, write + count, memory_order_release );
+    }
+
+    return count;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Private functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool CircularBufferShm_Map( CircularBufferShm_t *pCircularBuffer, int fd, size_t mappedSize )
+{
+    void *pMemory = mmap( NULL, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0 );
+    if ( pMemory == MAP_FAILED )
+    {
+        return false;
+    }
+
+    memset( pCircularBuffer, 0, sizeof( *pCircularBuffer ) );
+    pCircularBuffer->pHeader    = (CircularBufferShmHeader_t*)pMemory;
+    pCircularBuffer->mappedSize = mappedSize;
+
+    return true;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t CircularBufferShm_Readable( CircularBufferShm_t *pCircularBuffer, uint64_t read, size_t wanted )
+{
+    size_t available = (size_t)( pCircularBuffer->writeCache - read );
+    if ( available < wanted )
+    {
+        // Looks too empty, acquire on write index makes the producers data visible
+        pCircularBuffer->writeCache = atomic_load_explicit( &pCircularBuffer->pHeader->write, memory_order_acquire );
+        available                   = (size_t)( pCircularBuffer->writeCache - read );
+    }
+
+    return available;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t CircularBufferShm_Writable( CircularBufferShm_t *pCircularBuffer, uint64_t write, size_t wanted )
+{
+    size_t available = ( pCircularBuffer->bufferSize - (size_t)( write - pCircularBuffer->readCache ) );
+    if ( available < wanted )
+    {
+        // Looks too full, acquire on read index makes sure consumer is done with the freed bytes
+        pCircularBuffer->readCache = atomic_load_explicit( &pCircularBuffer->pHeader->read, memory_order_acquire );
+        available                  = ( pCircularBuffer->bufferSize - (size_t)( write - pCircularBuffer->readCache ) );
+    }
+
+    return available;
+}
@@ -0,0 +1,950 @@
+/**
+ * @file  CircularBufferSpsc.c
+ * @brief Implementation of module CircularBufferSpsc.
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#define _DEFAULT_SOURCE // syscall, clock_gettime
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+#include "CircularBufferSpsc.h"
+
+#ifdef ICIRCULARBUFFERSPSC_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @def   CIRCULARBUFFERSPSC_CLOCK
+ * @brief Clock of wait deadlines, the one FUTEX_WAIT_BITSET or pthread_cond_timedwait measures against.
+ */
+#ifdef ICIRCULARBUFFERSPSC_FUTEX
+#define CIRCULARBUFFERSPSC_CLOCK CLOCK_MONOTONIC
+#else
+#define CIRCULARBUFFERSPSC_CLOCK CLOCK_REALTIME
+#endif
+
+/**
+ * @def   CIRCULARBUFFERSPSC_PUBLISH_WRITE(pCircularBuffer, index)
+ * @brief Store write index, making data before it visible to the consumer, and wake the consumer if parked.
+ *
+ * @def   CIRCULARBUFFERSPSC_PUBLISH_READ(pCircularBuffer, index)
+ * @brief Store read index, handing bytes before it back to the producer, and wake the producer if parked.
+ *
+ * Sequentially consistent with ICIRCULARBUFFERSPSC_WAIT, so that either a parking side sees the new index or we see
+ * its flag. A fence on the parking side alone can not do this, the store could still sit in our store buffer while
+ * we load the flag. Release only without waits, the flag is never checked then.
+ */
+#ifdef ICIRCULARBUFFERSPSC_WAIT
+#define CIRCULARBUFFERSPSC_PUBLISH_WRITE(pCircularBuffer, index)                         \
+    ( atomic_store_explicit( &(pCircularBuffer)->write, (index), memory_order_seq_cst ), \
+      CircularBufferSpsc_Wake( (pCircularBuffer), true ) )
+#define CIRCULARBUFFERSPSC_PUBLISH_READ(pCircularBuffer, index)                         \
+    ( atomic_store_explicit( &(pCircularBuffer)->read, (index), memory_order_seq_cst ), \
+      CircularBufferSpsc_Wake( (pCircularBuffer), false ) )
+#else
+#define CIRCULARBUFFERSPSC_PUBLISH_WRITE(pCircularBuffer, index) \
+    atomic_store_explicit( &(pCircularBuffer)->write, (index), memory_order_release )
+#define CIRCULARBUFFERSPSC_PUBLISH_READ(pCircularBuffer, index) \
+    atomic_store_explicit( &(pCircularBuffer)->read, (index), memory_order_release )
+#endif
+
+/**
+ * @def   CIRCULARBUFFERSPSC_STAMP(pCircularBuffer, end)
+ * @brief Stamp a push ending at write index end if tracing, compiled out unless ICIRCULARBUFFERSPSC_DWELL.
+ *
+ * @def   CIRCULARBUFFERSPSC_DWELL(pCircularBuffer, read, record)
+ * @brief Retire stamps of pushes popped up to read index if tracing, compiled out unless ICIRCULARBUFFERSPSC_DWELL.
+ */
+#ifdef ICIRCULARBUFFERSPSC_DWELL
+#define CIRCULARBUFFERSPSC_STAMP(pCircularBuffer, end) \
+    ( ( (pCircularBuffer)->pStamps != NULL ) ? CircularBufferSpsc_Stamp( (pCircularBuffer), (end) ) : (void)0 )
+#define CIRCULARBUFFERSPSC_DWELL(pCircularBuffer, read, record)                                                \
+    ( ( (pCircularBuffer)->pStamps != NULL ) ? CircularBufferSpsc_Dwell( (pCircularBuffer), (read), (record) ) \
+                                             : (void)0 )
+#else
+#define CIRCULARBUFFERSPSC_STAMP(pCircularBuffer, end)          ( (void)0 )
+#define CIRCULARBUFFERSPSC_DWELL(pCircularBuffer, read, record) ( (void)0 )
+#endif
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @brief     Get number of bytes readable by consumer, loading the write index only if the cached copy is short.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to use.
+ * @param     read[in]            Current read index.
+ * @param     wanted[in]          Number of bytes consumer would like to read.
+ *
+ * @return
+ *      - Number of bytes readable, may be less than actually available when wanted is satisfied.
+ */
+size_t CircularBufferSpsc_Readable( CircularBufferSpsc_t *pCircularBuffer, size_t read, size_t wanted );
+
+/**
+ * @brief     Get number of bytes writable by producer, loading the read index only if the cached copy is short.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to use.
+ * @param     write[in]           Current write index.
+ * @param     wanted[in]          Number of bytes producer would like to write.
+ *
+ * @return
+ *      - Number of bytes writable, may be less than actually free when wanted is satisfied.
+ */
+size_t CircularBufferSpsc_Writable( CircularBufferSpsc_t *pCircularBuffer, size_t write, size_t wanted );
+
+/**
+ * @brief     Copy data into buffer memory at index, wrapping around the end of the buffer memory.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to use.
+ * @param     index[in]           Free-running index to start writing at.
+ * @param     pData[in]           Where data is to be copied from.
+ * @param     count[in]           Number of bytes to copy.
+ */
+void CircularBufferSpsc_CopyIn( CircularBufferSpsc_t *pCircularBuffer, size_t index, uint8_t const *pData, size_t count );
+
+/**
+ * @brief     Copy data out of buffer memory from index, wrapping around the end of the buffer memory.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to use.
+ * @param     index[in]           Free-running index to start reading at.
+ * @param     pData[out]          Where data is to be copied to.
+ * @param     count[in]           Number of bytes to copy.
+ */
+void CircularBufferSpsc_CopyOut( CircularBufferSpsc_t *pCircularBuffer, size_t index, uint8_t *pData, size_t count );
+
+#ifdef ICIRCULARBUFFERSPSC_WAIT
+/**
+ * @brief     Check if one side would still block, loading the other side's index.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to use.
+ * @param     consumer[in]        true for consumer (buffer empty), false for producer (buffer full).
+ *
+ * @return
+ *      - true:  Side would block.
+ *      - false: Side can make progress.
+ */
+bool CircularBufferSpsc_Blocked( CircularBufferSpsc_t *pCircularBuffer, bool consumer );
+
+/**
+ * @brief     Park one side until woken by the other side or the deadline passes.
+ *
+ * @attention May return early without being woken, caller has to check the buffer again.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to use.
+ * @param     consumer[in]        true to park consumer, false to park producer.
+ * @param     pDeadline[in]       Absolute deadline on CIRCULARBUFFERSPSC_CLOCK, NULL to wait forever.
+ *
+ * @return
+ *      - true:  Woken or no longer blocked.
+ *      - false: Deadline passed.
+ */
+bool CircularBufferSpsc_Park( CircularBufferSpsc_t *pCircularBuffer, bool consumer, struct timespec const *pDeadline );
+
+/**
+ * @brief     Wake one side if it is parked.
+ *
+ * @attention Must follow a sequentially consistent store of the index that unblocks the parked side, see
+ *            CIRCULARBUFFERSPSC_PUBLISH_WRITE.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to use.
+ * @param     consumer[in]        true to wake consumer, false to wake producer.
+ */
+void CircularBufferSpsc_Wake( CircularBufferSpsc_t *pCircularBuffer, bool consumer );
+
+/**
+ * @brief     Get absolute deadline from now.
+ *
+ * @param     pDeadline[out]      Deadline on CIRCULARBUFFERSPSC_CLOCK.
+ * @param     timeoutMs[in]       Milliseconds from now.
+ */
+void CircularBufferSpsc_Deadline( struct timespec *pDeadline, int timeoutMs );
+
+/**
+ * @brief     Tell the CPU we are busy waiting.
+ */
+void CircularBufferSpsc_Relax( void );
+
+#endif
+
+#ifdef ICIRCULARBUFFERSPSC_DWELL
+/**
+ * @brief     Stamp a push with the current time, unless all stamps are in use. Producer only, dwell tracing only.
+ *
+ * @attention Must come before the store of the write index that publishes the push.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to use.
+ * @param     end[in]             Write index after the push.
+ */
+void CircularBufferSpsc_Stamp( CircularBufferSpsc_t *pCircularBuffer, size_t end );
+
+/**
+ * @brief     Retire stamps of pushes popped up to read index, recording their dwell times. Consumer only, dwell
+ *            tracing only.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to use.
+ * @param     read[in]            Read index after the pop.
+ * @param     record[in]          Record dwell times, false to drop the stamps of cleared data.
+ */
+void CircularBufferSpsc_Dwell( CircularBufferSpsc_t *pCircularBuffer, size_t read, bool record );
+
+/**
+ * @brief     Get current time for dwell tracing.
+ *
+ * @return
+ *      - CLOCK_MONOTONIC time in ns.
+ */
+uint64_t CircularBufferSpsc_Now( void );
+#endif
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Variables
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Interface functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferSpsc_Init( CircularBufferSpsc_t *pCircularBuffer, uint8_t *pBuffer, size_t bufferSize )
+{
+    if ( pCircularBuffer == NULL || pBuffer == NULL )
+    {
+        // NULL pointers not accepted
+        return false;
+    }
+
+    if ( bufferSize < 2 || ( ( bufferSize & ~( bufferSize - 1 ) ) != bufferSize ) )
+    {
+        // bufferSize is 0 or not power of 2
+        return false;
+    }
+
+    pCircularBuffer->bufferSize = bufferSize;
+    pCircularBuffer->pBuffer    = pBuffer;
+    pCircularBuffer->readCache  = 0;
+    pCircularBuffer->writeCache = 0;
+    pCircularBuffer->batchWrite = 0;
+    atomic_init( &pCircularBuffer->write,           0 );
+    atomic_init( &pCircularBuffer->read,            0 );
+#ifdef ICIRCULARBUFFERSPSC_DWELL
+    atomic_init( &pCircularBuffer->stampWrite,      0 );
+    atomic_init( &pCircularBuffer->stampRead,       0 );
+    pCircularBuffer->stampReadCache = 0;
+    pCircularBuffer->pStamps        = NULL;
+    pCircularBuffer->stampCount     = 0;
+    pCircularBuffer->pLatency       = NULL;
+#endif
+
+#ifdef ICIRCULARBUFFERSPSC_WAIT
+    atomic_init( &pCircularBuffer->consumerWaiting, 0 );
+    atomic_init( &pCircularBuffer->producerWaiting, 0 );
+#endif
+#if defined( ICIRCULARBUFFERSPSC_WAIT ) && !defined( ICIRCULARBUFFERSPSC_FUTEX )
+    if (
+        ( pthread_mutex_init( &pCircularBuffer->mutex,        NULL ) != 0 ) ||
+        ( pthread_cond_init(  &pCircularBuffer->consumerCond, NULL ) != 0 ) ||
+        ( pthread_cond_init(  &pCircularBuffer->producerCond, NULL ) != 0 )
+    )
+    {
+        return false;
+    }
+#endif
+
+    return true;
+}
+
+#ifdef ICIRCULARBUFFERSPSC_DWELL
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferSpsc_TraceDwell( CircularBufferSpsc_t *pCircularBuffer, CircularBufferSpscStamp_t *pStamps,
+                                     size_t stampCount, CircularBufferLatency_t *pLatency )
+{
+    if ( pCircularBuffer == NULL || pStamps == NULL || pLatency == NULL )
+    {
+        return false;
+    }
+
+    if ( stampCount == 0 || ( stampCount & ( stampCount - 1 ) ) != 0 )
+    {
+        // stampCount is 0 or not power of 2
+        return false;
+    }
+
+    // Only pushes from here on are stamped, data already queued is not measured
+    pCircularBuffer->pStamps        = pStamps;
+    pCircularBuffer->stampCount     = stampCount;
+    pCircularBuffer->pLatency       = pLatency;
+    pCircularBuffer->stampReadCache = 0;
+    atomic_store_explicit( &pCircularBuffer->stampWrite, 0, memory_order_relaxed );
+    atomic_store_explicit( &pCircularBuffer->stampRead,  0, memory_order_relaxed );
+
+    return true;
+}
+#endif
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferSpsc_GetCount( CircularBufferSpsc_t *pCircularBuffer )
+{
+    if ( pCircularBuffer == NULL )
+    {
+        return 0;
+    }
+
+    // Load read first, write can only move away from it, so the difference never goes negative
+    size_t read  = atomic_load_explicit( &pCircularBuffer->read,  memory_order_acquire );
+    size_t write = atomic_load_explicit( &pCircularBuffer->write, memory_order_acquire );
+
+    return ( write - read );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferSpsc_Peek( CircularBufferSpsc_t *pCircularBuffer, uint8_t const **ppData )
+{
+    if ( pCircularBuffer == NULL || ppData == NULL )
+    {
+        return 0;
+    }
+
+    // Consumer owns read index, acquire on write index makes the producers data visible
+    size_t read       = atomic_load_explicit( &pCircularBuffer->read, memory_order_relaxed );
+    size_t offset     = ( read & ( pCircularBuffer->bufferSize - 1 ) );
+    size_t bytesToEnd = ( pCircularBuffer->bufferSize - offset );
+    size_t count      = CircularBufferSpsc_Readable( pCircularBuffer, read, bytesToEnd );
+    if ( count > bytesToEnd )
+    {
+        count = bytesToEnd;
+    }
+
+    if ( count > 0 )
+    {
+        *ppData = ( pCircularBuffer->pBuffer + offset );
+    }
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferSpsc_Pop( CircularBufferSpsc_t *pCircularBuffer, uint8_t *pData, size_t count )
+{
+    if ( pCircularBuffer == NULL || pData == NULL )
+    {
+        return 0;
+    }
+
+    size_t read      = atomic_load_explicit( &pCircularBuffer->read, memory_order_relaxed );
+    size_t available = CircularBufferSpsc_Readable( pCircularBuffer, read, count );
+    if ( count > available )
+    {
+        count = available;
+    }
+
+    if ( count > 0 )
+    {
+        CircularBufferSpsc_CopyOut( pCircularBuffer, read, pData, count );
+
+        // Release hands the slots back to the producer only after data has been copied out
+        CIRCULARBUFFERSPSC_PUBLISH_READ( pCircularBuffer, read + count );
+        CIRCULARBUFFERSPSC_DWELL( pCircularBuffer, read + count, true );
+    }
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferSpsc_Push( CircularBufferSpsc_t *pCircularBuffer, uint8_t const *pData, size_t count )
+{
+    if ( pCircularBuffer == NULL || pData == NULL )
+    {
+        return 0;
+    }
+
+    // Producer owns write index
+    size_t write     = atomic_load_explicit( &pCircularBuffer->write, memory_order_relaxed );
+    size_t available = CircularBufferSpsc_Writable( pCircularBuffer, write, count );
+    if ( count > available )
+    {
+        count = available;
+    }
+
+    if ( count > 0 )
+    {
+        CircularBufferSpsc_CopyIn( pCircularBuffer, write, pData, count );
+        pCircularBuffer->batchWrite = write + count;
+        CIRCULARBUFFERSPSC_STAMP( pCircularBuffer, write + count );
+
+        // Release publishes the data before the consumer can observe the new write index
+        CIRCULARBUFFERSPSC_PUBLISH_WRITE( pCircularBuffer, write + count );
+    }
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferSpsc_BeginBatch( CircularBufferSpsc_t *pCircularBuffer )
+{
+    if ( pCircularBuffer == NULL )
+    {
+        return false;
+    }
+
+    pCircularBuffer->batchWrite = atomic_load_explicit( &pCircularBuffer->write, memory_order_relaxed );
+
+    return true;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferSpsc_PushDeferred( CircularBufferSpsc_t *pCircularBuffer, uint8_t const *pData, size_t count )
+{
+    if ( pCircularBuffer == NULL || pData == NULL )
+    {
+        return 0;
+    }
+
+    // Whole messages only, a batch is published as a unit so a partial one could never be completed
+    size_t write = pCircularBuffer->batchWrite;
+    if ( count == 0 || CircularBufferSpsc_Writable( pCircularBuffer, write, count ) < count )
+    {
+        return 0;
+    }
+
+    CircularBufferSpsc_CopyIn( pCircularBuffer, write, pData, count );
+    pCircularBuffer->batchWrite = write + count;
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferSpsc_PublishBatch( CircularBufferSpsc_t *pCircularBuffer )
+{
+    if ( pCircularBuffer == NULL )
+    {
+        return 0;
+    }
+
+    size_t write = atomic_load_explicit( &pCircularBuffer->write, memory_order_relaxed );
+    size_t count = ( pCircularBuffer->batchWrite - write );
+    if ( count > 0 )
+    {
+        // A batch is stamped as one push, at the time it becomes visible
+        CIRCULARBUFFERSPSC_STAMP( pCircularBuffer, pCircularBuffer->batchWrite );
+
+        // Same store as a plain push, once for the whole batch
+        CIRCULARBUFFERSPSC_PUBLISH_WRITE( pCircularBuffer, pCircularBuffer->batchWrite );
+    }
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferSpsc_PopBatch( CircularBufferSpsc_t *pCircularBuffer, uint8_t *pData, size_t itemSize,
+                                     size_t maxItems )
+{
+    if ( pCircularBuffer == NULL || pData == NULL || itemSize == 0 )
+    {
+        return 0;
+    }
+
+    if ( maxItems > ( pCircularBuffer->bufferSize / itemSize ) )
+    {
+        // Never more than fits, also keeps the byte count below from overflowing
+        maxItems = ( pCircularBuffer->bufferSize / itemSize );
+    }
+
+    size_t read  = atomic_load_explicit( &pCircularBuffer->read, memory_order_relaxed );
+    size_t items = CircularBufferSpsc_Readable( pCircularBuffer, read, maxItems * itemSize ) / itemSize;
+    if ( items > maxItems )
+    {
+        items = maxItems;
+    }
+
+    if ( items > 0 )
+    {
+        CircularBufferSpsc_CopyOut( pCircularBuffer, read, pData, items * itemSize );
+
+        // One store retires the whole batch, see ICircularBufferSpsc_Pop
+        CIRCULARBUFFERSPSC_PUBLISH_READ( pCircularBuffer, read + ( items * itemSize ) );
+        CIRCULARBUFFERSPSC_DWELL( pCircularBuffer, read + ( items * itemSize ), true );
+    }
+
+    return items;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferSpsc_PopWait( CircularBufferSpsc_t *pCircularBuffer, uint8_t *pData, size_t count, int timeoutMs )
+{
+#ifdef ICIRCULARBUFFERSPSC_WAIT
+    struct timespec deadline;
+    bool            hasDeadline = false;
+
+    // Only WAIT_FOREVER waits without a deadline, any other negative timeout does not wait at all
+    if ( timeoutMs < 0 && timeoutMs != ICIRCULARBUFFERSPSC_WAIT_FOREVER )
+    {
+        timeoutMs = 0;
+    }
+
+    for ( size_t spins = 0; ; ++spins )
+    {
+        size_t popped = ICircularBufferSpsc_Pop( pCircularBuffer, pData, count );
+        if ( popped > 0 || count == 0 || timeoutMs == 0 || pCircularBuffer == NULL || pData == NULL )
+        {
+            return popped;
+        }
+
+        if ( spins < ICIRCULARBUFFERSPSC_WAIT_SPINS )
+        {
+            CircularBufferSpsc_Relax();
+            continue;
+        }
+
+        // Clock is only read once we are about to park, so a call that finds data never touches it
+        if ( timeoutMs > 0 && !hasDeadline )
+        {
+            CircularBufferSpsc_Deadline( &deadline, timeoutMs );
+            hasDeadline = true;
+        }
+
+        if ( !CircularBufferSpsc_Park( pCircularBuffer, true, hasDeadline ? &deadline : NULL ) )
+        {
+            return ICircularBufferSpsc_Pop( pCircularBuffer, pData, count );
+        }
+    }
+#else
+    (void)pCircularBuffer;
+    (void)pData;
+    (void)count;
+    (void)timeoutMs;
+    return 0;
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t ICircularBufferSpsc_PushWait( CircularBufferSpsc_t *pCircularBuffer, uint8_t const *pData, size_t count,
+                                     int timeoutMs )
+{
+#ifdef ICIRCULARBUFFERSPSC_WAIT
+    struct timespec deadline;
+    bool            hasDeadline = false;
+
+    // Only WAIT_FOREVER waits without a deadline, any other negative timeout does not wait at all
+    if ( timeoutMs < 0 && timeoutMs != ICIRCULARBUFFERSPSC_WAIT_FOREVER )
+    {
+        timeoutMs = 0;
+    }
+
+    for ( size_t spins = 0; ; ++spins )
+    {
+        size_t pushed = ICircularBufferSpsc_Push( pCircularBuffer, pData, count );
+        if ( pushed > 0 || count == 0 || timeoutMs == 0 || pCircularBuffer == NULL || pData == NULL )
+        {
+            return pushed;
+        }
+
+        if ( spins < ICIRCULARBUFFERSPSC_WAIT_SPINS )
+        {
+            CircularBufferSpsc_Relax();
+            continue;
+        }
+
+        // Clock is only read once we are about to park, so a call that finds space never touches it
+        if ( timeoutMs > 0 && !hasDeadline )
+        {
+            CircularBufferSpsc_Deadline( &deadline, timeoutMs );
+            hasDeadline = true;
+        }
+
+        if ( !CircularBufferSpsc_Park( pCircularBuffer, false, hasDeadline ? &deadline : NULL ) )
+        {
+            return ICircularBufferSpsc_Push( pCircularBuffer, pData, count );
+        }
+    }
+#else
+    (void)pCircularBuffer;
+    (void)pData;
+    (void)count;
+    (void)timeoutMs;
+    return 0;
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool ICircularBufferSpsc_Clear( CircularBufferSpsc_t *pCircularBuffer )
+{
+    if ( pCircularBuffer == NULL )
+    {
+        return false;
+    }
+
+    // Only the read index is moved, so clearing stays on the consumer side
+    size_t write = atomic_load_explicit( &pCircularBuffer->write, memory_order_acquire );
+    pCircularBuffer->writeCache = write;
+    CIRCULARBUFFERSPSC_PUBLISH_READ( pCircularBuffer, write );
+    CIRCULARBUFFERSPSC_DWELL( pCircularBuffer, write, false );
+
+    return true;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Private functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t CircularBufferSpsc_Readable( CircularBufferSpsc_t *pCircularBuffer, size_t read, size_t wanted )
+{
+    size_t available = ( pCircularBuffer->writeCache - read );
+    if ( available < wanted )
+    {
+        // Looks too empty, acquire on write index makes the producers data visible
+        pCircularBuffer->writeCache = atomic_load_explicit( &pCircularBuffer->write, memory_order_acquire );
+        available                   = ( pCircularBuffer->writeCache - read );
+    }
+
+    return available;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+size_t CircularBufferSpsc_Writable( CircularBufferSpsc_t *pCircularBuffer, size_t write, size_t wanted )
+{
+    size_t available = ( pCircularBuffer->bufferSize - ( write - pCircularBuffer->readCache ) );
+    if ( available < wanted )
+    {
+        // Looks too full, acquire on read index makes sure consumer is done with the freed bytes
+        pCircularBuffer->readCache = atomic_load_explicit( &pCircularBuffer->read, memory_order_acquire );
+        available                  = ( pCircularBuffer->bufferSize - ( write - pCircularBuffer->readCache ) );
+    }
+
+    return available;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void CircularBufferSpsc_CopyIn( CircularBufferSpsc_t *pCircularBuffer, size_t index, uint8_t const *pData, size_t count )
+{
+    size_t offset = ( index & ( pCircularBuffer->bufferSize - 1 ) );
+    size_t first  = ( pCircularBuffer->bufferSize - offset );
+    if ( first > count )
+    {
+        first = count;
+    }
+
+    memcpy( pCircularBuffer->pBuffer + offset, pData, first );
+    memcpy( pCircularBuffer->pBuffer, pData + first, count - first );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void CircularBufferSpsc_CopyOut( CircularBufferSpsc_t *pCircularBuffer, size_t index, uint8_t *pData, size_t count )
+{
+    size_t offset = ( index & ( pCircularBuffer->bufferSize - 1 ) );
+    size_t first  = ( pCircularBuffer->bufferSize - offset );
+    if ( first > count )
+    {
+        first = count;
+    }
+
+    memcpy( pData, pCircularBuffer->pBuffer + offset, first );
+    memcpy( pData + first, pCircularBuffer->pBuffer, count - first );
+}
+
+#ifdef ICIRCULARBUFFERSPSC_WAIT
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool CircularBufferSpsc_Blocked( CircularBufferSpsc_t *pCircularBuffer, bool consumer )
+{
+    // Sequentially consistent load pairs with the store of the waiting flag before it
+    if ( consumer )
+    {
+        size_t read = atomic_load_explicit( &pCircularBuffer->read, memory_order_relaxed );
+        return ( atomic_load_explicit( &pCircularBuffer->write, memory_order_seq_cst ) == read );
+    }
+
+    size_t write = atomic_load_explicit( &pCircularBuffer->write, memory_order_relaxed );
+    return ( ( write - atomic_load_explicit( &pCircularBuffer->read, memory_order_seq_cst ) ) == pCircularBuffer->bufferSize );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+bool CircularBufferSpsc_Park( CircularBufferSpsc_t *pCircularBuffer, bool consumer, struct timespec const *pDeadline )
+{
+    atomic_uint *pWaiting = consumer ? &pCircularBuffer->consumerWaiting : &pCircularBuffer->producerWaiting;
+    bool        woken     = true;
+
+#ifdef ICIRCULARBUFFERSPSC_FUTEX
+    // Raise flag, then check again. The other side stores its index and then checks the flag, so one of us sees the
+    // other and a wakeup can never be lost
+    atomic_store_explicit( pWaiting, 1, memory_order_seq_cst );
+    if ( CircularBufferSpsc_Blocked( pCircularBuffer, consumer ) )
+    {
+        // Sleeps only while flag is still raised, waker clears it before waking. Bitset variant takes an absolute
+        // deadline on CLOCK_MONOTONIC
+        if (
+            ( syscall( SYS_futex, pWaiting, FUTEX_WAIT_BITSET_PRIVATE, 1, pDeadline, NULL, FUTEX_BITSET_MATCH_ANY ) != 0 ) &&
+            ( errno == ETIMEDOUT )
+        )
+        {
+            woken = false;
+        }
+    }
+    atomic_store_explicit( pWaiting, 0, memory_order_relaxed );
+#else
+    pthread_cond_t *pCond = consumer ? &pCircularBuffer->consumerCond : &pCircularBuffer->producerCond;
+
+    // Flag is raised and checked with the mutex held, waker takes the mutex before signalling
+    pthread_mutex_lock( &pCircularBuffer->mutex );
+    atomic_store_explicit( pWaiting, 1, memory_order_seq_cst );
+    if ( CircularBufferSpsc_Blocked( pCircularBuffer, consumer ) )
+    {
+        int result = ( pDeadline != NULL ) ? pthread_cond_timedwait( pCond, &pCircularBuffer->mutex, pDeadline )
+                                           : pthread_cond_wait( pCond, &pCircularBuffer->mutex );
+        woken = ( result != ETIMEDOUT );
+    }
+    atomic_store_explicit( pWaiting, 0, memory_order_relaxed );
+    pthread_mutex_unlock( &pCircularBuffer->mutex );
+#endif
+
+    return woken;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void CircularBufferSpsc_Wake( CircularBufferSpsc_t *pCircularBuffer, bool consumer )
+{
+    atomic_uint *pWaiting = consumer ? &pCircularBuffer->consumerWaiting : &pCircularBuffer->producerWaiting;
+
+    // Flag lives on the caller's own cache line, so this is a plain load when nobody is parked
+    if ( atomic_load_explicit( pWaiting, memory_order_seq_cst ) == 0 )
+    {
+        return;
+    }
+
+#ifdef ICIRCULARBUFFERSPSC_FUTEX
+    if ( atomic_exchange_explicit( pWaiting, 0, memory_order_relaxed ) != 0 )
+    {
+        syscall( SYS_futex, pWaiting, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0 );
+    }
+#else
+    pthread_mutex_lock( &pCircularBuffer->mutex );
+    pthread_cond_signal( consumer ? &pCircularBuffer->consumerCond : &pCircularBuffer->producerCond );
+    pthread_mutex_unlock( &pCircularBuffer->mutex );
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void CircularBufferSpsc_Deadline( struct timespec *pDeadline, int timeoutMs )
+{
+    clock_gettime( CIRCULARBUFFERSPSC_CLOCK, pDeadline );
+
+    pDeadline->tv_sec  += ( timeoutMs / 1000 );
+    pDeadline->tv_nsec += ( ( timeoutMs % 1000 ) * 1000000L );
+    if ( pDeadline->tv_nsec >= 1000000000L )
+    {
+        pDeadline->tv_sec  += 1;
+        pDeadline->tv_nsec -= 1000000000L;
+    }
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void CircularBufferSpsc_Relax( void )
+{
+#if defined( __x86_64__ ) || defined( __i386__ )
+    __builtin_ia32_pause();
+#elif defined( __aarch64__ )
+    __asm__ volatile( "yield" );
+#endif
+}
+#endif
+
+#ifdef ICIRCULARBUFFERSPSC_DWELL
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void CircularBufferSpsc_Stamp( CircularBufferSpsc_t *pCircularBuffer, size_t end )
+{
+    size_t stampWrite = atomic_load_explicit( &pCircularBuffer->stampWrite, memory_order_relaxed );
+    if ( ( stampWrite - pCircularBuffer->stampReadCache ) >= pCircularBuffer->stampCount )
+    {
+        // Acquire pairs with the release in dwell, the consumer is done with a stamp before we reuse it
+        pCircularBuffer->stampReadCache = atomic_load_explicit( &pCircularBuffer->stampRead, memory_order_acquire );
+        if ( ( stampWrite - pCircularBuffer->stampReadCache ) >= pCircularBuffer->stampCount )
+        {
+            return;
+        }
+    }
+
+    CircularBufferSpscStamp_t *pStamp =
+        &pCircularBuffer->pStamps[ stampWrite & ( pCircularBuffer->stampCount - 1 ) ];
+    pStamp->end  = end;
+    pStamp->time = CircularBufferSpsc_Now();
+
+    // Release publishes the stamp, the consumer only looks at stamps below this index
+    atomic_store_explicit( &pCircularBuffer->stampWrite, stampWrite + 1, memory_order_release );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void CircularBufferSpsc_Dwell( CircularBufferSpsc_t *pCircularBuffer, size_t read, bool record )
+{
+    size_t   stampRead  = atomic_load_explicit( &pCircularBuffer->stampRead,  memory_order_relaxed );
+    size_t   stampWrite = atomic_load_explicit( &pCircularBuffer->stampWrite, memory_order_acquire );
+    size_t   retired    = stampRead;
+    uint64_t now        = 0;
+
+    // Stamps are in push order, stop at the first push with data left, its end is within a buffer ahead of read
+    for ( ; retired != stampWrite; ++retired )
+    {
+        CircularBufferSpscStamp_t const *pStamp =
+            &pCircularBuffer->pStamps[ retired & ( pCircularBuffer->stampCount - 1 ) ];
+        if ( ( pStamp->end - read - 1 ) < pCircularBuffer->bufferSize )
+        {
+            break;
+        }
+
+        if ( record )
+        {
+            // Clock is read once per pop, and only if it finished a push
+            if ( now == 0 )
+            {
+                now = CircularBufferSpsc_Now();
+            }
+            uint64_t dwell = ( now > pStamp->time ) ? ( now - pStamp->time ) : 0;
+            ICircularBufferLatency_Record( pCircularBuffer->pLatency, dwell );
+        }
+    }
+
+    if ( retired != stampRead )
+    {
+        atomic_store_explicit( &pCircularBuffer->stampRead, retired, memory_order_release );
+    }
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+uint64_t CircularBufferSpsc_Now( void )
+{
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+
+    return ( (uint64_t)now.tv_sec * 1000000000u ) + (uint64_t)now.tv_nsec;
+}
+#endif
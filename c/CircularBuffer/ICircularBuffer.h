@@ -2,6 +2,23 @@
  * @file      ICircularBuffer.h
  * @brief     Interface header for module CircularBuffer.
  *
+ * Define ICIRCULARBUFFER_STATISTICS when building (for all files including this header) to keep usage statistics in
+ * every buffer, see ICircularBuffer_GetStatistics. Without it no statistics are kept and nothing is added to the
+ * buffer struct or the push/pop paths.
+ *
+ * Define ICIRCULARBUFFER_NOTIFY when building (Linux only, for all files including this header) to let a buffer
+ * expose eventfd readiness notifications for epoll style event loops, see ICircularBuffer_OpenDataFd and
+ * ICircularBuffer_OpenSpaceFd. Each eventfd is readable exactly while its condition holds, and is only written or
+ * drained when the condition changes, so a burst of pushes costs one wakeup and no system calls after the first.
+ *
+ * Define ICIRCULARBUFFER_CRC when building (for all files including this header) to keep a running CRC32C of all data
+ * pushed or committed, see ICircularBuffer_CrcBegin and ICircularBuffer_CrcGet. Push computes it while copying the
+ * data in, with the SSE4.2 crc32 instruction where the CPU has it and a lookup table otherwise.
+ *
+ * Define ICIRCULARBUFFER_READERS when building (C11, for all files including this header) to let threads other than
+ * the producer read an overwrite mode buffer, see ICircularBuffer_ReadAt. Without it the module is plain C99 and
+ * overwriting push publishes nothing for other threads.
+ *
  * @version   0.0.1
  * @date      2019
  *
@@ -18,6 +35,9 @@
  * ---------------------------------------------------------------------------------------------------------------------
  */
 
+#ifdef ICIRCULARBUFFER_READERS
+#include <stdatomic.h>
+#endif
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -28,24 +48,103 @@
  * ---------------------------------------------------------------------------------------------------------------------
  */
 
+/**
+ * @def   ICIRCULARBUFFER_SEGMENT_COUNT
+ * @brief Maximum number of segments needed to cover any range of buffer memory (before and after wraparound).
+ */
+#define ICIRCULARBUFFER_SEGMENT_COUNT 2
+
+/**
+ * @def   ICIRCULARBUFFER_OCCUPANCY_BINS
+ * @brief Number of bins in occupancy histogram. Bin 0 counts an empty buffer, bin n counts 2^(n-1) to 2^n - 1 bytes.
+ */
+#define ICIRCULARBUFFER_OCCUPANCY_BINS ( ( sizeof( size_t ) * 8 ) + 1 )
+
 /**
  * ---------------------------------------------------------------------------------------------------------------------
  * Types
  * ---------------------------------------------------------------------------------------------------------------------
  */
 
+/**
+ * Usage statistics of a circular buffer
+ */
+typedef struct CircularBufferStatistics
+{
+    size_t   highWaterMark;                                 /**< Most bytes in buffer at any time.            */
+    uint64_t bytesPushed;                                   /**< Total bytes pushed or committed.             */
+    uint64_t bytesPopped;                                   /**< Total bytes popped or released.              */
+    uint64_t shortPushes;                                   /**< Pushes/commits that did not fit completely.  */
+    uint64_t emptyPops;                                     /**< Pops/releases on an empty buffer.            */
+    uint64_t occupancy[ ICIRCULARBUFFER_OCCUPANCY_BINS ];   /**< Bytes in buffer after every push/pop, log2.  */
+} CircularBufferStatistics_t;
+
+/**
+ * Source of buffer memory for growable buffers, to plug in pools instead of malloc/free
+ */
+typedef struct CircularBufferAllocator
+{
+    void *( *pAllocate )( size_t size, void *pContext );            /**< Get size bytes, NULL if out of memory.      */
+    void ( *pFree )( void *pMemory, size_t size, void *pContext );  /**< Give back memory got from pAllocate.        */
+    void *pContext;                                                 /**< Passed to pAllocate and pFree.              */
+} CircularBufferAllocator_t;
+
+/**
+ * Growth policy of growable buffers, may be shared by any number of buffers
+ */
+typedef struct CircularBufferGrowth
+{
+    size_t                    minSize;       /**< Size buffer starts at and never shrinks below, power of 2.         */
+    size_t                    maxSize;       /**< Size buffer never grows above, power of 2.                         */
+    unsigned                  highWatermark; /**< Grow when data would fill more than this percent, 1 to 100.        */
+    unsigned                  lowWatermark;  /**< Shrink when data fills less than this percent, 0 for never.        */
+    CircularBufferAllocator_t allocator;     /**< Where buffer memory comes from, malloc/free if pAllocate is NULL.  */
+} CircularBufferGrowth_t;
+
 /**
  * Circular buffer
  * @warning Never access any members of the struct, for internal use only.
  */
 typedef struct CircularBuffer
 {
-    uint8_t *pWrite;    /**< Pointer to where in buffer writer should write to.  */
-    uint8_t *pRead;     /**< Pointer to where in buffer reader should read from. */
-    uint8_t *pBuffer;   /**< Pointer to allocated buffer.                        */
-    size_t  bufferSize; /**< Size of buffer.                                     */
+    uint64_t                   write;          /**< Free-running write position, masked with bufferSize - 1 to index buffer.  */
+    uint64_t                   read;           /**< Free-running read position, masked with bufferSize - 1 to index buffer.   */
+    uint8_t                    *pBuffer;       /**< Pointer to allocated buffer.                                              */
+    size_t                     bufferSize;     /**< Size of buffer.                                                           */
+    bool                       mirrored;       /**< Buffer memory is mapped twice, back to back.                              */
+    bool                       overwrite;      /**< Push overwrites oldest data instead of returning short.                   */
+    uint64_t                   overwritten;    /**< Overwrite mode: total bytes dropped to make room for pushed data.         */
+    CircularBufferGrowth_t const *pGrowth;     /**< Growable mode: growth policy, NULL for fixed size.                        */
+    size_t                     bulkThreshold;  /**< Copies of at least this many bytes bypass the cache, 0 for never.         */
+#ifdef ICIRCULARBUFFER_READERS
+    atomic_uint_least64_t      claimed;        /**< Overwrite mode: end of range being written, stored before copying.        */
+    atomic_uint_least64_t      published;      /**< Overwrite mode: write position visible to concurrent readers.             */
+#endif
+#ifdef ICIRCULARBUFFER_STATISTICS
+    CircularBufferStatistics_t statistics;     /**< Usage statistics since init or last reset.                                */
+#endif
+#ifdef ICIRCULARBUFFER_NOTIFY
+    int                        dataFd;         /**< Eventfd readable while buffer holds data, -1 if not opened.               */
+    int                        spaceFd;        /**< Eventfd readable while free space >= spaceThreshold, -1 if not opened.    */
+    size_t                     spaceThreshold; /**< Free space at which spaceFd becomes readable.                             */
+    bool                       dataSignalled;  /**< dataFd currently holds a count.                                           */
+    bool                       spaceSignalled; /**< spaceFd currently holds a count.                                          */
+#endif
+#ifdef ICIRCULARBUFFER_CRC
+    uint32_t                   crc;            /**< Running CRC32C register, not inverted, of data since crcStart.            */
+    uint64_t                   crcStart;       /**< Write position checksum range starts at.                                  */
+#endif
 } CircularBuffer_t;
 
+/**
+ * Segment of buffer memory, iovec-style
+ */
+typedef struct CircularBufferSegment
+{
+    uint8_t *pData; /**< Pointer to start of segment.   */
+    size_t  size;   /**< Number of bytes in segment.    */
+} CircularBufferSegment_t;
+
 /**
  * ---------------------------------------------------------------------------------------------------------------------
  * Prototypes
@@ -67,6 +166,94 @@ typedef struct CircularBuffer
  */
 bool ICircularBuffer_Init( CircularBuffer_t *pCircularBuffer, uint8_t *pBuffer, size_t bufferSize );
 
+/**
+ * @brief     Initialize a circular buffer in overwrite mode, where push drops the oldest data instead of returning
+ *            short (for trace and telemetry data).
+ *
+ * @attention Buffer size is only valid if a power of 2 (64, 128, 256, 512, 1024, etc.).
+ * @attention Pop, Peek and Release still work but move the read position, so they must run on the producer thread.
+ *            A reader on another thread uses ICircularBuffer_ReadAt with its own position instead, if built with
+ *            ICIRCULARBUFFER_READERS.
+ * @attention Reserve and Commit never overwrite, they only use free space.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to initialize.
+ * @param     pBuffer[in]         Pointer to allocated data buffer.
+ * @param     bufferSize[in]      Size of allocated data buffer.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool ICircularBuffer_InitOverwrite( CircularBuffer_t *pCircularBuffer, uint8_t *pBuffer, size_t bufferSize );
+
+/**
+ * @brief     Initialize a growable circular buffer, which owns its buffer memory and resizes it with the amount of data.
+ *
+ * Push and Reserve double the buffer memory (up to maxSize) before data would fill more than highWatermark percent
+ * of it. Pop, Release and Clear halve it (down to minSize) when data fills less than lowWatermark percent. A resize
+ * copies the data once, to the start of the new memory, so it costs at most one copy of what is in the buffer.
+ *
+ * @attention Watermarks are only valid if 2 * lowWatermark < highWatermark <= 100, so a halved buffer is not grown
+ *            straight back. The policy is not copied and must stay valid until ICircularBuffer_DeinitGrowable.
+ * @attention A resize moves the data, pointers from Peek, PeekV, Find, Reserve and ReserveV are only valid until the
+ *            next Push, Pop, Reserve, Release or Clear.
+ * @attention Allocation failure is not an error, the buffer keeps its size and push returns short as usual.
+ * @attention A space threshold set with ICircularBuffer_OpenSpaceFd is lowered to the buffer size when it shrinks
+ *            below it, it is not raised again on growth.
+ * @attention Records (ICircularBufferRecord) can not be pushed to a growable buffer.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to initialize.
+ * @param     pGrowth[in]         Growth policy to use.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed, bad policy or out of memory.
+ */
+bool ICircularBuffer_InitGrowable( CircularBuffer_t *pCircularBuffer, CircularBufferGrowth_t const *pGrowth );
+
+/**
+ * @brief     Free buffer memory of a growable circular buffer.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to deinitialize.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed, or not a growable buffer.
+ */
+bool ICircularBuffer_DeinitGrowable( CircularBuffer_t *pCircularBuffer );
+
+/**
+ * @brief     Set size from which push and pop copy data with non-temporal (streaming) stores, prefetching the source
+ *            ahead, instead of memcpy. Disabled (0) after init.
+ *
+ * Meant for large transfers through large buffers, megabytes that would otherwise evict everything else from the
+ * caches on the way through. A threshold around the size of the last level cache share of the calling core is a sane
+ * start; below it memcpy is faster, as the copied data is likely to be read again while still cached.
+ *
+ * @attention Set right after init, before the buffer is used. Applies per contiguous copy, so the part of a push or
+ *            pop on either side of the end of buffer memory is measured on its own.
+ * @attention Data popped this way is not in cache afterwards, the first read of it goes to memory.
+ * @attention Without SSE2 the streaming copy falls back to memcpy, the threshold then has no effect.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     threshold[in]       Copy size in bytes from which to stream, 0 to always use memcpy.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool ICircularBuffer_SetBulkThreshold( CircularBuffer_t *pCircularBuffer, size_t threshold );
+
+/**
+ * @brief     Get current size of buffer memory, which changes over time for a growable buffer.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ *
+ * @return
+ *      - Size of buffer memory.
+ */
+size_t ICircularBuffer_GetSize( CircularBuffer_t *pCircularBuffer );
+
 /**
  * @brief     Get number of bytes available to read from buffer.
  *
@@ -91,6 +278,53 @@ size_t ICircularBuffer_GetCount( CircularBuffer_t *pCircularBuffer );
  */
 size_t ICircularBuffer_Peek( CircularBuffer_t *pCircularBuffer, uint8_t const **ppData );
 
+/**
+ * @brief     Peek at all data in buffer without removing it, as up to two segments.
+ *
+ * @attention Second segment starts at the beginning of the buffer memory and is empty unless the data wraps around.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     pSegments[out]      Array of ICIRCULARBUFFER_SEGMENT_COUNT segments to fill in.
+ *
+ * @return
+ *      - Number of bytes possible to peek at, total of all segments.
+ */
+size_t ICircularBuffer_PeekV( CircularBuffer_t *pCircularBuffer, CircularBufferSegment_t *pSegments );
+
+/**
+ * @brief     Find first occurrence of a byte in buffer, searching all data including where it wraps around.
+ *
+ * Uses AVX2 or SSE2 where the CPU has it, plain C otherwise.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     value[in]           Byte to search for.
+ * @param     from[in]            Offset from read position to start searching at, to skip data already searched.
+ * @param     pOffset[out]        Set to offset of byte from read position, as count for ICircularBuffer_Pop.
+ *
+ * @return
+ *      - true:  Found.
+ *      - false: Not found, or bad arguments.
+ */
+bool ICircularBuffer_Find( CircularBuffer_t *pCircularBuffer, uint8_t value, size_t from, size_t *pOffset );
+
+/**
+ * @brief     Find first occurrence of a byte sequence in buffer, searching all data including where it wraps around.
+ *
+ * @attention The pattern may itself be split by the wrap, it is still found.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     pPattern[in]        Bytes to search for.
+ * @param     length[in]          Number of bytes in pattern, at least 1.
+ * @param     from[in]            Offset from read position to start searching at, to skip data already searched.
+ * @param     pOffset[out]        Set to offset of first byte of pattern from read position.
+ *
+ * @return
+ *      - true:  Found.
+ *      - false: Not found, or bad arguments.
+ */
+bool ICircularBuffer_FindPattern( CircularBuffer_t *pCircularBuffer, uint8_t const *pPattern, size_t length, size_t from,
+                                  size_t *pOffset );
+
 /**
  * @brief     Pop data from circular buffer.
  *
@@ -108,6 +342,9 @@ size_t ICircularBuffer_Pop( CircularBuffer_t *pCircularBuffer, uint8_t *pData, s
 /**
  * @brief     Push data to circular buffer.
  *
+ * @attention In overwrite mode all data is always pushed, dropping the oldest data if needed (see
+ *            ICircularBuffer_GetOverwritten). If count is larger than the buffer, only the last part fits.
+ *
  * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
  * @param     pData[out]          Where data is to be copied from.
  * @param     count[in]           Number of bytes to push.
@@ -117,6 +354,90 @@ size_t ICircularBuffer_Pop( CircularBuffer_t *pCircularBuffer, uint8_t *pData, s
  */
 size_t ICircularBuffer_Push( CircularBuffer_t *pCircularBuffer, uint8_t *pData, size_t count  );
 
+/**
+ * @brief     Read data from an overwrite mode buffer at a reader-owned position, without removing it.
+ *
+ * Safe to call from another thread than the producer. Reads are validated after copying, so a reader that was lapped
+ * by the producer (even while copying) skips ahead to the oldest data still in the buffer and reports the bytes lost.
+ *
+ * @attention Only available when built with ICIRCULARBUFFER_READERS defined.
+ * @attention Start reading from position 0. The position is advanced past the data read.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     pPosition[in,out]   Free-running position of reader.
+ * @param     pData[out]          Where data is to be copied to.
+ * @param     count[in]           Number of bytes to read.
+ * @param     pLost[out]          Number of bytes overwritten before they could be read, may be NULL.
+ *
+ * @return
+ *      - Number of bytes read.
+ */
+size_t ICircularBuffer_ReadAt( CircularBuffer_t *pCircularBuffer, uint64_t *pPosition, uint8_t *pData, size_t count,
+                               uint64_t *pLost );
+
+/**
+ * @brief     Get number of bytes dropped by pushes in overwrite mode, since init or clear.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ *
+ * @return
+ *      - Total number of bytes overwritten.
+ */
+uint64_t ICircularBuffer_GetOverwritten( CircularBuffer_t *pCircularBuffer );
+
+/**
+ * @brief     Reserve space in buffer for writing directly into buffer memory.
+ *
+ * @attention Reserve does not wrap around the end of the buffer memory. It will return at most the number of bytes
+ *            until the end of the buffer memory.
+ * @attention Nothing is added to the buffer until ICircularBuffer_Commit is called.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     ppData[out]         Pointer to where to start writing.
+ * @param     count[in]           Number of bytes wanted.
+ *
+ * @return
+ *      - Number of bytes reserved, at most count.
+ */
+size_t ICircularBuffer_Reserve( CircularBuffer_t *pCircularBuffer, uint8_t **ppData, size_t count );
+
+/**
+ * @brief     Reserve space in buffer for writing directly into buffer memory, as up to two segments.
+ *
+ * @attention Second segment starts at the beginning of the buffer memory and is empty unless the space wraps around.
+ * @attention Nothing is added to the buffer until ICircularBuffer_Commit is called.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     pSegments[out]      Array of ICIRCULARBUFFER_SEGMENT_COUNT segments to fill in.
+ * @param     count[in]           Number of bytes wanted.
+ *
+ * @return
+ *      - Number of bytes reserved, total of all segments and at most count.
+ */
+size_t ICircularBuffer_ReserveV( CircularBuffer_t *pCircularBuffer, CircularBufferSegment_t *pSegments, size_t count );
+
+/**
+ * @brief     Commit bytes written directly into buffer memory, making them available for reading.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     count[in]           Number of bytes to commit.
+ *
+ * @return
+ *      - Number of bytes committed, at most the free space in buffer.
+ */
+size_t ICircularBuffer_Commit( CircularBuffer_t *pCircularBuffer, size_t count );
+
+/**
+ * @brief     Release bytes from buffer without copying them, e.g. after they were consumed through a peek.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     count[in]           Number of bytes to release.
+ *
+ * @return
+ *      - Number of bytes released, at most the number of bytes in buffer.
+ */
+size_t ICircularBuffer_Release( CircularBuffer_t *pCircularBuffer, size_t count );
+
 /**
  * @brief     Clear circular buffer.
  *
@@ -128,4 +449,104 @@ size_t ICircularBuffer_Push( CircularBuffer_t *pCircularBuffer, uint8_t *pData,
  */
 bool ICircularBuffer_Clear( CircularBuffer_t *pCircularBuffer );
 
+/**
+ * @brief     Get a snapshot of usage statistics since init or last reset.
+ *
+ * @attention Only available when built with ICIRCULARBUFFER_STATISTICS defined.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     pStatistics[out]    Where statistics are to be copied to.
+ *
+ * @return
+ *      - true:  Succesful.
+ *      - false: Failed, or statistics not built in.
+ */
+bool ICircularBuffer_GetStatistics( CircularBuffer_t *pCircularBuffer, CircularBufferStatistics_t *pStatistics );
+
+/**
+ * @brief     Reset usage statistics. High-water mark restarts from the number of bytes currently in buffer.
+ *
+ * @attention Only available when built with ICIRCULARBUFFER_STATISTICS defined.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ *
+ * @return
+ *      - true:  Succesful.
+ *      - false: Failed, or statistics not built in.
+ */
+bool ICircularBuffer_ResetStatistics( CircularBuffer_t *pCircularBuffer );
+
+/**
+ * @brief     Open an eventfd which is readable while the buffer holds any data.
+ *
+ * @attention Only available when built with ICIRCULARBUFFER_NOTIFY defined.
+ * @attention The fd is owned by the buffer, do not read from or close it. Add it to epoll (EPOLLIN), and pop until
+ *            the buffer is empty or the fd is no longer readable. Close with ICircularBuffer_CloseNotify before the
+ *            buffer is initialized again.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ *
+ * @return
+ *      - File descriptor, the same one if already open.
+ *      - -1: Failed, or notifications not built in.
+ */
+int ICircularBuffer_OpenDataFd( CircularBuffer_t *pCircularBuffer );
+
+/**
+ * @brief     Open an eventfd which is readable while the buffer has at least threshold bytes of free space.
+ *
+ * @attention Only available when built with ICIRCULARBUFFER_NOTIFY defined.
+ * @attention The fd is owned by the buffer, do not read from or close it. Calling again changes the threshold.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     threshold[in]       Free space needed for fd to be readable, 1 to buffer size.
+ *
+ * @return
+ *      - File descriptor, the same one if already open.
+ *      - -1: Failed, or notifications not built in.
+ */
+int ICircularBuffer_OpenSpaceFd( CircularBuffer_t *pCircularBuffer, size_t threshold );
+
+/**
+ * @brief     Close eventfds opened by ICircularBuffer_OpenDataFd and ICircularBuffer_OpenSpaceFd.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ *
+ * @return
+ *      - true:  Succesful.
+ *      - false: Failed, or notifications not built in.
+ */
+bool ICircularBuffer_CloseNotify( CircularBuffer_t *pCircularBuffer );
+
+/**
+ * @brief     Start a new checksum range at the current write position.
+ *
+ * @attention Only available when built with ICIRCULARBUFFER_CRC defined. Init and clear also start a new range.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ *
+ * @return
+ *      - true:  Succesful.
+ *      - false: Failed, or checksums not built in.
+ */
+bool ICircularBuffer_CrcBegin( CircularBuffer_t *pCircularBuffer );
+
+/**
+ * @brief     Get CRC32C (Castagnoli) of all data pushed or committed since the checksum range was started.
+ *
+ * @attention Only available when built with ICIRCULARBUFFER_CRC defined.
+ * @attention The range ends at the write position. Its data starts at offset GetCount - length from the read
+ *            position, as long as none of it has been popped. In overwrite mode it covers all data passed to push,
+ *            also what was dropped.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     pCrc[out]           Set to CRC32C of range, 0 for an empty range.
+ * @param     pLength[out]        Set to number of bytes in range, may be NULL.
+ *
+ * @return
+ *      - true:  Succesful.
+ *      - false: Failed, or checksums not built in.
+ */
+bool ICircularBuffer_CrcGet( CircularBuffer_t *pCircularBuffer, uint32_t *pCrc, uint64_t *pLength );
+
 #endif  // ICIRCULARBUFFER_H
\ No newline at end of file
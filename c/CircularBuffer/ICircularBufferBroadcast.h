@@ -0,0 +1,171 @@
+/**
+ * @file      ICircularBufferBroadcast.h
+ * @brief     Interface header for module CircularBufferBroadcast.
+ *
+ * Lock-free single-producer/multi-reader broadcast variant of the circular buffer (disruptor style). The producer
+ * writes every byte once and each reader walks the same data with its own read cursor, so fanning one stream out to N
+ * readers needs neither N buffers nor N copies. The producer is throttled by the slowest reader.
+ *
+ * Every reader cursor lives on its own cache line. The producer keeps a cached copy of the slowest cursor and only
+ * scans all readers again when the buffer looks full.
+ *
+ * @version   0.0.1
+ * @date      2019
+ *
+ * @author    Simon Lövgren
+ * @copyright MIT License
+ */
+
+#ifndef ICIRCULARBUFFERBROADCAST_H
+#define ICIRCULARBUFFERBROADCAST_H
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @def   ICIRCULARBUFFERBROADCAST_CACHE_LINE_SIZE
+ * @brief Size of a cache line, used to keep producer state and every reader cursor from sharing one.
+ */
+#define ICIRCULARBUFFERBROADCAST_CACHE_LINE_SIZE 64
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * Read cursor of one reader, allocated by the caller as an array of one per reader
+ * @warning Never access any members of the struct, for internal use only.
+ */
+typedef struct CircularBufferBroadcastReader
+{
+    _Alignas( ICIRCULARBUFFERBROADCAST_CACHE_LINE_SIZE )
+    atomic_size_t read;       /**< Free-running read index, only stored by this reader.  */
+    size_t        writeCache; /**< Reader's last seen write index.                       */
+} CircularBufferBroadcastReader_t;
+
+/**
+ * Single-producer/multi-reader broadcast circular buffer
+ * @warning Never access any members of the struct, for internal use only.
+ */
+typedef struct CircularBufferBroadcast
+{
+    _Alignas( ICIRCULARBUFFERBROADCAST_CACHE_LINE_SIZE )
+    atomic_size_t                   write;       /**< Free-running write index, only stored by producer.  */
+    size_t                          readCache;   /**< Producer's last seen slowest read index.            */
+    _Alignas( ICIRCULARBUFFERBROADCAST_CACHE_LINE_SIZE )
+    CircularBufferBroadcastReader_t *pReaders;   /**< Pointer to array of reader cursors.                 */
+    size_t                          readerCount; /**< Number of readers.                                  */
+    uint8_t                         *pBuffer;    /**< Pointer to allocated buffer.                        */
+    size_t                          bufferSize;  /**< Size of buffer.                                     */
+} CircularBufferBroadcast_t;
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @brief     Initialize a broadcast circular buffer.
+ *
+ * @attention Buffer size is only valid if a power of 2 (64, 128, 256, 512, 1024, etc.).
+ * @attention Must be done before the buffer is shared between producer and readers.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferBroadcast struct to initialize.
+ * @param     pBuffer[in]         Pointer to allocated data buffer.
+ * @param     bufferSize[in]      Size of allocated data buffer.
+ * @param     pReaders[in]        Pointer to allocated array of reader cursors.
+ * @param     readerCount[in]     Number of reader cursors in array, at least 1.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool ICircularBufferBroadcast_Init( CircularBufferBroadcast_t *pCircularBuffer, uint8_t *pBuffer, size_t bufferSize,
+                                    CircularBufferBroadcastReader_t *pReaders, size_t readerCount );
+
+/**
+ * @brief     Get number of bytes available to one reader.
+ *
+ * @attention May be called from any thread. The value is a snapshot and may be outdated as soon as it is returned.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferBroadcast struct to use.
+ * @param     reader[in]          Index of reader.
+ *
+ * @return
+ *      - Number of bytes available for reading by reader.
+ */
+size_t ICircularBufferBroadcast_GetCount( CircularBufferBroadcast_t *pCircularBuffer, size_t reader );
+
+/**
+ * @brief     Peek at data for one reader without removing it. Only from the thread owning that reader.
+ *
+ * @attention Peek does not wrap around the end of the buffer memory. It will return at most the number of bytes
+ *            until the end of the buffer memory.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferBroadcast struct to use.
+ * @param     reader[in]          Index of reader.
+ * @param     ppData[out]         Pointer to where to start peek.
+ *
+ * @return
+ *      - Number of bytes possible to peek at.
+ */
+size_t ICircularBufferBroadcast_Peek( CircularBufferBroadcast_t *pCircularBuffer, size_t reader, uint8_t const **ppData );
+
+/**
+ * @brief     Pop data for one reader. Only from the thread owning that reader.
+ *
+ * @attention Data stays in the buffer until every reader has popped or released it.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferBroadcast struct to use.
+ * @param     reader[in]          Index of reader.
+ * @param     pData[out]          Where data is to be copied to.
+ * @param     count[in]           Number of bytes to pop.
+ *
+ * @return
+ *      - Number of bytes copied/popped.
+ */
+size_t ICircularBufferBroadcast_Pop( CircularBufferBroadcast_t *pCircularBuffer, size_t reader, uint8_t *pData, size_t count );
+
+/**
+ * @brief     Release data for one reader without copying it, e.g. after it was consumed through a peek. Only from the
+ *            thread owning that reader.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferBroadcast struct to use.
+ * @param     reader[in]          Index of reader.
+ * @param     count[in]           Number of bytes to release.
+ *
+ * @return
+ *      - Number of bytes released, at most the number of bytes available to reader.
+ */
+size_t ICircularBufferBroadcast_Release( CircularBufferBroadcast_t *pCircularBuffer, size_t reader, size_t count );
+
+/**
+ * @brief     Push data to circular buffer, once for all readers. Producer only.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferBroadcast struct to use.
+ * @param     pData[in]           Where data is to be copied from.
+ * @param     count[in]           Number of bytes to push.
+ *
+ * @return
+ *      - Number of bytes copied/pushed, limited by the slowest reader.
+ */
+size_t ICircularBufferBroadcast_Push( CircularBufferBroadcast_t *pCircularBuffer, uint8_t const *pData, size_t count );
+
+#endif  // ICIRCULARBUFFERBROADCAST_H
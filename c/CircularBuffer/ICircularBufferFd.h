@@ -0,0 +1,84 @@
+/**
+ * @file      ICircularBufferFd.h
+ * @brief     Interface header for module CircularBufferFd.
+ *
+ * File descriptor I/O for a CircularBuffer_t (POSIX). Data is read straight into the free space of the buffer, or
+ * written straight from the data in the buffer, with one readv/writev call. Wraparound is handled by passing the two
+ * segments of buffer memory as two iovecs, so no bounce buffer or extra copy is needed.
+ *
+ * @version   0.0.1
+ * @date      2019
+ *
+ * @author    Simon Lövgren
+ * @copyright MIT License
+ */
+
+#ifndef ICIRCULARBUFFERFD_H
+#define ICIRCULARBUFFERFD_H
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include <stddef.h>
+#include <sys/types.h>
+
+#include "ICircularBuffer.h"
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @brief     Read from file descriptor into free space of circular buffer, with a single readv.
+ *
+ * @attention Only the bytes actually read are added to the buffer, so partial reads need no special handling.
+ * @attention Interrupted calls (EINTR) are retried. For a non-blocking fd with nothing to read, -1 is returned with
+ *            errno set to EAGAIN/EWOULDBLOCK and the buffer is left untouched.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     fd[in]              File descriptor to read from.
+ * @param     max[in]             Maximum number of bytes to read.
+ *
+ * @return
+ *      - >0: Number of bytes read and added to buffer.
+ *      - 0:  End of file, or max is 0.
+ *      - -1: Error, errno set. ENOBUFS if buffer is full, EINVAL on bad input, otherwise from readv.
+ */
+ssize_t ICircularBufferFd_ReadFromFd( CircularBuffer_t *pCircularBuffer, int fd, size_t max );
+
+/**
+ * @brief     Write data in circular buffer to file descriptor, with a single writev.
+ *
+ * @attention Only the bytes actually written are removed from the buffer, so partial writes need no special handling.
+ * @attention Interrupted calls (EINTR) are retried. For a non-blocking fd that cannot take any data, -1 is returned
+ *            with errno set to EAGAIN/EWOULDBLOCK and the buffer is left untouched.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     fd[in]              File descriptor to write to.
+ * @param     max[in]             Maximum number of bytes to write.
+ *
+ * @return
+ *      - >0: Number of bytes written and removed from buffer.
+ *      - 0:  Buffer is empty, or max is 0.
+ *      - -1: Error, errno set. EINVAL on bad input, otherwise from writev.
+ */
+ssize_t ICircularBufferFd_WriteToFd( CircularBuffer_t *pCircularBuffer, int fd, size_t max );
+
+#endif  // ICIRCULARBUFFERFD_H
@@ -0,0 +1,222 @@
+/**
+ * @file      ICircularBufferJournal.h
+ * @brief     Interface header for module CircularBufferJournal.
+ *
+ * Circular buffer backed by a memory-mapped file, for queued data that has to survive a restart of the process. The
+ * file holds a header with magic number, layout version, size and the read and write positions, followed by buffer
+ * memory. Opening an existing file only validates the header and picks up the positions from it, recovery takes the
+ * same time however much data is queued.
+ *
+ * Buffer memory is written before the write position is moved past it, and read before the read position is, so a
+ * process killed at any point leaves a consistent journal behind: every completed push is kept, every completed pop
+ * is gone, a push or pop that was cut short did not happen. The page cache keeps the mapped file across a process
+ * crash without any syncing.
+ *
+ * Surviving a kernel crash or power loss needs the data written out to disk, which is what the sync policy chooses.
+ * Each sync writes out the buffer memory changed since the last one and then the header, so the journal on disk is
+ * consistent as of the last sync. Positions moved after it may reach disk ahead of the data they cover, so after a
+ * power loss anything pushed since the last sync can not be trusted. ICIRCULARBUFFERJOURNAL_SYNC_COMMIT closes that
+ * window at the cost of a sync per push and pop: a push writes its data out before it moves the write position, then
+ * writes out the header. Popped data may come back after a power loss, consumers should tolerate seeing it twice.
+ *
+ * Like CircularBuffer_t a journal is not thread safe. Only one process may have a journal file open at a time, open
+ * takes an exclusive lock on the file and fails if another process holds it.
+ *
+ * @version   0.0.1
+ * @date      2019
+ *
+ * @author    Simon Lövgren
+ * @copyright MIT License
+ */
+
+#ifndef ICIRCULARBUFFERJOURNAL_H
+#define ICIRCULARBUFFERJOURNAL_H
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @def   ICIRCULARBUFFERJOURNAL_MAGIC
+ * @brief Magic number at start of journal file ("CBJN").
+ */
+#define ICIRCULARBUFFERJOURNAL_MAGIC 0x4E4A4243u
+
+/**
+ * @def   ICIRCULARBUFFERJOURNAL_VERSION
+ * @brief Version of journal file layout, bumped on every incompatible change.
+ */
+#define ICIRCULARBUFFERJOURNAL_VERSION 1u
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * When changes to the journal are written out to disk
+ */
+typedef enum CircularBufferJournalSyncMode
+{
+    ICIRCULARBUFFERJOURNAL_SYNC_NONE = 0,   /**< Only on ICircularBufferJournal_Sync and Close.                    */
+    ICIRCULARBUFFERJOURNAL_SYNC_COMMIT,     /**< After every push and pop that moved a position.                   */
+    ICIRCULARBUFFERJOURNAL_SYNC_BYTES,      /**< Once at least threshold bytes were pushed or popped since last.   */
+    ICIRCULARBUFFERJOURNAL_SYNC_INTERVAL    /**< On push or pop, once threshold ns have passed since last sync.    */
+} CircularBufferJournalSyncMode_t;
+
+/**
+ * Sync policy of a journal
+ */
+typedef struct CircularBufferJournalSync
+{
+    CircularBufferJournalSyncMode_t mode;       /**< When to sync.                                              */
+    uint64_t                        threshold;  /**< Bytes for SYNC_BYTES, nanoseconds for SYNC_INTERVAL.       */
+} CircularBufferJournalSync_t;
+
+/**
+ * Header at start of journal file, followed by buffer memory at dataOffset
+ * @warning Never access any members of the struct, for internal use only.
+ */
+typedef struct CircularBufferJournalHeader
+{
+    uint32_t magic;       /**< ICIRCULARBUFFERJOURNAL_MAGIC, stored last when created.      */
+    uint32_t version;     /**< ICIRCULARBUFFERJOURNAL_VERSION of creating process.          */
+    uint64_t bufferSize;  /**< Size of buffer memory.                                       */
+    uint64_t dataOffset;  /**< Offset of buffer memory from start of file, page aligned.    */
+    uint64_t write;       /**< Free-running write position.                                 */
+    uint64_t read;        /**< Free-running read position.                                  */
+} CircularBufferJournalHeader_t;
+
+/**
+ * Handle to an open journal file
+ * @warning Never access any members of the struct, for internal use only.
+ */
+typedef struct CircularBufferJournal
+{
+    CircularBufferJournalHeader_t *pHeader;     /**< Header, where the file is mapped.                  */
+    int                           fd;           /**< Journal file, kept open to hold its lock.          */
+    uint8_t                       *pBuffer;     /**< Buffer memory, where mapped.                       */
+    size_t                        bufferSize;   /**< Size of buffer memory.                             */
+    size_t                        mappedSize;   /**< Size of mapping, header and buffer memory.         */
+    CircularBufferJournalSync_t   sync;         /**< Sync policy.                                       */
+    uint64_t                      syncedWrite;  /**< Write position buffer memory is synced up to.      */
+    uint64_t                      syncedRead;   /**< Read position as of last sync.                     */
+    uint64_t                      syncedTime;   /**< CLOCK_MONOTONIC time of last sync, in ns.          */
+    bool                          syncFailed;   /**< A sync after push or pop failed since open.        */
+} CircularBufferJournal_t;
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @brief     Open journal file, recovering the queued data in it, or create it if it does not exist or is empty.
+ *
+ * @attention Buffer size is only valid if a power of 2 (64, 128, 256, 512, 1024, etc.).
+ * @attention Fails if an existing file does not have a valid header, or was created with another buffer size.
+ * @attention Fails if the file is open in another process, or through another open in this one.
+ *
+ * @param     pJournal[in]        Pointer to CircularBufferJournal struct to initialize.
+ * @param     pPath[in]           Path of journal file.
+ * @param     bufferSize[in]      Size of buffer memory.
+ * @param     pSync[in]           Sync policy, copied. NULL for ICIRCULARBUFFERJOURNAL_SYNC_NONE.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool ICircularBufferJournal_Open( CircularBufferJournal_t *pJournal, char const *pPath, size_t bufferSize,
+                                  CircularBufferJournalSync_t const *pSync );
+
+/**
+ * @brief     Sync and unmap journal file. The file itself is kept.
+ *
+ * @param     pJournal[in]        Pointer to CircularBufferJournal struct to close.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool ICircularBufferJournal_Close( CircularBufferJournal_t *pJournal );
+
+/**
+ * @brief     Write out changes since last sync to disk, data first and header after it.
+ *
+ * @param     pJournal[in]        Pointer to CircularBufferJournal struct to use.
+ *
+ * @return
+ *      - true:  Journal on disk is up to date.
+ *      - false: Failed.
+ */
+bool ICircularBufferJournal_Sync( CircularBufferJournal_t *pJournal );
+
+/**
+ * @brief     Get number of bytes available to read from journal.
+ *
+ * @param     pJournal[in]        Pointer to CircularBufferJournal struct to use.
+ *
+ * @return
+ *      - Number of bytes available for reading.
+ */
+size_t ICircularBufferJournal_GetCount( CircularBufferJournal_t *pJournal );
+
+/**
+ * @brief     Pop data from journal, syncing afterwards if the policy says so.
+ *
+ * @attention A failed sync does not undo the pop, see ICircularBufferJournal_SyncFailed.
+ *
+ * @param     pJournal[in]        Pointer to CircularBufferJournal struct to use.
+ * @param     pData[out]          Where data is to be copied to.
+ * @param     count[in]           Number of bytes to pop.
+ *
+ * @return
+ *      - Number of bytes copied/popped.
+ */
+size_t ICircularBufferJournal_Pop( CircularBufferJournal_t *pJournal, uint8_t *pData, size_t count );
+
+/**
+ * @brief     Push data to journal, syncing afterwards if the policy says so.
+ *
+ * @attention A failed sync does not undo the push, it stays queued and is written out by the next sync. See
+ *            ICircularBufferJournal_SyncFailed. With ICIRCULARBUFFERJOURNAL_SYNC_COMMIT data is written out before
+ *            the push is made, if that fails nothing is pushed and 0 is returned.
+ *
+ * @param     pJournal[in]        Pointer to CircularBufferJournal struct to use.
+ * @param     pData[in]           Where data is to be copied from.
+ * @param     count[in]           Number of bytes to push.
+ *
+ * @return
+ *      - Number of bytes copied/pushed.
+ */
+size_t ICircularBufferJournal_Push( CircularBufferJournal_t *pJournal, uint8_t const *pData, size_t count );
+
+/**
+ * @brief     Check if a sync done by push or pop, as the policy says, has failed since the journal was opened.
+ *
+ * @attention Sticky, a later successful sync does not clear it. The kernel may drop the pages a failed write-out was
+ *            for, so data pushed before the failure may never reach disk even if later syncs succeed.
+ *
+ * @param     pJournal[in]        Pointer to CircularBufferJournal struct to use.
+ *
+ * @return
+ *      - true:  A sync failed, journal on disk may be missing data.
+ *      - false: No sync failed, or bad arguments.
+ */
+bool ICircularBufferJournal_SyncFailed( CircularBufferJournal_t *pJournal );
+
+#endif  // ICIRCULARBUFFERJOURNAL_H
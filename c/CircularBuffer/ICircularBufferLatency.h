@@ -0,0 +1,147 @@
+/**
+ * @file      ICircularBufferLatency.h
+ * @brief     Interface header for module CircularBufferLatency.
+ *
+ * Latency histogram with HDR-style log-linear buckets, for how long data sat in a buffer before it was consumed. Each
+ * power of 2 range of values is split into ICIRCULARBUFFERLATENCY_SUB_BUCKETS equally wide buckets, so every recorded
+ * value is kept to within 1 / ICIRCULARBUFFERLATENCY_SUB_BUCKETS of itself, from nanoseconds to years, in a fixed
+ * array of counters.
+ *
+ * Recording is a couple of relaxed atomic adds, with no locks and no allocation, and any number of threads may record
+ * into the same histogram. Percentiles can be read at any time from any thread while values are being recorded; such
+ * a read is not an atomic snapshot, values recorded during it may or may not be counted.
+ *
+ * @version   0.0.1
+ * @date      2019
+ *
+ * @author    Simon Lövgren
+ * @copyright MIT License
+ */
+
+#ifndef ICIRCULARBUFFERLATENCY_H
+#define ICIRCULARBUFFERLATENCY_H
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @def   ICIRCULARBUFFERLATENCY_SUB_BITS
+ * @brief Number of bits of a value kept below its highest set bit, 4 gives a resolution of 1/16 (6.25 %).
+ */
+#define ICIRCULARBUFFERLATENCY_SUB_BITS 4
+
+/**
+ * @def   ICIRCULARBUFFERLATENCY_SUB_BUCKETS
+ * @brief Number of buckets each power of 2 range of values is split into.
+ */
+#define ICIRCULARBUFFERLATENCY_SUB_BUCKETS ( 1u << ICIRCULARBUFFERLATENCY_SUB_BITS )
+
+/**
+ * @def   ICIRCULARBUFFERLATENCY_BUCKETS
+ * @brief Number of buckets needed to cover every 64 bit value.
+ */
+#define ICIRCULARBUFFERLATENCY_BUCKETS \
+    ( ( 64 - ICIRCULARBUFFERLATENCY_SUB_BITS + 1 ) * ICIRCULARBUFFERLATENCY_SUB_BUCKETS )
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * Latency histogram
+ * @warning Never access any members of the struct, for internal use only.
+ */
+typedef struct CircularBufferLatency
+{
+    atomic_uint_least64_t buckets[ ICIRCULARBUFFERLATENCY_BUCKETS ]; /**< Number of values recorded per bucket.   */
+    atomic_uint_least64_t count;                                     /**< Number of values recorded in total.     */
+    atomic_uint_least64_t max;                                       /**< Largest value recorded, exact.          */
+} CircularBufferLatency_t;
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @brief     Initialize an empty histogram.
+ *
+ * @attention Must be done before the histogram is shared between threads, use ICircularBufferLatency_Reset after.
+ *
+ * @param     pLatency[in]        Pointer to CircularBufferLatency struct to initialize.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool ICircularBufferLatency_Init( CircularBufferLatency_t *pLatency );
+
+/**
+ * @brief     Empty histogram while in use.
+ *
+ * @attention Values recorded while resetting may or may not be kept.
+ *
+ * @param     pLatency[in]        Pointer to CircularBufferLatency struct to reset.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool ICircularBufferLatency_Reset( CircularBufferLatency_t *pLatency );
+
+/**
+ * @brief     Record a value.
+ *
+ * @param     pLatency[in]        Pointer to CircularBufferLatency struct to use.
+ * @param     value[in]           Value to record, in nanoseconds for queueing delay.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool ICircularBufferLatency_Record( CircularBufferLatency_t *pLatency, uint64_t value );
+
+/**
+ * @brief     Get number of values recorded.
+ *
+ * @param     pLatency[in]        Pointer to CircularBufferLatency struct to use.
+ *
+ * @return
+ *      - Number of values recorded since init or last reset.
+ */
+uint64_t ICircularBufferLatency_GetCount( CircularBufferLatency_t *pLatency );
+
+/**
+ * @brief     Get value at or below which the given percentage of recorded values are.
+ *
+ * @attention The value returned is the top of its bucket, never below the exact percentile and at most
+ *            1 / ICIRCULARBUFFERLATENCY_SUB_BUCKETS above it. Percentile 100 is the largest value recorded, exact.
+ *
+ * @param     pLatency[in]        Pointer to CircularBufferLatency struct to use.
+ * @param     percentile[in]      Percentile, 0 to 100, e.g. 99.0 for p99.
+ * @param     pValue[out]         Set to value at percentile.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Nothing recorded, or bad arguments.
+ */
+bool ICircularBufferLatency_GetPercentile( CircularBufferLatency_t *pLatency, double percentile, uint64_t *pValue );
+
+#endif  // ICIRCULARBUFFERLATENCY_H
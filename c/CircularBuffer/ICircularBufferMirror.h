@@ -0,0 +1,75 @@
+/**
+ * @file      ICircularBufferMirror.h
+ * @brief     Interface header for module CircularBufferMirror.
+ *
+ * Alternative initialization of a CircularBuffer_t where the buffer memory is mapped twice, back to back, in virtual
+ * memory (Linux only). Data past the end of the buffer memory shows up at its start, so ICircularBuffer_Peek,
+ * ICircularBuffer_Reserve and friends always return one contiguous span, also across the wraparound.
+ *
+ * @version   0.0.1
+ * @date      2019
+ *
+ * @author    Simon Lövgren
+ * @copyright MIT License
+ */
+
+#ifndef ICIRCULARBUFFERMIRROR_H
+#define ICIRCULARBUFFERMIRROR_H
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ICircularBuffer.h"
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @brief     Initialize a circular buffer with mirrored buffer memory, allocated by the module.
+ *
+ * @attention Buffer size is only valid if a power of 2 and a multiple of the page size (4096, 8192, 16384, etc.).
+ * @attention Buffer must be released with ICircularBufferMirror_Deinit.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to initialize.
+ * @param     bufferSize[in]      Size of data buffer to allocate.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool ICircularBufferMirror_Init( CircularBuffer_t *pCircularBuffer, size_t bufferSize );
+
+/**
+ * @brief     Release mirrored buffer memory of a circular buffer.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct initialized with ICircularBufferMirror_Init.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool ICircularBufferMirror_Deinit( CircularBuffer_t *pCircularBuffer );
+
+#endif  // ICIRCULARBUFFERMIRROR_H
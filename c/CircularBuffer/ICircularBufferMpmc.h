@@ -0,0 +1,140 @@
+/**
+ * @file      ICircularBufferMpmc.h
+ * @brief     Interface header for module CircularBufferMpmc.
+ *
+ * Lock-free multi-producer/multi-consumer variant of the circular buffer, built as a bounded queue of fixed-size
+ * element slots where every slot carries its own sequence number (D. Vyukov style). Producers and consumers only
+ * contend on a single compare-and-swap of the enqueue or dequeue position respectively.
+ *
+ * @version   0.0.1
+ * @date      2019
+ *
+ * @author    Simon Lövgren
+ * @copyright MIT License
+ */
+
+#ifndef ICIRCULARBUFFERMPMC_H
+#define ICIRCULARBUFFERMPMC_H
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @def   ICIRCULARBUFFERMPMC_CACHE_LINE_SIZE
+ * @brief Size of a cache line, used to keep enqueue and dequeue positions from sharing one.
+ */
+#define ICIRCULARBUFFERMPMC_CACHE_LINE_SIZE 64
+
+/**
+ * @def   ICIRCULARBUFFERMPMC_SLOT_SIZE(elementSize)
+ * @brief Size of one slot (sequence number and element), rounded up to keep every sequence number aligned.
+ */
+#define ICIRCULARBUFFERMPMC_SLOT_SIZE(elementSize) \
+    ( ( ( sizeof( atomic_size_t ) + (elementSize) ) + ( sizeof( atomic_size_t ) - 1 ) ) & ~( sizeof( atomic_size_t ) - 1 ) )
+
+/**
+ * @def   ICIRCULARBUFFERMPMC_BUFFER_SIZE(slotCount, elementSize)
+ * @brief Number of bytes the caller has to allocate for a buffer of slotCount elements of elementSize bytes.
+ */
+#define ICIRCULARBUFFERMPMC_BUFFER_SIZE(slotCount, elementSize) \
+    ( (slotCount) * ICIRCULARBUFFERMPMC_SLOT_SIZE( elementSize ) )
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * Multi-producer/multi-consumer circular buffer
+ * @warning Never access any members of the struct, for internal use only.
+ */
+typedef struct CircularBufferMpmc
+{
+    _Alignas( ICIRCULARBUFFERMPMC_CACHE_LINE_SIZE )
+    atomic_size_t enqueuePos;  /**< Next position to be claimed by a producer.        */
+    _Alignas( ICIRCULARBUFFERMPMC_CACHE_LINE_SIZE )
+    atomic_size_t dequeuePos;  /**< Next position to be claimed by a consumer.        */
+    _Alignas( ICIRCULARBUFFERMPMC_CACHE_LINE_SIZE )
+    uint8_t       *pBuffer;    /**< Pointer to allocated slot buffer.                 */
+    size_t        slotCount;   /**< Number of slots, power of 2.                      */
+    size_t        slotSize;    /**< Size of one slot, sequence number and element.    */
+    size_t        elementSize; /**< Size of one element.                              */
+} CircularBufferMpmc_t;
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @brief     Initialize a multi-producer/multi-consumer circular buffer.
+ *
+ * @attention Slot count is only valid if a power of 2 (64, 128, 256, 512, 1024, etc.).
+ * @attention Buffer must be at least ICIRCULARBUFFERMPMC_BUFFER_SIZE( slotCount, elementSize ) bytes and aligned for
+ *            atomic_size_t.
+ * @attention Must be done before the buffer is shared between threads.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferMpmc struct to initialize.
+ * @param     pBuffer[in]         Pointer to allocated slot buffer.
+ * @param     slotCount[in]       Number of element slots in buffer.
+ * @param     elementSize[in]     Size of one element.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool ICircularBufferMpmc_Init( CircularBufferMpmc_t *pCircularBuffer, uint8_t *pBuffer, size_t slotCount, size_t elementSize );
+
+/**
+ * @brief     Get number of elements available to read from buffer.
+ *
+ * @attention The value is a snapshot and may be outdated as soon as it is returned.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferMpmc struct to use.
+ *
+ * @return
+ *      - Number of elements available for reading.
+ */
+size_t ICircularBufferMpmc_GetCount( CircularBufferMpmc_t *pCircularBuffer );
+
+/**
+ * @brief     Pop one element from circular buffer. Safe to call from any number of threads.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferMpmc struct to use.
+ * @param     pElement[out]       Where element is to be copied to, elementSize bytes.
+ *
+ * @return
+ *      - true:  Element popped.
+ *      - false: Buffer empty or bad input.
+ */
+bool ICircularBufferMpmc_Pop( CircularBufferMpmc_t *pCircularBuffer, uint8_t *pElement );
+
+/**
+ * @brief     Push one element to circular buffer. Safe to call from any number of threads.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferMpmc struct to use.
+ * @param     pElement[in]        Where element is to be copied from, elementSize bytes.
+ *
+ * @return
+ *      - true:  Element pushed.
+ *      - false: Buffer full or bad input.
+ */
+bool ICircularBufferMpmc_Push( CircularBufferMpmc_t *pCircularBuffer, uint8_t const *pElement );
+
+#endif  // ICIRCULARBUFFERMPMC_H
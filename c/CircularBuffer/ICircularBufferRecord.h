@@ -0,0 +1,137 @@
+/**
+ * @file      ICircularBufferRecord.h
+ * @brief     Interface header for module CircularBufferRecord.
+ *
+ * Length-prefixed records on top of CircularBuffer_t. Each record is a 32 bit length header followed by its payload,
+ * padded so the next header starts on ICIRCULARBUFFERRECORD_ALIGNMENT. A record is always stored contiguously in
+ * buffer memory, so it can be read in place: when it does not fit before end of buffer memory the rest of the
+ * memory is filled with a skip marker and the record starts over at the beginning. Mirrored buffers never need one.
+ *
+ * Push is all or nothing, a reader never sees half a record. Peek hands out a pointer into buffer memory that stays
+ * valid until the record is popped.
+ *
+ * @attention All data in a buffer used for records must be pushed and popped through this module, mixing in byte
+ *            Push/Pop/Commit/Release breaks the framing. Overwrite mode is not supported, and neither are growable
+ *            buffers: a resize would move skip markers into the middle of the data and free the memory a peeked
+ *            record points into.
+ *
+ * @version   0.0.1
+ * @date      2019
+ *
+ * @author    Simon Lövgren
+ * @copyright MIT License
+ */
+
+#ifndef ICIRCULARBUFFERRECORD_H
+#define ICIRCULARBUFFERRECORD_H
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ICircularBuffer.h"
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @def   ICIRCULARBUFFERRECORD_ALIGNMENT
+ * @brief Alignment of record headers in buffer memory, also the size of a header.
+ */
+#define ICIRCULARBUFFERRECORD_ALIGNMENT 4
+
+/**
+ * @def   ICIRCULARBUFFERRECORD_SKIP
+ * @brief Header value marking that the rest of buffer memory is padding and the next record is at its start.
+ */
+#define ICIRCULARBUFFERRECORD_SKIP UINT32_MAX
+
+/**
+ * @def   ICIRCULARBUFFERRECORD_SIZE(length)
+ * @brief Number of bytes of buffer memory a record with payload of length bytes occupies, header and padding included.
+ */
+#define ICIRCULARBUFFERRECORD_SIZE(length) \
+    ( ( sizeof( uint32_t ) + (length) + ( ICIRCULARBUFFERRECORD_ALIGNMENT - 1 ) ) & ~(size_t)( ICIRCULARBUFFERRECORD_ALIGNMENT - 1 ) )
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @brief     Push one record to circular buffer, all or nothing.
+ *
+ * @attention Needs ICIRCULARBUFFERRECORD_SIZE( length ) bytes of free space, plus the space left before end of buffer
+ *            memory if the record does not fit there. An empty buffer skips ahead to the start of buffer memory
+ *            first, so a record of up to the size of the buffer always fits in it.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     pData[in]           Where payload is to be copied from, may be NULL if length is 0.
+ * @param     length[in]          Number of payload bytes.
+ *
+ * @return
+ *      - true:  Record pushed.
+ *      - false: Not enough space, bad arguments or overwrite/growable buffer, nothing pushed.
+ */
+bool ICircularBufferRecord_Push( CircularBuffer_t *pCircularBuffer, uint8_t const *pData, size_t length );
+
+/**
+ * @brief     Get oldest record in buffer without copying or removing it.
+ *
+ * @attention Payload stays valid until the record is popped or the buffer is cleared.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     ppData[out]         Set to point at payload in buffer memory.
+ * @param     pLength[out]        Set to number of payload bytes.
+ *
+ * @return
+ *      - true:  Record available.
+ *      - false: Buffer empty or bad arguments.
+ */
+bool ICircularBufferRecord_Peek( CircularBuffer_t *pCircularBuffer, uint8_t const **ppData, size_t *pLength );
+
+/**
+ * @brief     Get up to max of the oldest records in buffer without copying or removing them.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     pRecords[out]       Array of at least max segments, set to payload and length of each record in order.
+ * @param     max[in]             Maximum number of records to get.
+ *
+ * @return
+ *      - Number of records in pRecords.
+ */
+size_t ICircularBufferRecord_PeekBatch( CircularBuffer_t *pCircularBuffer, CircularBufferSegment_t *pRecords, size_t max );
+
+/**
+ * @brief     Remove oldest record from buffer.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ *
+ * @return
+ *      - true:  Record removed.
+ *      - false: Buffer empty or bad arguments.
+ */
+bool ICircularBufferRecord_Pop( CircularBuffer_t *pCircularBuffer );
+
+/**
+ * @brief     Remove up to count of the oldest records from buffer, in a single release.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBuffer struct to use.
+ * @param     count[in]           Maximum number of records to remove.
+ *
+ * @return
+ *      - Number of records removed.
+ */
+size_t ICircularBufferRecord_PopBatch( CircularBuffer_t *pCircularBuffer, size_t count );
+
+#endif  // ICIRCULARBUFFERRECORD_H
@@ -0,0 +1,187 @@
+/**
+ * @file      ICircularBufferSharded.h
+ * @brief     Interface header for module CircularBufferSharded.
+ *
+ * Set of single-producer/single-consumer circular buffers (shards), for many producers and consumers without a shared
+ * index for all of them to fight over. Each producer attaches to a shard of its own and only ever pushes there, so
+ * its data stays in order and producers never touch each other's cache lines. The caller provides the shards and one
+ * block of buffer memory, split evenly between them.
+ *
+ * Consumers are numbered from 0. Shard i is home to consumer ( i % consumerCount ). A pop takes from the fullest home
+ * shard with data, and only when all home shards are empty or locked by other consumers steals from the fullest of the
+ * others. A pop takes a batch from a single shard, while holding that shard's consumer lock, so two consumers never pop
+ * from one shard at the same time and one producer's data is handed out in the order it was pushed.
+ *
+ * Data is moved in whole elements of a size fixed at init, so a pop never splits an element between two consumers.
+ *
+ * @attention Batches from one shard handed to two different consumers may be processed in any order. Callers that
+ *            need per-producer order downstream should stick to one consumer, or order by content.
+ *
+ * @version   0.0.1
+ * @date      2019
+ *
+ * @author    Simon Lövgren
+ * @copyright MIT License
+ */
+
+#ifndef ICIRCULARBUFFERSHARDED_H
+#define ICIRCULARBUFFERSHARDED_H
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "ICircularBufferSpsc.h"
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * How a producer attaching to the set picks its shard
+ */
+typedef enum CircularBufferShardedPick
+{
+    ICIRCULARBUFFERSHARDED_PICK_ROUND_ROBIN = 0,  /**< Next free shard after the one picked last.             */
+    ICIRCULARBUFFERSHARDED_PICK_LEAST_LOADED      /**< Free shard with the least data queued in it.           */
+} CircularBufferShardedPick_t;
+
+/**
+ * One shard of a sharded set
+ * @warning Never access any members of the struct, for internal use only.
+ */
+typedef struct CircularBufferShard
+{
+    CircularBufferSpsc_t ring;      /**< Buffer of the shard.                                   */
+    _Alignas( ICIRCULARBUFFERSPSC_CACHE_LINE_SIZE )
+    atomic_bool          attached;  /**< A producer is attached to the shard.                   */
+    atomic_bool          locked;    /**< A consumer is popping from the shard.                  */
+} CircularBufferShard_t;
+
+/**
+ * Sharded set of single-producer/single-consumer circular buffers
+ * @warning Never access any members of the struct, for internal use only.
+ */
+typedef struct CircularBufferSharded
+{
+    CircularBufferShard_t       *pShards;       /**< Array of shards.                               */
+    size_t                      shardCount;     /**< Number of shards.                              */
+    size_t                      shardSize;      /**< Size of buffer memory of each shard.           */
+    size_t                      elementSize;    /**< Size of elements pushed and popped.            */
+    size_t                      consumerCount;  /**< Number of consumers.                           */
+    CircularBufferShardedPick_t pick;           /**< How producers pick their shard.                */
+    atomic_size_t               next;           /**< Where round robin pick starts next time.       */
+} CircularBufferSharded_t;
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @brief     Initialize sharded set, splitting buffer memory evenly between the shards.
+ *
+ * @attention Buffer size divided by shard count is the size of each shard, and is only valid if a power of 2 (64,
+ *            128, 256, 512, 1024, etc.) and at least one element.
+ * @attention Must be done before the set is shared between producers and consumers.
+ *
+ * @param     pSharded[in]        Pointer to CircularBufferSharded struct to initialize.
+ * @param     pShards[in]         Array of shardCount shards, one per producer.
+ * @param     shardCount[in]      Number of shards.
+ * @param     pBuffer[in]         Pointer to allocated data buffer.
+ * @param     bufferSize[in]      Size of allocated data buffer.
+ * @param     elementSize[in]     Size of elements, every push and pop moves whole elements.
+ * @param     consumerCount[in]   Number of consumers, at most shardCount.
+ * @param     pick[in]            How producers pick their shard.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool ICircularBufferSharded_Init( CircularBufferSharded_t *pSharded, CircularBufferShard_t *pShards, size_t shardCount,
+                                  uint8_t *pBuffer, size_t bufferSize, size_t elementSize, size_t consumerCount,
+                                  CircularBufferShardedPick_t pick );
+
+/**
+ * @brief     Attach a producer to a free shard, picked as set at init.
+ *
+ * @param     pSharded[in]        Pointer to CircularBufferSharded struct to use.
+ * @param     pShard[out]         Set to index of shard to push to.
+ *
+ * @return
+ *      - true:  Attached.
+ *      - false: All shards taken or bad arguments.
+ */
+bool ICircularBufferSharded_Attach( CircularBufferSharded_t *pSharded, size_t *pShard );
+
+/**
+ * @brief     Detach producer from its shard, freeing it for another producer. Queued data stays.
+ *
+ * @param     pSharded[in]        Pointer to CircularBufferSharded struct to use.
+ * @param     shard[in]           Index of shard from ICircularBufferSharded_Attach.
+ *
+ * @return
+ *      - true:  Detached.
+ *      - false: Shard not attached or bad arguments.
+ */
+bool ICircularBufferSharded_Detach( CircularBufferSharded_t *pSharded, size_t shard );
+
+/**
+ * @brief     Get number of bytes available to read from all shards.
+ *
+ * @attention The value is a snapshot and may be outdated as soon as it is returned.
+ *
+ * @param     pSharded[in]        Pointer to CircularBufferSharded struct to use.
+ *
+ * @return
+ *      - Number of bytes available for reading.
+ */
+size_t ICircularBufferSharded_GetCount( CircularBufferSharded_t *pSharded );
+
+/**
+ * @brief     Pop a batch of whole elements from one shard, home shards first and stealing from others if they are
+ *            empty.
+ *
+ * @param     pSharded[in]        Pointer to CircularBufferSharded struct to use.
+ * @param     consumer[in]        Index of calling consumer, below consumer count.
+ * @param     pData[out]          Where data is to be copied to.
+ * @param     count[in]           Maximum number of bytes to pop, rounded down to whole elements.
+ * @param     pShard[out]         Set to index of shard popped from, may be NULL.
+ *
+ * @return
+ *      - Number of bytes copied/popped, 0 if all shards are empty.
+ */
+size_t ICircularBufferSharded_Pop( CircularBufferSharded_t *pSharded, size_t consumer, uint8_t *pData, size_t count,
+                                   size_t *pShard );
+
+/**
+ * @brief     Push whole elements to the calling producer's shard. Attached producer of the shard only.
+ *
+ * @param     pSharded[in]        Pointer to CircularBufferSharded struct to use.
+ * @param     shard[in]           Index of shard from ICircularBufferSharded_Attach.
+ * @param     pData[in]           Where data is to be copied from.
+ * @param     count[in]           Number of bytes to push, rounded down to whole elements.
+ *
+ * @return
+ *      - Number of bytes copied/pushed.
+ */
+size_t ICircularBufferSharded_Push( CircularBufferSharded_t *pSharded, size_t shard, uint8_t const *pData,
+                                    size_t count );
+
+#endif  // ICIRCULARBUFFERSHARDED_H
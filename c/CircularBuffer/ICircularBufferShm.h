@@ -0,0 +1,192 @@
+/**
+ * @file      ICircularBufferShm.h
+ * @brief     Interface header for module CircularBufferShm.
+ *
+ * Lock-free single-producer/single-consumer circular buffer in POSIX shared memory, for passing data between two
+ * local processes. All state shared between the processes lives in the shared memory and holds only offsets and
+ * fixed-width integers, never pointers, so each process may map it at a different address (and be built 32 or 64
+ * bit). A header with magic number and layout version guards against attaching to something else.
+ *
+ * One process creates the buffer, the other attaches to it by name. Which of them produces and which consumes is up
+ * to the caller, there may be one of each.
+ *
+ * @version   0.0.1
+ * @date      2019
+ *
+ * @author    Simon Lövgren
+ * @copyright MIT License
+ */
+
+#ifndef ICIRCULARBUFFERSHM_H
+#define ICIRCULARBUFFERSHM_H
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @def   ICIRCULARBUFFERSHM_MAGIC
+ * @brief Magic number at start of shared memory ("CBSH").
+ */
+#define ICIRCULARBUFFERSHM_MAGIC 0x48534243u
+
+/**
+ * @def   ICIRCULARBUFFERSHM_VERSION
+ * @brief Version of shared memory layout, bumped on every incompatible change.
+ */
+#define ICIRCULARBUFFERSHM_VERSION 1u
+
+/**
+ * @def   ICIRCULARBUFFERSHM_CACHE_LINE_SIZE
+ * @brief Size of a cache line, used to keep producer and consumer state from sharing one.
+ */
+#define ICIRCULARBUFFERSHM_CACHE_LINE_SIZE 64
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * Header at start of shared memory, followed by buffer memory at dataOffset
+ * @warning Never access any members of the struct, for internal use only.
+ */
+typedef struct CircularBufferShmHeader
+{
+    _Alignas( ICIRCULARBUFFERSHM_CACHE_LINE_SIZE )
+    atomic_uint_least32_t magic;      /**< ICIRCULARBUFFERSHM_MAGIC, stored last when created.         */
+    uint32_t              version;    /**< ICIRCULARBUFFERSHM_VERSION of creating process.             */
+    uint64_t              bufferSize; /**< Size of buffer memory.                                      */
+    uint64_t              dataOffset; /**< Offset of buffer memory from start of header, cache aligned. */
+    _Alignas( ICIRCULARBUFFERSHM_CACHE_LINE_SIZE )
+    atomic_uint_least64_t write;      /**< Free-running write index, only stored by producer.          */
+    _Alignas( ICIRCULARBUFFERSHM_CACHE_LINE_SIZE )
+    atomic_uint_least64_t read;       /**< Free-running read index, only stored by consumer.           */
+} CircularBufferShmHeader_t;
+
+/**
+ * Process-local handle to a shared memory circular buffer
+ * @warning Never access any members of the struct, for internal use only.
+ */
+typedef struct CircularBufferShm
+{
+    CircularBufferShmHeader_t *pHeader;    /**< Header, where shared memory is mapped in this process.  */
+    uint8_t                   *pBuffer;    /**< Buffer memory, where mapped in this process.            */
+    size_t                    bufferSize;  /**< Size of buffer memory.                                  */
+    size_t                    mappedSize;  /**< Size of mapping, header and buffer memory.              */
+    uint64_t                  readCache;   /**< Producer's last seen read index.                        */
+    uint64_t                  writeCache;  /**< Consumer's last seen write index.                       */
+} CircularBufferShm_t;
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @brief     Create and map a new shared memory circular buffer.
+ *
+ * @attention Buffer size is only valid if a power of 2 (64, 128, 256, 512, 1024, etc.).
+ * @attention Fails if shared memory object with the same name already exists.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferShm struct to initialize.
+ * @param     pName[in]           Name of shared memory object, "/name" as for shm_open.
+ * @param     bufferSize[in]      Size of buffer memory.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool ICircularBufferShm_Create( CircularBufferShm_t *pCircularBuffer, char const *pName, size_t bufferSize );
+
+/**
+ * @brief     Map an existing shared memory circular buffer, created by ICircularBufferShm_Create.
+ *
+ * @attention Fails if magic number, version or sizes in the header do not match, or if the creator has not finished
+ *            setting it up yet.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferShm struct to initialize.
+ * @param     pName[in]           Name of shared memory object, "/name" as for shm_open.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool ICircularBufferShm_Attach( CircularBufferShm_t *pCircularBuffer, char const *pName );
+
+/**
+ * @brief     Unmap shared memory circular buffer from this process.
+ *
+ * @attention The shared memory object itself stays until ICircularBufferShm_Unlink is called.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferShm struct to detach.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool ICircularBufferShm_Detach( CircularBufferShm_t *pCircularBuffer );
+
+/**
+ * @brief     Remove name of shared memory object. Memory is freed when the last process has detached.
+ *
+ * @param     pName[in]           Name of shared memory object, "/name" as for shm_open.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool ICircularBufferShm_Unlink( char const *pName );
+
+/**
+ * @brief     Get number of bytes available to read from buffer.
+ *
+ * @attention May be called from either side. The value is a snapshot and may be outdated as soon as it is returned.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferShm struct to use.
+ *
+ * @return
+ *      - Number of bytes available for reading.
+ */
+size_t ICircularBufferShm_GetCount( CircularBufferShm_t *pCircularBuffer );
+
+/**
+ * @brief     Pop data from circular buffer. Consumer only.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferShm struct to use.
+ * @param     pData[out]          Where data is to be copied to.
+ * @param     count[in]           Number of bytes to pop.
+ *
+ * @return
+ *      - Number of bytes copied/popped.
+ */
+size_t ICircularBufferShm_Pop( CircularBufferShm_t *pCircularBuffer, uint8_t *pData, size_t count );
+
+/**
+ * @brief     Push data to circular buffer. Producer only.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferShm struct to use.
+ * @param     pData[in]           Where data is to be copied from.
+ * @param     count[in]           Number of bytes to push.
+ *
+ * @return
+ *      - Number of bytes copied/pushed.
+ */
+size_t ICircularBufferShm_Push( CircularBufferShm_t *pCircularBuffer, uint8_t const *pData, size_t count );
+
+#endif  // ICIRCULARBUFFERSHM_H
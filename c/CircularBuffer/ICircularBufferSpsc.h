@@ -0,0 +1,356 @@
+/**
+ * @file      ICircularBufferSpsc.h
+ * @brief     Interface header for module CircularBufferSpsc.
+ *
+ * Lock-free single-producer/single-consumer variant of the circular buffer. One thread may push while another thread
+ * pops, without any external locking. The producer only ever stores the write index and the consumer only ever
+ * stores the read index, both using C11 atomics with acquire/release ordering.
+ *
+ * Producer and consumer state live on separate cache lines, and each side keeps a cached copy of the other side's
+ * index. The shared index is only loaded again when the cached copy makes the buffer look too full (producer) or too
+ * empty (consumer), so in steady state each call touches just its own cache line.
+ *
+ * Define ICIRCULARBUFFERSPSC_WAIT when building (for all files including this header) for ICircularBufferSpsc_PopWait
+ * and ICircularBufferSpsc_PushWait, which block instead of returning 0. They spin briefly and then park the thread, on
+ * a futex on Linux or on a condition variable elsewhere (or when ICIRCULARBUFFERSPSC_CONDVAR is defined). A parked side
+ * raises a flag which lives on the other side's cache line, and is only woken when the other side moves the buffer
+ * away from empty or full. While nobody is parked, push and pop never make a system call, but a wakeup can only be
+ * ruled out if both sides order their index store before loading the other's flag, so with waits built in every push
+ * and pop publishes its index with a sequentially consistent store (a full fence). Without waits it is a plain
+ * release store.
+ *
+ * Every push still hands a cache line to the other side per call. For many small messages the producer can instead
+ * copy a batch in with ICircularBufferSpsc_PushDeferred between ICircularBufferSpsc_BeginBatch and
+ * ICircularBufferSpsc_PublishBatch, which publishes all of it with one store, and the consumer can retire up to a
+ * whole buffer of fixed size items with one ICircularBufferSpsc_PopBatch.
+ *
+ * Define ICIRCULARBUFFERSPSC_DWELL when building (for all files including this header) for
+ * ICircularBufferSpsc_TraceDwell, which turns on tracing of queueing delay: pushes are stamped with CLOCK_MONOTONIC in
+ * a separate array of stamps, and pops record how long the data they finish sat in the buffer in a latency histogram.
+ * Built in but not traced, this costs a single not taken branch per call. Without it nothing is added to the buffer
+ * struct or the push/pop paths.
+ *
+ * @version   0.0.1
+ * @date      2019
+ *
+ * @author    Simon Lövgren
+ * @copyright MIT License
+ */
+
+#ifndef ICIRCULARBUFFERSPSC_H
+#define ICIRCULARBUFFERSPSC_H
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef ICIRCULARBUFFERSPSC_DWELL
+#include "ICircularBufferLatency.h"
+#endif
+
+#if defined( ICIRCULARBUFFERSPSC_WAIT ) && ( !defined( __linux__ ) || defined( ICIRCULARBUFFERSPSC_CONDVAR ) )
+#include <pthread.h>
+#endif
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @def   ICIRCULARBUFFERSPSC_CACHE_LINE_SIZE
+ * @brief Size of a cache line, used to keep producer and consumer state from sharing one.
+ */
+#define ICIRCULARBUFFERSPSC_CACHE_LINE_SIZE 64
+
+/**
+ * @def   ICIRCULARBUFFERSPSC_FUTEX
+ * @brief Defined when blocking calls park on a futex, otherwise they use a mutex and condition variables.
+ */
+#if defined( ICIRCULARBUFFERSPSC_WAIT ) && defined( __linux__ ) && !defined( ICIRCULARBUFFERSPSC_CONDVAR )
+#define ICIRCULARBUFFERSPSC_FUTEX
+#endif
+
+/**
+ * @def   ICIRCULARBUFFERSPSC_WAIT_FOREVER
+ * @brief Timeout for ICircularBufferSpsc_PopWait and ICircularBufferSpsc_PushWait to never time out.
+ */
+#define ICIRCULARBUFFERSPSC_WAIT_FOREVER ( -1 )
+
+/**
+ * @def   ICIRCULARBUFFERSPSC_WAIT_SPINS
+ * @brief Number of times a blocking call retries before parking the thread.
+ */
+#ifndef ICIRCULARBUFFERSPSC_WAIT_SPINS
+#define ICIRCULARBUFFERSPSC_WAIT_SPINS 128
+#endif
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#ifdef ICIRCULARBUFFERSPSC_DWELL
+/**
+ * Push stamp for dwell tracing
+ * @warning Never access any members of the struct, for internal use only.
+ */
+typedef struct CircularBufferSpscStamp
+{
+    size_t   end;   /**< Write index after the stamped push.            */
+    uint64_t time;  /**< CLOCK_MONOTONIC time of the push, in ns.       */
+} CircularBufferSpscStamp_t;
+#endif
+
+/**
+ * Single-producer/single-consumer circular buffer
+ * @warning Never access any members of the struct, for internal use only.
+ */
+typedef struct CircularBufferSpsc
+{
+    _Alignas( ICIRCULARBUFFERSPSC_CACHE_LINE_SIZE )
+    atomic_size_t             write;           /**< Free-running write index, only stored by producer.            */
+    size_t                    readCache;       /**< Producer's last seen read index.                              */
+#ifdef ICIRCULARBUFFERSPSC_WAIT
+    atomic_uint               consumerWaiting; /**< Consumer is parked on empty buffer, checked on push.          */
+#endif
+    size_t                    batchWrite;      /**< Producer's write index of batch not yet published.            */
+#ifdef ICIRCULARBUFFERSPSC_DWELL
+    atomic_size_t             stampWrite;      /**< Free-running index of next stamp, only stored by producer.    */
+    size_t                    stampReadCache;  /**< Producer's last seen stamp read index.                        */
+#endif
+    _Alignas( ICIRCULARBUFFERSPSC_CACHE_LINE_SIZE )
+    atomic_size_t             read;            /**< Free-running read index, only stored by consumer.             */
+    size_t                    writeCache;      /**< Consumer's last seen write index.                             */
+#ifdef ICIRCULARBUFFERSPSC_WAIT
+    atomic_uint               producerWaiting; /**< Producer is parked on full buffer, checked on pop.            */
+#endif
+#ifdef ICIRCULARBUFFERSPSC_DWELL
+    atomic_size_t             stampRead;       /**< Free-running index of oldest stamp, only stored by consumer.  */
+#endif
+    _Alignas( ICIRCULARBUFFERSPSC_CACHE_LINE_SIZE )
+    uint8_t                   *pBuffer;        /**< Pointer to allocated buffer.                                  */
+    size_t                    bufferSize;      /**< Size of buffer.                                               */
+#ifdef ICIRCULARBUFFERSPSC_DWELL
+    CircularBufferSpscStamp_t *pStamps;        /**< Dwell tracing: push stamps, NULL when not tracing.            */
+    size_t                    stampCount;      /**< Dwell tracing: number of stamps, power of 2.                  */
+    CircularBufferLatency_t   *pLatency;       /**< Dwell tracing: histogram dwell times are recorded in.         */
+#endif
+#if defined( ICIRCULARBUFFERSPSC_WAIT ) && !defined( ICIRCULARBUFFERSPSC_FUTEX )
+    pthread_mutex_t           mutex;           /**< Protects parking, condition variable fallback only.           */
+    pthread_cond_t            consumerCond;    /**< Consumer parks here, condition variable fallback.             */
+    pthread_cond_t            producerCond;    /**< Producer parks here, condition variable fallback.             */
+#endif
+} CircularBufferSpsc_t;
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @brief     Initialize a single-producer/single-consumer circular buffer.
+ *
+ * @attention Buffer size is only valid if a power of 2 (64, 128, 256, 512, 1024, etc.).
+ * @attention Must be done before the buffer is shared between producer and consumer.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to initialize.
+ * @param     pBuffer[in]         Pointer to allocated data buffer.
+ * @param     bufferSize[in]      Size of allocated data buffer.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool ICircularBufferSpsc_Init( CircularBufferSpsc_t *pCircularBuffer, uint8_t *pBuffer, size_t bufferSize );
+
+#ifdef ICIRCULARBUFFERSPSC_DWELL
+/**
+ * @brief     Trace how long data sits in the buffer, recording the dwell time of every push in a latency histogram.
+ *
+ * Every push, or published batch, is stamped with the time it became visible to the consumer. The pop that takes the
+ * last byte of it records the time since into the histogram, which can be read from any thread while the buffer is in
+ * use. A push made while all stamps are in use is not stamped, and so not measured.
+ *
+ * @attention Only available when built with ICIRCULARBUFFERSPSC_DWELL defined.
+ * @attention Must be done after init, before the buffer is shared between producer and consumer.
+ * @attention Stamp count is only valid if a power of 2. Give it room for as many pushes as may be queued at once.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to use.
+ * @param     pStamps[in]         Array of stampCount stamps, must stay valid while the buffer is used.
+ * @param     stampCount[in]      Number of stamps.
+ * @param     pLatency[in]        Initialized histogram to record dwell times in, may be shared by several buffers.
+ *
+ * @return
+ *      - true:  Success.
+ *      - false: Failed.
+ */
+bool ICircularBufferSpsc_TraceDwell( CircularBufferSpsc_t *pCircularBuffer, CircularBufferSpscStamp_t *pStamps,
+                                     size_t stampCount, CircularBufferLatency_t *pLatency );
+#endif
+
+/**
+ * @brief     Get number of bytes available to read from buffer.
+ *
+ * @attention May be called from either side. The value is a snapshot and may be outdated as soon as it is returned.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to use.
+ *
+ * @return
+ *      - Number of bytes available for reading.
+ */
+size_t ICircularBufferSpsc_GetCount( CircularBufferSpsc_t *pCircularBuffer );
+
+/**
+ * @brief     Peek at data in buffer without removing it. Consumer only.
+ *
+ * @attention Peek does not wrap around the end of the buffer memory. It will return at most the number of bytes
+ *            until the end of the buffer memory.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to use.
+ * @param     pData[out]          Pointer to where to start peek.
+ *
+ * @return
+ *      - Number of bytes possible to peek at.
+ */
+size_t ICircularBufferSpsc_Peek( CircularBufferSpsc_t *pCircularBuffer, uint8_t const **ppData );
+
+/**
+ * @brief     Pop data from circular buffer. Consumer only.
+ *
+ * @attention This will remove the data from the circular buffer.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to use.
+ * @param     pData[out]          Where data is to be copied to.
+ * @param     count[in]           Number of bytes to pop.
+ *
+ * @return
+ *      - Number of bytes copied/popped.
+ */
+size_t ICircularBufferSpsc_Pop( CircularBufferSpsc_t *pCircularBuffer, uint8_t *pData, size_t count );
+
+/**
+ * @brief     Push data to circular buffer. Producer only.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to use.
+ * @param     pData[in]           Where data is to be copied from.
+ * @param     count[in]           Number of bytes to push.
+ *
+ * @return
+ *      - Number of bytes copied/pushed.
+ */
+size_t ICircularBufferSpsc_Push( CircularBufferSpsc_t *pCircularBuffer, uint8_t const *pData, size_t count );
+
+/**
+ * @brief     Start a batch of deferred pushes. Producer only.
+ *
+ * @attention Until ICircularBufferSpsc_PublishBatch, the producer may only push with ICircularBufferSpsc_PushDeferred,
+ *            a plain push would overwrite the unpublished data.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to use.
+ *
+ * @return
+ *      - true:  Batch started.
+ *      - false: Failed.
+ */
+bool ICircularBufferSpsc_BeginBatch( CircularBufferSpsc_t *pCircularBuffer );
+
+/**
+ * @brief     Copy data into buffer as part of the current batch, without publishing it. Producer only.
+ *
+ * @attention Data is not visible to the consumer, and does not free up the space it takes, until the batch is
+ *            published.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to use.
+ * @param     pData[in]           Where data is to be copied from.
+ * @param     count[in]           Number of bytes to push.
+ *
+ * @return
+ *      - Number of bytes copied/pushed, all of count or nothing.
+ */
+size_t ICircularBufferSpsc_PushDeferred( CircularBufferSpsc_t *pCircularBuffer, uint8_t const *pData, size_t count );
+
+/**
+ * @brief     Publish all data pushed since ICircularBufferSpsc_BeginBatch with a single store. Producer only.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to use.
+ *
+ * @return
+ *      - Number of bytes published.
+ */
+size_t ICircularBufferSpsc_PublishBatch( CircularBufferSpsc_t *pCircularBuffer );
+
+/**
+ * @brief     Pop as many whole items as available, up to a maximum, with a single store of the read index. Consumer
+ *            only.
+ *
+ * @attention The write index is only loaded when the consumer's cached copy holds fewer than maxItems items.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to use.
+ * @param     pData[out]          Where items are to be copied to, room for maxItems items.
+ * @param     itemSize[in]        Size of each item.
+ * @param     maxItems[in]        Maximum number of items to pop.
+ *
+ * @return
+ *      - Number of items copied/popped.
+ */
+size_t ICircularBufferSpsc_PopBatch( CircularBufferSpsc_t *pCircularBuffer, uint8_t *pData, size_t itemSize,
+                                     size_t maxItems );
+
+/**
+ * @brief     Pop data from circular buffer, waiting for data if empty. Consumer only.
+ *
+ * @attention Only available when built with ICIRCULARBUFFERSPSC_WAIT defined.
+ * @attention Returns as soon as any data is available, which may be less than count.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to use.
+ * @param     pData[out]          Where data is to be copied to.
+ * @param     count[in]           Number of bytes to pop.
+ * @param     timeoutMs[in]       Longest time to wait in milliseconds, 0 (or any other negative value) to not wait
+ *                                or ICIRCULARBUFFERSPSC_WAIT_FOREVER.
+ *
+ * @return
+ *      - Number of bytes copied/popped, 0 on timeout.
+ */
+size_t ICircularBufferSpsc_PopWait( CircularBufferSpsc_t *pCircularBuffer, uint8_t *pData, size_t count, int timeoutMs );
+
+/**
+ * @brief     Push data to circular buffer, waiting for free space if full. Producer only.
+ *
+ * @attention Only available when built with ICIRCULARBUFFERSPSC_WAIT defined.
+ * @attention Returns as soon as any data could be pushed, which may be less than count.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to use.
+ * @param     pData[in]           Where data is to be copied from.
+ * @param     count[in]           Number of bytes to push.
+ * @param     timeoutMs[in]       Longest time to wait in milliseconds, 0 (or any other negative value) to not wait
+ *                                or ICIRCULARBUFFERSPSC_WAIT_FOREVER.
+ *
+ * @return
+ *      - Number of bytes copied/pushed, 0 on timeout.
+ */
+size_t ICircularBufferSpsc_PushWait( CircularBufferSpsc_t *pCircularBuffer, uint8_t const *pData, size_t count,
+                                     int timeoutMs );
+
+/**
+ * @brief     Clear circular buffer by discarding all readable data. Consumer only.
+ *
+ * @param     pCircularBuffer[in] Pointer to CircularBufferSpsc struct to clear.
+ *
+ * @return
+ *      - true:  Succesful.
+ *      - false: Failed.
+ */
+bool ICircularBufferSpsc_Clear( CircularBufferSpsc_t *pCircularBuffer );
+
+#endif  // ICIRCULARBUFFERSPSC_H
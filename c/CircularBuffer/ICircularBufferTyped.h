@@ -0,0 +1,162 @@
+/**
+ * @file      ICircularBufferTyped.h
+ * @brief     Interface header for module CircularBufferTyped.
+ *
+ * Header-only generator of circular buffers specialized for one element type and a capacity fixed at compile time.
+ * Where CircularBuffer_t counts bytes and copies with a generic memcpy of a runtime length, a typed buffer counts
+ * elements, indexes with a constant mask and copies by plain assignment, so the compiler can fold all of it into a
+ * handful of instructions. Element storage is part of the struct, no separate buffer memory is needed.
+ *
+ * ICIRCULARBUFFERTYPED_DEFINE( MsgRing, Msg_t, 64 ) defines the type MsgRing_t and the functions MsgRing_Init,
+ * MsgRing_GetCount, MsgRing_Peek, MsgRing_Pop, MsgRing_Push, MsgRing_PopN, MsgRing_PushN and MsgRing_Clear, all
+ * static inline. Like CircularBuffer_t a typed buffer is not thread safe.
+ *
+ * @version   0.0.1
+ * @date      2019
+ *
+ * @author    Simon Lövgren
+ * @copyright MIT License
+ */
+
+#ifndef ICIRCULARBUFFERTYPED_H
+#define ICIRCULARBUFFERTYPED_H
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @def   ICIRCULARBUFFERTYPED_DEFINE(name, type, capacity)
+ * @brief Define typed circular buffer name##_t holding up to capacity elements of type, and its functions.
+ *
+ * @attention Capacity is only valid if a power of 2 (64, 128, 256, 512, 1024, etc.), checked at compile time.
+ *
+ * Functions defined, with the same meaning as their ICircularBuffer counterparts but counting elements:
+ *      - bool   name##_Init( name##_t *pCircularBuffer )
+ *      - size_t name##_GetCount( name##_t const *pCircularBuffer )
+ *      - type  *name##_Peek( name##_t *pCircularBuffer ):                                 Oldest element or NULL.
+ *      - bool   name##_Pop( name##_t *pCircularBuffer, type *pElement ):                  false if empty.
+ *      - bool   name##_Push( name##_t *pCircularBuffer, type const *pElement ):           false if full.
+ *      - size_t name##_PopN( name##_t *pCircularBuffer, type *pElements, size_t count ):  Number of elements popped.
+ *      - size_t name##_PushN( name##_t *pCircularBuffer, type const *pElements, size_t count ): Number pushed.
+ *      - bool   name##_Clear( name##_t *pCircularBuffer )
+ */
+#define ICIRCULARBUFFERTYPED_DEFINE(name, type, capacity)                                                               \
+    _Static_assert( ( (capacity) >= 2 ) && ( ( (capacity) & ( (capacity) - 1 ) ) == 0 ),                                \
+                    #name ": capacity must be a power of 2" );                                                          \
+                                                                                                                        \
+    typedef struct name                                                                                                 \
+    {                                                                                                                   \
+        uint64_t write;                 /**< Free-running write position, in elements.  */                              \
+        uint64_t read;                  /**< Free-running read position, in elements.   */                              \
+        type     elements[ capacity ];  /**< Element storage.                           */                              \
+    } name##_t;                                                                                                         \
+                                                                                                                        \
+    static inline bool name##_Init( name##_t *pCircularBuffer )                                                         \
+    {                                                                                                                   \
+        if ( pCircularBuffer == NULL )                                                                                  \
+        {                                                                                                               \
+            return false;                                                                                               \
+        }                                                                                                               \
+        pCircularBuffer->write = 0;                                                                                     \
+        pCircularBuffer->read  = 0;                                                                                     \
+        return true;                                                                                                    \
+    }                                                                                                                   \
+                                                                                                                        \
+    static inline size_t name##_GetCount( name##_t const *pCircularBuffer )                                             \
+    {                                                                                                                   \
+        return ( pCircularBuffer == NULL ) ? 0 : (size_t)( pCircularBuffer->write - pCircularBuffer->read );            \
+    }                                                                                                                   \
+                                                                                                                        \
+    static inline type *name##_Peek( name##_t *pCircularBuffer )                                                        \
+    {                                                                                                                   \
+        if ( name##_GetCount( pCircularBuffer ) == 0 )                                                                  \
+        {                                                                                                               \
+            return NULL;                                                                                                \
+        }                                                                                                               \
+        return &pCircularBuffer->elements[ pCircularBuffer->read & ( (capacity) - 1 ) ];                                \
+    }                                                                                                                   \
+                                                                                                                        \
+    static inline bool name##_Pop( name##_t *pCircularBuffer, type *pElement )                                          \
+    {                                                                                                                   \
+        if ( pElement == NULL || name##_GetCount( pCircularBuffer ) == 0 )                                              \
+        {                                                                                                               \
+            return false;                                                                                               \
+        }                                                                                                               \
+        *pElement = pCircularBuffer->elements[ pCircularBuffer->read & ( (capacity) - 1 ) ];                            \
+        ++pCircularBuffer->read;                                                                                        \
+        return true;                                                                                                    \
+    }                                                                                                                   \
+                                                                                                                        \
+    static inline bool name##_Push( name##_t *pCircularBuffer, type const *pElement )                                   \
+    {                                                                                                                   \
+        if ( pCircularBuffer == NULL || pElement == NULL || name##_GetCount( pCircularBuffer ) == (capacity) )          \
+        {                                                                                                               \
+            return false;                                                                                               \
+        }                                                                                                               \
+        pCircularBuffer->elements[ pCircularBuffer->write & ( (capacity) - 1 ) ] = *pElement;                           \
+        ++pCircularBuffer->write;                                                                                       \
+        return true;                                                                                                    \
+    }                                                                                                                   \
+                                                                                                                        \
+    static inline size_t name##_PopN( name##_t *pCircularBuffer, type *pElements, size_t count )                        \
+    {                                                                                                                   \
+        size_t available = name##_GetCount( pCircularBuffer );                                                          \
+        if ( pElements == NULL || count > available )                                                                   \
+        {                                                                                                               \
+            count = ( pElements == NULL ) ? 0 : available;                                                              \
+        }                                                                                                               \
+        if ( count > 0 )                                                                                                \
+        {                                                                                                               \
+            /* Copy up to end of element storage, then the rest from the start */                                       \
+            size_t offset = (size_t)( pCircularBuffer->read & ( (capacity) - 1 ) );                                     \
+            size_t first  = ( ( (capacity) - offset ) < count ) ? ( (capacity) - offset ) : count;                      \
+            memcpy( pElements, &pCircularBuffer->elements[ offset ], first * sizeof( type ) );                          \
+            memcpy( pElements + first, &pCircularBuffer->elements[ 0 ], ( count - first ) * sizeof( type ) );           \
+            pCircularBuffer->read += count;                                                                             \
+        }                                                                                                               \
+        return count;                                                                                                   \
+    }                                                                                                                   \
+                                                                                                                        \
+    static inline size_t name##_PushN( name##_t *pCircularBuffer, type const *pElements, size_t count )                 \
+    {                                                                                                                   \
+        if ( pCircularBuffer == NULL || pElements == NULL )                                                             \
+        {                                                                                                               \
+            return 0;                                                                                                   \
+        }                                                                                                               \
+        size_t available = (capacity) - name##_GetCount( pCircularBuffer );                                             \
+        if ( count > available )                                                                                        \
+        {                                                                                                               \
+            count = available;                                                                                          \
+        }                                                                                                               \
+        if ( count > 0 )                                                                                                \
+        {                                                                                                               \
+            /* Copy up to end of element storage, then the rest to the start */                                         \
+            size_t offset = (size_t)( pCircularBuffer->write & ( (capacity) - 1 ) );                                    \
+            size_t first  = ( ( (capacity) - offset ) < count ) ? ( (capacity) - offset ) : count;                      \
+            memcpy( &pCircularBuffer->elements[ offset ], pElements, first * sizeof( type ) );                          \
+            memcpy( &pCircularBuffer->elements[ 0 ], pElements + first, ( count - first ) * sizeof( type ) );           \
+            pCircularBuffer->write += count;                                                                            \
+        }                                                                                                               \
+        return count;                                                                                                   \
+    }                                                                                                                   \
+                                                                                                                        \
+    static inline bool name##_Clear( name##_t *pCircularBuffer )                                                        \
+    {                                                                                                                   \
+        return name##_Init( pCircularBuffer );                                                                          \
+    }
+
+#endif  // ICIRCULARBUFFERTYPED_H
@@ -0,0 +1,1969 @@
+/**
+ * @file  CircularBufferBench.c
+ * @brief Benchmarks for module CircularBuffer.
+ */
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Includes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+#define _GNU_SOURCE // clock_gettime, pthread_setaffinity_np, getopt
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#endif
+
+#include "ICircularBuffer.h"
+#include "ICircularBufferSpsc.h"
+#include "ICircularBufferMpmc.h"
+#include "ICircularBufferSharded.h"
+#include "ICircularBufferLatency.h"
+#include "ICircularBufferTyped.h"
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Defines
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * @def   ARR_SIZE(x)
+ * @brief Get number of elements in array (from Googles chromium project, apparently).
+ */
+#define ARR_SIZE(x) ((sizeof(x)/sizeof(0[x])) / ((size_t)(!(sizeof(x) % sizeof(0[x])))))
+
+/**
+ * @def   BENCH_NOINLINE
+ * @brief Keep reference implementation out of line, same as the module functions called across translation units.
+ */
+#define BENCH_NOINLINE __attribute__(( noinline ))
+
+/**
+ * @def   MICRO_BUFFERS
+ * @brief Number of buffers in different fill states that GetCount is cycled over, so branches are not predictable.
+ */
+#define MICRO_BUFFERS 64
+
+/**
+ * @def   MICRO_ITERATIONS
+ * @brief Number of calls timed per microbenchmark.
+ */
+#define MICRO_ITERATIONS ( 1 << 22 )
+
+/**
+ * @def   MICRO_BUFFER_SIZE
+ * @brief Size of buffers used for microbenchmarks.
+ */
+#define MICRO_BUFFER_SIZE 4096
+
+/**
+ * @def   MICRO_CHUNK_SIZE
+ * @brief Number of bytes per Push/Pop call in microbenchmarks.
+ */
+#define MICRO_CHUNK_SIZE 16
+
+/**
+ * @def   THROUGHPUT_MIN_NS
+ * @brief Minimum time each throughput combination is run for.
+ */
+#define THROUGHPUT_MIN_NS ( 50 * 1000 * 1000 )
+
+/**
+ * @def   LATENCY_BUFFER_SIZE
+ * @brief Size of buffer used for producer-to-consumer latency.
+ */
+#define LATENCY_BUFFER_SIZE ( 64 * 1024 )
+
+/**
+ * @def   LATENCY_SAMPLES
+ * @brief Number of messages timed per latency combination.
+ */
+#define LATENCY_SAMPLES ( 100 * 1000 )
+
+/**
+ * @def   LATENCY_SPINS
+ * @brief Number of polls before a waiting latency thread yields (keeps single core machines progressing).
+ */
+#define LATENCY_SPINS 1000
+
+/**
+ * @def   SPSC_BUFFER_SIZE
+ * @brief Size of buffer used for cross-core SPSC throughput.
+ */
+#define SPSC_BUFFER_SIZE ( 64 * 1024 )
+
+/**
+ * @def   SPSC_BYTES
+ * @brief Number of bytes streamed from producer to consumer per cross-core SPSC throughput combination.
+ */
+#define SPSC_BYTES ( 256 * 1024 * 1024 )
+
+/**
+ * @def   BENCH_DEFAULT_CSV
+ * @brief Default file CSV results are written to.
+ */
+#define BENCH_DEFAULT_CSV "out/CircularBufferBench.csv"
+
+/**
+ * @def   TYPED_BUFFER_SIZE
+ * @brief Size of buffer memory in typed element benchmark, same for byte mode and every record size.
+ */
+#define TYPED_BUFFER_SIZE 4096
+
+/**
+ * @def   TYPED_BATCH
+ * @brief Number of records pushed, then popped, per round in typed element benchmark.
+ */
+#define TYPED_BATCH 16
+
+/**
+ * @def   TYPED_ITERATIONS
+ * @brief Number of records pushed and popped per variant in typed element benchmark.
+ */
+#define TYPED_ITERATIONS ( 1 << 22 )
+
+/**
+ * @def   FIND_BUFFER_SIZE
+ * @brief Size of buffer memory searched in delimiter search benchmark.
+ */
+#define FIND_BUFFER_SIZE ( 8 * 1024 * 1024 )
+
+/**
+ * @def   FIND_LINE_SIZE
+ * @brief Distance between delimiters when searching line by line in delimiter search benchmark.
+ */
+#define FIND_LINE_SIZE 80
+
+/**
+ * @def   SHARDED_MAX_THREADS
+ * @brief Largest number of producers, and of consumers, in sharded set scaling benchmark.
+ */
+#define SHARDED_MAX_THREADS 8
+
+/**
+ * @def   SHARDED_SHARD_SIZE
+ * @brief Size of buffer memory of each shard in sharded set scaling benchmark.
+ */
+#define SHARDED_SHARD_SIZE ( 64 * 1024 )
+
+/**
+ * @def   SHARDED_ELEMENT_SIZE
+ * @brief Size of elements in sharded set scaling benchmark.
+ */
+#define SHARDED_ELEMENT_SIZE 64
+
+/**
+ * @def   SHARDED_BYTES
+ * @brief Number of bytes pushed by each producer in sharded set scaling benchmark.
+ */
+#define SHARDED_BYTES ( 64 * 1024 * 1024 )
+
+/**
+ * @def   BATCH_MESSAGES
+ * @brief Number of messages passed from producer to consumer per variant in batched publication benchmark.
+ */
+#define BATCH_MESSAGES ( 4 * 1024 * 1024 )
+
+/**
+ * @def   BATCH_SIZE
+ * @brief Most messages published, or popped, at once in batched publication benchmark.
+ */
+#define BATCH_SIZE 32
+
+/**
+ * @def   BULK_BUFFER_SIZE
+ * @brief Size of staging buffer in bulk copy benchmark, larger than the caches closest to the core.
+ */
+#define BULK_BUFFER_SIZE ( 32 * 1024 * 1024 )
+
+/**
+ * @def   BULK_CHUNK_SIZE
+ * @brief Bytes pushed and popped in one call in bulk copy benchmark.
+ */
+#define BULK_CHUNK_SIZE ( 4 * 1024 * 1024 )
+
+/**
+ * @def   BULK_THRESHOLD
+ * @brief Bulk threshold of the streaming variant in bulk copy benchmark.
+ */
+#define BULK_THRESHOLD ( 256 * 1024 )
+
+/**
+ * @def   BULK_WORKING_SET
+ * @brief Size of the co-running workload's working set, sized to stay in L2 while left alone.
+ */
+#define BULK_WORKING_SET ( 256 * 1024 )
+
+/**
+ * @def   BULK_ROUNDS
+ * @brief Transfers, each followed by a walk of the working set, per variant in bulk copy benchmark.
+ */
+#define BULK_ROUNDS 64
+
+/**
+ * @def   DWELL_STAMPS
+ * @brief Number of push stamps in dwell tracing benchmark, enough for a full buffer of messages.
+ */
+#define DWELL_STAMPS ( SPSC_BUFFER_SIZE / 64 )
+
+/**
+ * @def   MPMC_MAX_THREADS
+ * @brief Largest number of producers, and of consumers, in MPMC scaling benchmark.
+ */
+#define MPMC_MAX_THREADS 8
+
+/**
+ * @def   MPMC_SLOTS
+ * @brief Number of element slots in MPMC scaling benchmark.
+ */
+#define MPMC_SLOTS 1024
+
+/**
+ * @def   MPMC_ELEMENT_SIZE
+ * @brief Size of elements in MPMC scaling benchmark.
+ */
+#define MPMC_ELEMENT_SIZE 64
+
+/**
+ * @def   MPMC_MESSAGES
+ * @brief Number of elements passed through the buffer, by all threads together, per MPMC scaling combination.
+ */
+#define MPMC_MESSAGES ( 2 * 1024 * 1024 )
+
+/**
+ * @def   MPMC_SPINS
+ * @brief Failed pushes or pops before a thread of MPMC scaling benchmark yields its core.
+ */
+#define MPMC_SPINS 1000
+
+/**
+ * @def   BENCH_TYPED_DEFINE(size)
+ * @brief Define record type of size bytes, a typed ring of them and BenchTyped<size> timing its Push and Pop.
+ */
+#define BENCH_TYPED_DEFINE(size)                                                                                        \
+    typedef struct Record##size { uint8_t data[ size ]; } Record##size##_t;                                             \
+    ICIRCULARBUFFERTYPED_DEFINE( TypedRing##size, Record##size##_t, TYPED_BUFFER_SIZE / size )                          \
+                                                                                                                        \
+    void BenchTyped##size( void )                                                                                       \
+    {                                                                                                                   \
+        static TypedRing##size##_t ring;                                                                                \
+        Record##size##_t           record   = { { 0 } };                                                                \
+        uint64_t                   pushTime = 0;                                                                        \
+        uint64_t                   popTime  = 0;                                                                        \
+        size_t                     sum      = 0;                                                                        \
+                                                                                                                        \
+        TypedRing##size##_Init( &ring );                                                                                \
+        for ( size_t i = 0; i < TYPED_ITERATIONS; i += TYPED_BATCH )                                                    \
+        {                                                                                                               \
+            uint64_t start = BenchTimestamp();                                                                          \
+            for ( size_t n = 0; n < TYPED_BATCH; ++n )                                                                  \
+            {                                                                                                           \
+                record.data[ 0 ] = (uint8_t)n;                                                                          \
+                sum += TypedRing##size##_Push( &ring, &record );                                                        \
+            }                                                                                                           \
+            pushTime += BenchTimestamp() - start;                                                                       \
+                                                                                                                        \
+            start = BenchTimestamp();                                                                                   \
+            for ( size_t n = 0; n < TYPED_BATCH; ++n )                                                                  \
+            {                                                                                                           \
+                sum += TypedRing##size##_Pop( &ring, &record );                                                         \
+                sum += record.data[ size - 1 ];                                                                         \
+            }                                                                                                           \
+            popTime += BenchTimestamp() - start;                                                                        \
+        }                                                                                                               \
+                                                                                                                        \
+        BenchReport( "typed", "typed", TYPED_BUFFER_SIZE, size, "Push",                                                 \
+                     (double)pushTime / TYPED_ITERATIONS, BenchTimestampUnit() );                                       \
+        BenchReport( "typed", "typed", TYPED_BUFFER_SIZE, size, "Pop",                                                  \
+                     (double)popTime / TYPED_ITERATIONS, BenchTimestampUnit() );                                        \
+        benchSink = sum;                                                                                                \
+    }
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Types
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * Reference circular buffer with the previous pointer based layout, kept to compare against
+ */
+typedef struct LegacyCircularBuffer
+{
+    uint8_t *pWrite;    /**< Pointer to where in buffer writer should write to.  */
+    uint8_t *pRead;     /**< Pointer to where in buffer reader should read from. */
+    uint8_t *pBuffer;   /**< Pointer to allocated buffer.                        */
+    size_t  bufferSize; /**< Size of buffer.                                     */
+} LegacyCircularBuffer_t;
+
+/**
+ * Reference SPSC buffer with the previous layout, both indices and constants sharing one cache line
+ */
+typedef struct PackedSpsc
+{
+    atomic_size_t write;      /**< Free-running write index, only stored by producer. */
+    atomic_size_t read;       /**< Free-running read index, only stored by consumer.  */
+    uint8_t       *pBuffer;   /**< Pointer to allocated buffer.                       */
+    size_t        bufferSize; /**< Size of buffer.                                    */
+} PackedSpsc_t;
+
+/**
+ * Benchmark that can be selected from the command line
+ */
+typedef struct BenchSuite
+{
+    char const *pName;            /**< Name used with -s.       */
+    void       ( *pRun )( void ); /**< Function running suite.  */
+} BenchSuite_t;
+
+/**
+ * Delimiter search being compared, finding the next delimiter at or after from
+ */
+typedef bool ( *FindFunction_t )( CircularBuffer_t *pCircularBuffer, size_t from, size_t *pOffset );
+
+/**
+ * Shared state of producer and consumer thread in latency benchmark
+ */
+typedef struct LatencyArg
+{
+    CircularBufferSpsc_t *pCircularBuffer; /**< Buffer messages are passed through.   */
+    size_t               chunkSize;        /**< Size of every message.                */
+    int                  core;             /**< Core to pin thread to, -1 for none.   */
+    uint64_t             *pSamples;        /**< Measured latencies, consumer only.    */
+} LatencyArg_t;
+
+/**
+ * State of producer or consumer thread in cross-core SPSC throughput benchmark
+ */
+typedef struct SpscArg
+{
+    CircularBufferSpsc_t *pCircularBuffer; /**< Buffer with separated layout, or NULL.  */
+    PackedSpsc_t         *pPacked;         /**< Buffer with packed layout, or NULL.     */
+    size_t               chunkSize;        /**< Bytes per push/pop call.                */
+    int                  core;             /**< Core to pin thread to, -1 for none.     */
+} SpscArg_t;
+
+/**
+ * State of producer or consumer thread in sharded set scaling benchmark, on a cache line of its own so the counts
+ * consumers keep do not share one
+ */
+typedef struct ShardedArg
+{
+    _Alignas( ICIRCULARBUFFERSPSC_CACHE_LINE_SIZE )
+    CircularBufferSharded_t *pSharded;   /**< Set data is passed through.                 */
+    size_t                  index;       /**< Index of consumer, unused by producers.     */
+    size_t                  producers;   /**< Producers in the set.                       */
+    atomic_size_t           *pDetached;  /**< Producers done and detached so far.         */
+    size_t                  consumed;    /**< Bytes popped by this consumer.              */
+    uint8_t                 sink;        /**< Last chunk popped, summed into benchSink.   */
+    int                     core;        /**< Core to pin thread to, -1 for none.         */
+} ShardedArg_t;
+
+/**
+ * State of producer or consumer thread in batched publication benchmark
+ */
+typedef struct BatchArg
+{
+    CircularBufferSpsc_t *pCircularBuffer; /**< Buffer messages are passed through.              */
+    size_t               messageSize;      /**< Size of every message.                           */
+    bool                 batched;          /**< Use batch calls instead of one call per message. */
+    int                  core;             /**< Core to pin thread to, -1 for none.              */
+} BatchArg_t;
+
+/**
+ * State of producer or consumer thread in MPMC scaling benchmark
+ */
+typedef struct MpmcArg
+{
+    CircularBufferMpmc_t *pMpmc;    /**< Lock-free buffer, NULL to use the mutex guarded one.  */
+    CircularBuffer_t     *pLocked;  /**< Mutex guarded buffer.                                  */
+    pthread_mutex_t      *pMutex;   /**< Mutex guarding pLocked.                                */
+    size_t               messages;  /**< Elements this thread pushes or pops.                   */
+    uint8_t              sink;      /**< Last element popped, summed into benchSink.            */
+    int                  core;      /**< Core to pin thread to, -1 for none.                    */
+} MpmcArg_t;
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Prototypes
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+uint64_t BenchTimestamp( void );
+char const *BenchTimestampUnit( void );
+uint64_t BenchNanoseconds( void );
+void BenchReport( char const *pBenchmark, char const *pVariant, size_t bufferSize, size_t chunkSize,
+                  char const *pMetric, double value, char const *pUnit );
+void BenchPin( int core );
+int BenchCompareU64( void const *pA, void const *pB );
+
+void   Legacy_Init( LegacyCircularBuffer_t *pCircularBuffer, uint8_t *pBuffer, size_t bufferSize );
+size_t Legacy_GetCount( LegacyCircularBuffer_t *pCircularBuffer );
+size_t Legacy_Pop( LegacyCircularBuffer_t *pCircularBuffer, uint8_t *pData, size_t count );
+size_t Legacy_Push( LegacyCircularBuffer_t *pCircularBuffer, uint8_t *pData, size_t count );
+
+void   Packed_Init( PackedSpsc_t *pCircularBuffer, uint8_t *pBuffer, size_t bufferSize );
+size_t Packed_Pop( PackedSpsc_t *pCircularBuffer, uint8_t *pData, size_t count );
+size_t Packed_Push( PackedSpsc_t *pCircularBuffer, uint8_t const *pData, size_t count );
+
+void BenchMicro( void );
+void BenchThroughput( void );
+void BenchLatency( void );
+void BenchSpsc( void );
+void BenchTypedBytes( size_t recordSize );
+void BenchTyped8( void );
+void BenchTyped32( void );
+void BenchTyped128( void );
+void BenchTyped( void );
+
+bool Naive_Find( CircularBuffer_t *pCircularBuffer, size_t from, size_t *pOffset );
+bool Simd_Find( CircularBuffer_t *pCircularBuffer, size_t from, size_t *pOffset );
+bool Simd_FindPattern( CircularBuffer_t *pCircularBuffer, size_t from, size_t *pOffset );
+void BenchFindScan( char const *pVariant, FindFunction_t find, CircularBuffer_t *pCircularBuffer, size_t lineSize );
+void BenchFind( void );
+
+void BenchSharded( void );
+
+void BenchBatch( void );
+
+void BenchBulkVariant( char const *pVariant, CircularBuffer_t *pCircularBuffer, uint8_t *pChunk, size_t const *pWorkingSet,
+                       bool transfer );
+void BenchBulk( void );
+
+#ifdef ICIRCULARBUFFERSPSC_DWELL
+void BenchDwell( void );
+#endif
+
+void BenchMpmc( void );
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Variables
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * Sink for results, so the compiler cannot drop the calls being timed.
+ */
+volatile size_t benchSink;
+
+/**
+ * Where CSV rows are written.
+ */
+FILE *pBenchCsv = NULL;
+
+/**
+ * Cores producer and consumer threads are pinned to, -1 for none.
+ */
+int benchProducerCore = 0;
+int benchConsumerCore = 1;
+
+/**
+ * All benchmarks, in the order they are run.
+ */
+BenchSuite_t const benchSuites[] = {
+    { "micro",      BenchMicro      },
+    { "throughput", BenchThroughput },
+    { "latency",    BenchLatency    },
+    { "spsc",       BenchSpsc       },
+    { "typed",      BenchTyped      },
+    { "find",       BenchFind       },
+    { "sharded",    BenchSharded    },
+    { "batch",      BenchBatch      },
+    { "bulk",       BenchBulk       },
+#ifdef ICIRCULARBUFFERSPSC_DWELL
+    { "dwell",      BenchDwell      },
+#endif
+    { "mpmc",       BenchMpmc       },
+};
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Functions
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+uint64_t BenchTimestamp( void )
+{
+#if defined( __x86_64__ ) || defined( __i386__ )
+    return __rdtsc();
+#else
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return ( (uint64_t)now.tv_sec * 1000000000u ) + (uint64_t)now.tv_nsec;
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+char const *BenchTimestampUnit( void )
+{
+#if defined( __x86_64__ ) || defined( __i386__ )
+    return "cycles";
+#else
+    return "ns";
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+uint64_t BenchNanoseconds( void )
+{
+    struct timespec now;
+    clock_gettime( CLOCK_MONOTONIC, &now );
+    return ( (uint64_t)now.tv_sec * 1000000000u ) + (uint64_t)now.tv_nsec;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void BenchReport( char const *pBenchmark, char const *pVariant, size_t bufferSize, size_t chunkSize,
+                  char const *pMetric, double value, char const *pUnit )
+{
+    printf( "%-12s %-16s %10zu %8zu %-20s %16.2f %s\n", pBenchmark, pVariant, bufferSize, chunkSize, pMetric, value, pUnit );
+    if ( pBenchCsv != NULL )
+    {
+        fprintf( pBenchCsv, "%s,%s,%zu,%zu,%s,%.3f,%s\n", pBenchmark, pVariant, bufferSize, chunkSize, pMetric, value, pUnit );
+    }
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void BenchPin( int core )
+{
+    if ( core < 0 )
+    {
+        return;
+    }
+
+    cpu_set_t cpus;
+    CPU_ZERO( &cpus );
+    CPU_SET( core, &cpus );
+    if ( pthread_setaffinity_np( pthread_self(), sizeof( cpus ), &cpus ) != 0 )
+    {
+        fprintf( stderr, "Could not pin thread to core %d, running unpinned\n", core );
+    }
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int BenchCompareU64( void const *pA, void const *pB )
+{
+    uint64_t a = *(uint64_t const*)pA;
+    uint64_t b = *(uint64_t const*)pB;
+
+    return ( a > b ) - ( a < b );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+BENCH_NOINLINE void Legacy_Init( LegacyCircularBuffer_t *pCircularBuffer, uint8_t *pBuffer, size_t bufferSize )
+{
+    pCircularBuffer->bufferSize = bufferSize;
+    pCircularBuffer->pBuffer    = pBuffer;
+    pCircularBuffer->pWrite     = pBuffer;
+    pCircularBuffer->pRead      = pBuffer;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+BENCH_NOINLINE size_t Legacy_GetCount( LegacyCircularBuffer_t *pCircularBuffer )
+{
+    size_t count = 0;
+    if ( pCircularBuffer->pWrite >= pCircularBuffer->pRead )
+    {
+        count = ( pCircularBuffer->pWrite - pCircularBuffer->pRead );
+    }
+    else
+    {
+        count = ( ( pCircularBuffer->pBuffer + pCircularBuffer->bufferSize ) - pCircularBuffer->pRead );
+        count += ( pCircularBuffer->pWrite - pCircularBuffer->pBuffer );
+    }
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+BENCH_NOINLINE size_t Legacy_Pop( LegacyCircularBuffer_t *pCircularBuffer, uint8_t *pData, size_t count )
+{
+    size_t available = Legacy_GetCount( pCircularBuffer );
+    if ( count > available )
+    {
+        count = available;
+    }
+
+    size_t popped = 0;
+    while ( popped < count )
+    {
+        size_t chunk = 0;
+        if ( pCircularBuffer->pRead <= pCircularBuffer->pWrite )
+        {
+            chunk = ( pCircularBuffer->pWrite - pCircularBuffer->pRead );
+        }
+        else
+        {
+            chunk = ( ( pCircularBuffer->pBuffer + pCircularBuffer->bufferSize ) - pCircularBuffer->pRead );
+        }
+        if ( chunk > ( count - popped ) )
+        {
+            chunk = ( count - popped );
+        }
+
+        memcpy( pData + popped, pCircularBuffer->pRead, chunk );
+        popped                 += chunk;
+        pCircularBuffer->pRead += chunk;
+        if ( pCircularBuffer->pRead == ( pCircularBuffer->pBuffer + pCircularBuffer->bufferSize ) )
+        {
+            pCircularBuffer->pRead = pCircularBuffer->pBuffer;
+        }
+    }
+
+    return popped;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+BENCH_NOINLINE size_t Legacy_Push( LegacyCircularBuffer_t *pCircularBuffer, uint8_t *pData, size_t count )
+{
+    size_t available = ( pCircularBuffer->bufferSize - 1 ) - Legacy_GetCount( pCircularBuffer );
+    if ( count > available )
+    {
+        count = available;
+    }
+
+    size_t pushed = 0;
+    while ( pushed < count )
+    {
+        size_t chunk = ( ( pCircularBuffer->pBuffer + pCircularBuffer->bufferSize ) - pCircularBuffer->pWrite );
+        if ( chunk > ( count - pushed ) )
+        {
+            chunk = ( count - pushed );
+        }
+
+        memcpy( pCircularBuffer->pWrite, pData + pushed, chunk );
+        pushed                  += chunk;
+        pCircularBuffer->pWrite += chunk;
+        if ( pCircularBuffer->pWrite == ( pCircularBuffer->pBuffer + pCircularBuffer->bufferSize ) )
+        {
+            pCircularBuffer->pWrite = pCircularBuffer->pBuffer;
+        }
+    }
+
+    return pushed;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+BENCH_NOINLINE void Packed_Init( PackedSpsc_t *pCircularBuffer, uint8_t *pBuffer, size_t bufferSize )
+{
+    pCircularBuffer->bufferSize = bufferSize;
+    pCircularBuffer->pBuffer    = pBuffer;
+    atomic_init( &pCircularBuffer->write, 0 );
+    atomic_init( &pCircularBuffer->read,  0 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+BENCH_NOINLINE size_t Packed_Pop( PackedSpsc_t *pCircularBuffer, uint8_t *pData, size_t count )
+{
+    size_t read  = atomic_load_explicit( &pCircularBuffer->read,  memory_order_relaxed );
+    size_t write = atomic_load_explicit( &pCircularBuffer->write, memory_order_acquire );
+
+    size_t available = ( write - read );
+    if ( count > available )
+    {
+        count = available;
+    }
+
+    if ( count > 0 )
+    {
+        size_t offset = ( read & ( pCircularBuffer->bufferSize - 1 ) );
+        size_t first  = ( pCircularBuffer->bufferSize - offset );
+        if ( first > count )
+        {
+            first = count;
+        }
+
+        memcpy( pData, pCircularBuffer->pBuffer + offset, first );
+        memcpy( pData + first, pCircularBuffer->pBuffer, count - first );
+        atomic_store_explicit( &pCircularBuffer->read, read + count, memory_order_release );
+    }
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+BENCH_NOINLINE size_t Packed_Push( PackedSpsc_t *pCircularBuffer, uint8_t const *pData, size_t count )
+{
+    size_t write = atomic_load_explicit( &pCircularBuffer->write, memory_order_relaxed );
+    size_t read  = atomic_load_explicit( &pCircularBuffer->read,  memory_order_acquire );
+
+    size_t available = ( pCircularBuffer->bufferSize - ( write - read ) );
+    if ( count > available )
+    {
+        count = available;
+    }
+
+    if ( count > 0 )
+    {
+        size_t offset = ( write & ( pCircularBuffer->bufferSize - 1 ) );
+        size_t first  = ( pCircularBuffer->bufferSize - offset );
+        if ( first > count )
+        {
+            first = count;
+        }
+
+        memcpy( pCircularBuffer->pBuffer + offset, pData, first );
+        memcpy( pCircularBuffer->pBuffer, pData + first, count - first );
+        atomic_store_explicit( &pCircularBuffer->write, write + count, memory_order_release );
+    }
+
+    return count;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void BenchMicro( void )
+{
+    static uint8_t         memory[ MICRO_BUFFERS ][ MICRO_BUFFER_SIZE ];
+    static uint8_t         legacyMemory[ MICRO_BUFFERS ][ MICRO_BUFFER_SIZE ];
+    static uint8_t         order[ 4096 ];
+    CircularBuffer_t       buffers[ MICRO_BUFFERS ];
+    LegacyCircularBuffer_t legacyBuffers[ MICRO_BUFFERS ];
+    uint8_t                chunk[ MICRO_CHUNK_SIZE * 2 ];
+    uint64_t               start;
+    size_t                 sum;
+
+    // Leave buffers in random fill states, half of them wrapped
+    srand( 1 );
+    for ( size_t i = 0; i < MICRO_BUFFERS; ++i )
+    {
+        ICircularBuffer_Init( &buffers[ i ], memory[ i ], MICRO_BUFFER_SIZE );
+        Legacy_Init( &legacyBuffers[ i ], legacyMemory[ i ], MICRO_BUFFER_SIZE );
+
+        size_t offset = (size_t)rand() % MICRO_BUFFER_SIZE;
+        size_t fill   = (size_t)rand() % MICRO_BUFFER_SIZE;
+        for ( size_t n = 0; n < offset; n += MICRO_CHUNK_SIZE )
+        {
+            ICircularBuffer_Push( &buffers[ i ], chunk, MICRO_CHUNK_SIZE );
+            ICircularBuffer_Pop( &buffers[ i ], chunk, MICRO_CHUNK_SIZE );
+            Legacy_Push( &legacyBuffers[ i ], chunk, MICRO_CHUNK_SIZE );
+            Legacy_Pop( &legacyBuffers[ i ], chunk, MICRO_CHUNK_SIZE );
+        }
+        for ( size_t n = 0; n < fill; n += MICRO_CHUNK_SIZE )
+        {
+            ICircularBuffer_Push( &buffers[ i ], chunk, MICRO_CHUNK_SIZE );
+            Legacy_Push( &legacyBuffers[ i ], chunk, MICRO_CHUNK_SIZE );
+        }
+    }
+    for ( size_t i = 0; i < ARR_SIZE( order ); ++i )
+    {
+        order[ i ] = (uint8_t)( (size_t)rand() % MICRO_BUFFERS );
+    }
+
+    // GetCount
+    sum   = 0;
+    start = BenchTimestamp();
+    for ( size_t i = 0; i < MICRO_ITERATIONS; ++i )
+    {
+        sum += Legacy_GetCount( &legacyBuffers[ order[ i % ARR_SIZE( order ) ] ] );
+    }
+    BenchReport( "micro", "pointers", MICRO_BUFFER_SIZE, 0, "GetCount",
+                 (double)( BenchTimestamp() - start ) / MICRO_ITERATIONS, BenchTimestampUnit() );
+    benchSink = sum;
+
+    sum   = 0;
+    start = BenchTimestamp();
+    for ( size_t i = 0; i < MICRO_ITERATIONS; ++i )
+    {
+        sum += ICircularBuffer_GetCount( &buffers[ order[ i % ARR_SIZE( order ) ] ] );
+    }
+    BenchReport( "micro", "counters", MICRO_BUFFER_SIZE, 0, "GetCount",
+                 (double)( BenchTimestamp() - start ) / MICRO_ITERATIONS, BenchTimestampUnit() );
+    benchSink = sum;
+
+    // Push and Pop of small chunks, with the odd chunk size every position in the buffer is eventually hit
+    uint64_t pushTime = 0;
+    uint64_t popTime  = 0;
+    sum = 0;
+    Legacy_Init( &legacyBuffers[ 0 ], legacyMemory[ 0 ], MICRO_BUFFER_SIZE );
+    for ( size_t i = 0; i < MICRO_ITERATIONS; i += 128 )
+    {
+        start = BenchTimestamp();
+        for ( size_t n = 0; n < 128; ++n )
+        {
+            sum += Legacy_Push( &legacyBuffers[ 0 ], chunk, MICRO_CHUNK_SIZE + 1 );
+        }
+        pushTime += BenchTimestamp() - start;
+
+        start = BenchTimestamp();
+        for ( size_t n = 0; n < 128; ++n )
+        {
+            sum += Legacy_Pop( &legacyBuffers[ 0 ], chunk, MICRO_CHUNK_SIZE + 1 );
+        }
+        popTime += BenchTimestamp() - start;
+    }
+    BenchReport( "micro", "pointers", MICRO_BUFFER_SIZE, MICRO_CHUNK_SIZE + 1, "Push",
+                 (double)pushTime / MICRO_ITERATIONS, BenchTimestampUnit() );
+    BenchReport( "micro", "pointers", MICRO_BUFFER_SIZE, MICRO_CHUNK_SIZE + 1, "Pop",
+                 (double)popTime / MICRO_ITERATIONS, BenchTimestampUnit() );
+    benchSink = sum;
+
+    pushTime = 0;
+    popTime  = 0;
+    sum      = 0;
+    ICircularBuffer_Init( &buffers[ 0 ], memory[ 0 ], MICRO_BUFFER_SIZE );
+    for ( size_t i = 0; i < MICRO_ITERATIONS; i += 128 )
+    {
+        start = BenchTimestamp();
+        for ( size_t n = 0; n < 128; ++n )
+        {
+            sum += ICircularBuffer_Push( &buffers[ 0 ], chunk, MICRO_CHUNK_SIZE + 1 );
+        }
+        pushTime += BenchTimestamp() - start;
+
+        start = BenchTimestamp();
+        for ( size_t n = 0; n < 128; ++n )
+        {
+            sum += ICircularBuffer_Pop( &buffers[ 0 ], chunk, MICRO_CHUNK_SIZE + 1 );
+        }
+        popTime += BenchTimestamp() - start;
+    }
+    BenchReport( "micro", "counters", MICRO_BUFFER_SIZE, MICRO_CHUNK_SIZE + 1, "Push",
+                 (double)pushTime / MICRO_ITERATIONS, BenchTimestampUnit() );
+    BenchReport( "micro", "counters", MICRO_BUFFER_SIZE, MICRO_CHUNK_SIZE + 1, "Pop",
+                 (double)popTime / MICRO_ITERATIONS, BenchTimestampUnit() );
+    benchSink = sum;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void BenchThroughput( void )
+{
+    static size_t const bufferSizes[] = { 64, 256, 1024, 4096, 16384, 65536, 262144, 1048576, 4194304, 16777216 };
+    static size_t const chunkSizes[]  = { 1, 4, 16, 64, 256, 1024, 4096, 16384, 65536 };
+
+    uint8_t *pMemory = malloc( bufferSizes[ ARR_SIZE( bufferSizes ) - 1 ] );
+    uint8_t *pChunk  = malloc( chunkSizes[ ARR_SIZE( chunkSizes ) - 1 ] );
+    if ( pMemory == NULL || pChunk == NULL )
+    {
+        fprintf( stderr, "Out of memory\n" );
+        free( pMemory );
+        free( pChunk );
+        return;
+    }
+    memset( pChunk, 0x5A, chunkSizes[ ARR_SIZE( chunkSizes ) - 1 ] );
+
+    for ( size_t b = 0; b < ARR_SIZE( bufferSizes ); ++b )
+    {
+        for ( size_t c = 0; c < ARR_SIZE( chunkSizes ) && chunkSizes[ c ] <= bufferSizes[ b ] / 2; ++c )
+        {
+            CircularBuffer_t circularBuffer;
+            size_t           chunkSize = chunkSizes[ c ];
+            uint64_t         bytes     = 0;
+
+            ICircularBuffer_Init( &circularBuffer, pMemory, bufferSizes[ b ] );
+
+            // Keep buffer half full, so data travels through all of the buffer memory
+            while ( ICircularBuffer_GetCount( &circularBuffer ) < ( bufferSizes[ b ] / 2 ) )
+            {
+                ICircularBuffer_Push( &circularBuffer, pChunk, chunkSize );
+            }
+
+            uint64_t start   = BenchNanoseconds();
+            uint64_t elapsed = 0;
+            do
+            {
+                for ( size_t i = 0; i < 256; ++i )
+                {
+                    bytes += ICircularBuffer_Push( &circularBuffer, pChunk, chunkSize );
+                    bytes += ICircularBuffer_Pop( &circularBuffer, pChunk, chunkSize );
+                }
+                elapsed = BenchNanoseconds() - start;
+            } while ( elapsed < THROUGHPUT_MIN_NS );
+
+            // Bytes counted on both sides, every byte is pushed once and popped once
+            BenchReport( "throughput", "CircularBuffer", bufferSizes[ b ], chunkSize, "bytes_per_second",
+                         ( (double)bytes / 2 ) * 1e9 / (double)elapsed, "B/s" );
+        }
+    }
+
+    free( pMemory );
+    free( pChunk );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *LatencyProducer( void *pArg )
+{
+    LatencyArg_t *pLatencyArg = (LatencyArg_t*)pArg;
+    uint8_t      message[ 4096 ];
+
+    BenchPin( pLatencyArg->core );
+    memset( message, 0, sizeof( message ) );
+
+    for ( size_t i = 0; i < LATENCY_SAMPLES; ++i )
+    {
+        // One message in flight at a time, so queueing in the buffer does not add to the latency
+        for ( size_t spins = 0; ICircularBufferSpsc_GetCount( pLatencyArg->pCircularBuffer ) > 0; ++spins )
+        {
+            if ( spins > LATENCY_SPINS )
+            {
+                sched_yield();
+            }
+        }
+
+        uint64_t now = BenchNanoseconds();
+        memcpy( message, &now, sizeof( now ) );
+        ICircularBufferSpsc_Push( pLatencyArg->pCircularBuffer, message, pLatencyArg->chunkSize );
+    }
+
+    return NULL;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *LatencyConsumer( void *pArg )
+{
+    LatencyArg_t *pLatencyArg = (LatencyArg_t*)pArg;
+    uint8_t      message[ 4096 ];
+
+    BenchPin( pLatencyArg->core );
+
+    for ( size_t i = 0; i < LATENCY_SAMPLES; ++i )
+    {
+        for ( size_t spins = 0; ICircularBufferSpsc_GetCount( pLatencyArg->pCircularBuffer ) < pLatencyArg->chunkSize; ++spins )
+        {
+            if ( spins > LATENCY_SPINS )
+            {
+                sched_yield();
+            }
+        }
+
+        ICircularBufferSpsc_Pop( pLatencyArg->pCircularBuffer, message, pLatencyArg->chunkSize );
+
+        uint64_t sent;
+        memcpy( &sent, message, sizeof( sent ) );
+        pLatencyArg->pSamples[ i ] = BenchNanoseconds() - sent;
+    }
+
+    return NULL;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void BenchLatency( void )
+{
+    static size_t const  chunkSizes[] = { 8, 64, 512, 4096 };
+    static uint8_t       memory[ LATENCY_BUFFER_SIZE ];
+    static uint64_t      samples[ LATENCY_SAMPLES ];
+    CircularBufferSpsc_t circularBuffer;
+
+    for ( size_t c = 0; c < ARR_SIZE( chunkSizes ); ++c )
+    {
+        pthread_t    producer;
+        pthread_t    consumer;
+        LatencyArg_t producerArg = { &circularBuffer, chunkSizes[ c ], benchProducerCore, NULL };
+        LatencyArg_t consumerArg = { &circularBuffer, chunkSizes[ c ], benchConsumerCore, samples };
+
+        ICircularBufferSpsc_Init( &circularBuffer, memory, sizeof( memory ) );
+        pthread_create( &consumer, NULL, LatencyConsumer, &consumerArg );
+        pthread_create( &producer, NULL, LatencyProducer, &producerArg );
+        pthread_join( producer, NULL );
+        pthread_join( consumer, NULL );
+
+        qsort( samples, LATENCY_SAMPLES, sizeof( samples[ 0 ] ), BenchCompareU64 );
+        BenchReport( "latency", "CircularBufferSpsc", sizeof( memory ), chunkSizes[ c ], "p50",
+                     (double)samples[ ( LATENCY_SAMPLES * 50 ) / 100 ], "ns" );
+        BenchReport( "latency", "CircularBufferSpsc", sizeof( memory ), chunkSizes[ c ], "p99",
+                     (double)samples[ ( LATENCY_SAMPLES * 99 ) / 100 ], "ns" );
+        BenchReport( "latency", "CircularBufferSpsc", sizeof( memory ), chunkSizes[ c ], "p999",
+                     (double)samples[ ( LATENCY_SAMPLES * 999 ) / 1000 ], "ns" );
+    }
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *SpscProducer( void *pArg )
+{
+    SpscArg_t *pSpscArg = (SpscArg_t*)pArg;
+    uint8_t   chunk[ 4096 ];
+    size_t    sent      = 0;
+    size_t    spins     = 0;
+
+    BenchPin( pSpscArg->core );
+    memset( chunk, 0x5A, sizeof( chunk ) );
+
+    while ( sent < SPSC_BYTES )
+    {
+        size_t count = ( pSpscArg->pPacked != NULL )
+                     ? Packed_Push( pSpscArg->pPacked, chunk, pSpscArg->chunkSize )
+                     : ICircularBufferSpsc_Push( pSpscArg->pCircularBuffer, chunk, pSpscArg->chunkSize );
+        if ( count == 0 && ++spins > LATENCY_SPINS )
+        {
+            spins = 0;
+            sched_yield();
+        }
+        sent += count;
+    }
+
+    return NULL;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *SpscConsumer( void *pArg )
+{
+    SpscArg_t *pSpscArg = (SpscArg_t*)pArg;
+    uint8_t   chunk[ 4096 ];
+    size_t    received  = 0;
+    size_t    spins     = 0;
+
+    BenchPin( pSpscArg->core );
+
+    while ( received < SPSC_BYTES )
+    {
+        size_t count = ( pSpscArg->pPacked != NULL )
+                     ? Packed_Pop( pSpscArg->pPacked, chunk, pSpscArg->chunkSize )
+                     : ICircularBufferSpsc_Pop( pSpscArg->pCircularBuffer, chunk, pSpscArg->chunkSize );
+        if ( count == 0 && ++spins > LATENCY_SPINS )
+        {
+            spins = 0;
+            sched_yield();
+        }
+        received += count;
+    }
+
+    benchSink += chunk[ 0 ];
+
+    return NULL;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void BenchSpsc( void )
+{
+    static size_t const         chunkSizes[] = { 8, 64, 512, 4096 };
+    static uint8_t              memory[ SPSC_BUFFER_SIZE ];
+    static PackedSpsc_t         packed;
+    static CircularBufferSpsc_t separated;
+
+    for ( size_t c = 0; c < ARR_SIZE( chunkSizes ); ++c )
+    {
+        for ( int layout = 0; layout < 2; ++layout )
+        {
+            pthread_t producer;
+            pthread_t consumer;
+            SpscArg_t producerArg = { &separated, ( layout == 0 ) ? &packed : NULL, chunkSizes[ c ], benchProducerCore };
+            SpscArg_t consumerArg = { &separated, ( layout == 0 ) ? &packed : NULL, chunkSizes[ c ], benchConsumerCore };
+
+            Packed_Init( &packed, memory, sizeof( memory ) );
+            ICircularBufferSpsc_Init( &separated, memory, sizeof( memory ) );
+
+            uint64_t start = BenchNanoseconds();
+            pthread_create( &consumer, NULL, SpscConsumer, &consumerArg );
+            pthread_create( &producer, NULL, SpscProducer, &producerArg );
+            pthread_join( producer, NULL );
+            pthread_join( consumer, NULL );
+            uint64_t elapsed = BenchNanoseconds() - start;
+
+            BenchReport( "spsc", ( layout == 0 ) ? "packed" : "separated", sizeof( memory ), chunkSizes[ c ],
+                         "bytes_per_second", (double)SPSC_BYTES * 1e9 / (double)elapsed, "B/s" );
+        }
+    }
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void BenchTypedBytes( size_t recordSize )
+{
+    static uint8_t   memory[ TYPED_BUFFER_SIZE ];
+    CircularBuffer_t circularBuffer;
+    uint8_t          record[ 128 ] = { 0 };
+    uint64_t         pushTime      = 0;
+    uint64_t         popTime       = 0;
+    size_t           sum           = 0;
+
+    // Same access pattern as the typed rings, one record per call
+    ICircularBuffer_Init( &circularBuffer, memory, sizeof( memory ) );
+    for ( size_t i = 0; i < TYPED_ITERATIONS; i += TYPED_BATCH )
+    {
+        uint64_t start = BenchTimestamp();
+        for ( size_t n = 0; n < TYPED_BATCH; ++n )
+        {
+            record[ 0 ] = (uint8_t)n;
+            sum += ICircularBuffer_Push( &circularBuffer, record, recordSize );
+        }
+        pushTime += BenchTimestamp() - start;
+
+        start = BenchTimestamp();
+        for ( size_t n = 0; n < TYPED_BATCH; ++n )
+        {
+            sum += ICircularBuffer_Pop( &circularBuffer, record, recordSize );
+            sum += record[ recordSize - 1 ];
+        }
+        popTime += BenchTimestamp() - start;
+    }
+
+    BenchReport( "typed", "bytes", TYPED_BUFFER_SIZE, recordSize, "Push",
+                 (double)pushTime / TYPED_ITERATIONS, BenchTimestampUnit() );
+    BenchReport( "typed", "bytes", TYPED_BUFFER_SIZE, recordSize, "Pop",
+                 (double)popTime / TYPED_ITERATIONS, BenchTimestampUnit() );
+    benchSink = sum;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+BENCH_TYPED_DEFINE( 8 )
+BENCH_TYPED_DEFINE( 32 )
+BENCH_TYPED_DEFINE( 128 )
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void BenchTyped( void )
+{
+    BenchTypedBytes( 8 );
+    BenchTyped8();
+    BenchTypedBytes( 32 );
+    BenchTyped32();
+    BenchTypedBytes( 128 );
+    BenchTyped128();
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+BENCH_NOINLINE bool Naive_Find( CircularBuffer_t *pCircularBuffer, size_t from, size_t *pOffset )
+{
+    CircularBufferSegment_t segments[ ICIRCULARBUFFER_SEGMENT_COUNT ];
+    size_t                  offset = 0;
+
+    // What callers did before Find, a byte at a time through both segments
+    ICircularBuffer_PeekV( pCircularBuffer, segments );
+    for ( size_t s = 0; s < ICIRCULARBUFFER_SEGMENT_COUNT; ++s )
+    {
+        size_t i = ( from > offset ) ? ( from - offset ) : 0;
+        for ( ; i < segments[ s ].size; ++i )
+        {
+            if ( segments[ s ].pData[ i ] == '\n' )
+            {
+                *pOffset = offset + i;
+                return true;
+            }
+        }
+        offset += segments[ s ].size;
+    }
+
+    return false;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+BENCH_NOINLINE bool Simd_Find( CircularBuffer_t *pCircularBuffer, size_t from, size_t *pOffset )
+{
+    return ICircularBuffer_Find( pCircularBuffer, '\n', from, pOffset );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+BENCH_NOINLINE bool Simd_FindPattern( CircularBuffer_t *pCircularBuffer, size_t from, size_t *pOffset )
+{
+    static uint8_t const pattern[] = { '\r', '\n' };
+
+    bool found = ICircularBuffer_FindPattern( pCircularBuffer, pattern, sizeof( pattern ), from, pOffset );
+    if ( found )
+    {
+        // Report the delimiter itself, like the single byte searches
+        ++*pOffset;
+    }
+
+    return found;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void BenchFindScan( char const *pVariant, FindFunction_t find, CircularBuffer_t *pCircularBuffer, size_t lineSize )
+{
+    size_t   count   = ICircularBuffer_GetCount( pCircularBuffer );
+    uint64_t bytes   = 0;
+    uint64_t start   = BenchNanoseconds();
+    uint64_t elapsed = 0;
+    do
+    {
+        // Find every delimiter in the backlog, as a line based protocol would before popping
+        size_t from = 0;
+        size_t offset;
+        while ( find( pCircularBuffer, from, &offset ) )
+        {
+            from = offset + 1;
+        }
+        if ( from != count )
+        {
+            fprintf( stderr, "%s: stopped at %zu of %zu\n", pVariant, from, count );
+            return;
+        }
+        bytes  += count;
+        elapsed = BenchNanoseconds() - start;
+    } while ( elapsed < THROUGHPUT_MIN_NS );
+
+    BenchReport( "find", pVariant, count, lineSize, "bytes_per_second",
+                 (double)bytes * 1e9 / (double)elapsed, "B/s" );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void BenchFind( void )
+{
+    static size_t const backlogs[]  = { 64 * 1024, 1024 * 1024, 4 * 1024 * 1024 };
+    static size_t const lineSizes[] = { 0, FIND_LINE_SIZE };
+
+    uint8_t *pMemory = malloc( FIND_BUFFER_SIZE );
+    if ( pMemory == NULL )
+    {
+        fprintf( stderr, "Out of memory\n" );
+        return;
+    }
+
+    for ( size_t b = 0; b < ARR_SIZE( backlogs ); ++b )
+    {
+        for ( size_t l = 0; l < ARR_SIZE( lineSizes ); ++l )
+        {
+            CircularBuffer_t circularBuffer;
+            size_t           backlog  = backlogs[ b ];
+            size_t           lineSize = ( lineSizes[ l ] == 0 ) ? backlog : lineSizes[ l ];
+
+            // Backlog straddles end of buffer memory, "\r\n" ends every line, 0 means one line of all of it
+            size_t start = ( FIND_BUFFER_SIZE - ( backlog / 2 ) );
+            ICircularBuffer_Init( &circularBuffer, pMemory, FIND_BUFFER_SIZE );
+            ICircularBuffer_Commit( &circularBuffer, start );
+            ICircularBuffer_Release( &circularBuffer, start );
+
+            memset( pMemory, 'a', FIND_BUFFER_SIZE );
+            for ( size_t i = lineSize; i <= backlog; i += lineSize )
+            {
+                pMemory[ ( start + i - 2 ) & ( FIND_BUFFER_SIZE - 1 ) ] = '\r';
+                pMemory[ ( start + i - 1 ) & ( FIND_BUFFER_SIZE - 1 ) ] = '\n';
+            }
+            ICircularBuffer_Commit( &circularBuffer, backlog - ( backlog % lineSize ) );
+
+            BenchFindScan( "naive",       Naive_Find,       &circularBuffer, lineSize );
+            BenchFindScan( "Find",        Simd_Find,        &circularBuffer, lineSize );
+            BenchFindScan( "FindPattern", Simd_FindPattern, &circularBuffer, lineSize );
+        }
+    }
+
+    free( pMemory );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *ShardedProducer( void *pArg )
+{
+    ShardedArg_t *pShardedArg = (ShardedArg_t*)pArg;
+    uint8_t      chunk[ 16 * SHARDED_ELEMENT_SIZE ];
+    size_t       sent         = 0;
+    size_t       spins        = 0;
+    size_t       shard;
+
+    BenchPin( pShardedArg->core );
+    memset( chunk, 0x5A, sizeof( chunk ) );
+    if ( !ICircularBufferSharded_Attach( pShardedArg->pSharded, &shard ) )
+    {
+        fprintf( stderr, "No free shard for producer\n" );
+        exit( 1 );
+    }
+
+    while ( sent < SHARDED_BYTES )
+    {
+        size_t count = ICircularBufferSharded_Push( pShardedArg->pSharded, shard, chunk, sizeof( chunk ) );
+        if ( count == 0 && ++spins > LATENCY_SPINS )
+        {
+            spins = 0;
+            sched_yield();
+        }
+        sent += count;
+    }
+
+    ICircularBufferSharded_Detach( pShardedArg->pSharded, shard );
+    atomic_fetch_add_explicit( pShardedArg->pDetached, 1, memory_order_release );
+
+    return NULL;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *ShardedConsumer( void *pArg )
+{
+    ShardedArg_t *pShardedArg = (ShardedArg_t*)pArg;
+    uint8_t      chunk[ 16 * SHARDED_ELEMENT_SIZE ];
+    size_t       consumed     = 0;
+    size_t       spins        = 0;
+
+    BenchPin( pShardedArg->core );
+
+    // Count locally, consumers only share the set. Done after our share, or once every producer has detached and the
+    // set is drained, as stealing may leave a consumer short of its share while another gets more
+    while ( consumed < SHARDED_BYTES )
+    {
+        size_t count = ICircularBufferSharded_Pop( pShardedArg->pSharded, pShardedArg->index, chunk, sizeof( chunk ),
+                                                   NULL );
+        if ( count == 0 )
+        {
+            if ( atomic_load_explicit( pShardedArg->pDetached, memory_order_acquire ) == pShardedArg->producers &&
+                 ICircularBufferSharded_GetCount( pShardedArg->pSharded ) == 0 )
+            {
+                break;
+            }
+            if ( ++spins > LATENCY_SPINS )
+            {
+                spins = 0;
+                sched_yield();
+            }
+            continue;
+        }
+        consumed += count;
+    }
+
+    // Consumers run at the same time, results and benchSink are only added up once they are joined
+    pShardedArg->consumed = consumed;
+    pShardedArg->sink     = chunk[ 0 ];
+
+    return NULL;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void BenchSharded( void )
+{
+    static uint8_t               memory[ SHARDED_MAX_THREADS * SHARDED_SHARD_SIZE ];
+    static CircularBufferShard_t shards[ SHARDED_MAX_THREADS ];
+    long                         cores = sysconf( _SC_NPROCESSORS_ONLN );
+
+    // Aggregate throughput with as many consumers as producers, one shard per producer, threads spread over cores
+    for ( size_t threads = 1; threads <= SHARDED_MAX_THREADS; threads *= 2 )
+    {
+        CircularBufferSharded_t sharded;
+        pthread_t               producers[ SHARDED_MAX_THREADS ];
+        pthread_t               consumers[ SHARDED_MAX_THREADS ];
+        ShardedArg_t            args[ 2 * SHARDED_MAX_THREADS ];
+        atomic_size_t           detached = 0;
+        size_t                  consumed = 0;
+        char                    variant[ 32 ];
+
+        ICircularBufferSharded_Init( &sharded, shards, threads, memory, threads * SHARDED_SHARD_SIZE,
+                                     SHARDED_ELEMENT_SIZE, threads, ICIRCULARBUFFERSHARDED_PICK_ROUND_ROBIN );
+
+        uint64_t start = BenchNanoseconds();
+        for ( size_t i = 0; i < threads; ++i )
+        {
+            for ( size_t side = 0; side < 2; ++side )
+            {
+                ShardedArg_t *pArg = &args[ ( 2 * i ) + side ];
+                *pArg = (ShardedArg_t){ &sharded, i, threads, &detached, 0, 0,
+                                        ( cores > 0 ) ? (int)( ( ( 2 * i ) + side ) % (size_t)cores ) : -1 };
+                pthread_create( ( side == 0 ) ? &producers[ i ] : &consumers[ i ], NULL,
+                                ( side == 0 ) ? ShardedProducer : ShardedConsumer, pArg );
+            }
+        }
+        for ( size_t i = 0; i < threads; ++i )
+        {
+            pthread_join( producers[ i ], NULL );
+            pthread_join( consumers[ i ], NULL );
+            consumed  += args[ ( 2 * i ) + 1 ].consumed;
+            benchSink += args[ ( 2 * i ) + 1 ].sink;
+        }
+        uint64_t elapsed = BenchNanoseconds() - start;
+
+        if ( consumed != threads * SHARDED_BYTES )
+        {
+            fprintf( stderr, "Sharded consumers popped %zu of %zu bytes\n", consumed, threads * SHARDED_BYTES );
+            exit( 1 );
+        }
+
+        snprintf( variant, sizeof( variant ), "%zu_producers", threads );
+        BenchReport( "sharded", variant, SHARDED_SHARD_SIZE, 16 * SHARDED_ELEMENT_SIZE, "bytes_per_second",
+                     (double)( threads * SHARDED_BYTES ) * 1e9 / (double)elapsed, "B/s" );
+    }
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *BatchProducer( void *pArg )
+{
+    BatchArg_t *pBatchArg = (BatchArg_t*)pArg;
+    uint8_t    message[ 64 ];
+    size_t     sent       = 0;
+    size_t     spins      = 0;
+
+    BenchPin( pBatchArg->core );
+    memset( message, 0x5A, sizeof( message ) );
+
+    while ( sent < BATCH_MESSAGES )
+    {
+        size_t count = 0;
+        if ( pBatchArg->batched )
+        {
+            ICircularBufferSpsc_BeginBatch( pBatchArg->pCircularBuffer );
+            while (
+                ( count < BATCH_SIZE ) && ( ( sent + count ) < BATCH_MESSAGES ) &&
+                ( ICircularBufferSpsc_PushDeferred( pBatchArg->pCircularBuffer, message, pBatchArg->messageSize ) > 0 )
+            )
+            {
+                ++count;
+            }
+            ICircularBufferSpsc_PublishBatch( pBatchArg->pCircularBuffer );
+        }
+        else
+        {
+            count = ICircularBufferSpsc_Push( pBatchArg->pCircularBuffer, message, pBatchArg->messageSize )
+                  / pBatchArg->messageSize;
+        }
+
+        if ( count == 0 && ++spins > LATENCY_SPINS )
+        {
+            spins = 0;
+            sched_yield();
+        }
+        sent += count;
+    }
+
+    return NULL;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *BatchConsumer( void *pArg )
+{
+    BatchArg_t *pBatchArg = (BatchArg_t*)pArg;
+    uint8_t    messages[ BATCH_SIZE * 64 ];
+    size_t     received   = 0;
+    size_t     spins      = 0;
+
+    BenchPin( pBatchArg->core );
+
+    while ( received < BATCH_MESSAGES )
+    {
+        size_t count = pBatchArg->batched
+                     ? ICircularBufferSpsc_PopBatch( pBatchArg->pCircularBuffer, messages, pBatchArg->messageSize,
+                                                     BATCH_SIZE )
+                     : ICircularBufferSpsc_Pop( pBatchArg->pCircularBuffer, messages, pBatchArg->messageSize )
+                       / pBatchArg->messageSize;
+        if ( count == 0 && ++spins > LATENCY_SPINS )
+        {
+            spins = 0;
+            sched_yield();
+        }
+        received += count;
+    }
+
+    benchSink += messages[ 0 ];
+
+    return NULL;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void BenchBatch( void )
+{
+    static size_t const         messageSizes[] = { 8, 64 };
+    static uint8_t              memory[ SPSC_BUFFER_SIZE ];
+    static CircularBufferSpsc_t circularBuffer;
+
+    // One publication per message against one per batch, with the consumer popping the same way
+    for ( size_t m = 0; m < ARR_SIZE( messageSizes ); ++m )
+    {
+        for ( int batched = 0; batched < 2; ++batched )
+        {
+            pthread_t  producer;
+            pthread_t  consumer;
+            BatchArg_t producerArg = { &circularBuffer, messageSizes[ m ], ( batched != 0 ), benchProducerCore };
+            BatchArg_t consumerArg = { &circularBuffer, messageSizes[ m ], ( batched != 0 ), benchConsumerCore };
+
+            ICircularBufferSpsc_Init( &circularBuffer, memory, sizeof( memory ) );
+
+            uint64_t start = BenchNanoseconds();
+            pthread_create( &consumer, NULL, BatchConsumer, &consumerArg );
+            pthread_create( &producer, NULL, BatchProducer, &producerArg );
+            pthread_join( producer, NULL );
+            pthread_join( consumer, NULL );
+            uint64_t elapsed = BenchNanoseconds() - start;
+
+            BenchReport( "batch", ( batched != 0 ) ? "PublishBatch/PopBatch" : "Push/Pop", sizeof( memory ),
+                         messageSizes[ m ], "messages_per_second", (double)BATCH_MESSAGES * 1e9 / (double)elapsed,
+                         "msg/s" );
+        }
+    }
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void BenchBulkVariant( char const *pVariant, CircularBuffer_t *pCircularBuffer, uint8_t *pChunk, size_t const *pWorkingSet,
+                       bool transfer )
+{
+    size_t   hops         = BULK_WORKING_SET / 64;
+    size_t   line         = 0;
+    uint64_t walkTime     = 0;
+    uint64_t transferTime = 0;
+
+    for ( size_t round = 0; round < BULK_ROUNDS; ++round )
+    {
+        // Stage a chunk through the buffer, as a large transfer would, then see what it left of the co-runner's cache
+        uint64_t start = BenchNanoseconds();
+        if ( transfer )
+        {
+            ICircularBuffer_Push( pCircularBuffer, pChunk, BULK_CHUNK_SIZE );
+            ICircularBuffer_Pop( pCircularBuffer, pChunk + BULK_CHUNK_SIZE, BULK_CHUNK_SIZE );
+        }
+        uint64_t middle = BenchNanoseconds();
+        for ( size_t i = 0; i < hops; ++i )
+        {
+            line = pWorkingSet[ line * 8 ];
+        }
+        uint64_t end = BenchNanoseconds();
+
+        transferTime += ( middle - start );
+        walkTime     += ( end - middle );
+    }
+
+    benchSink += (uint8_t)line;
+
+    BenchReport( "bulk", pVariant, BULK_BUFFER_SIZE, BULK_CHUNK_SIZE, "corunner_loads_per_second",
+                 (double)( hops * BULK_ROUNDS ) * 1e9 / (double)walkTime, "loads/s" );
+    if ( transfer )
+    {
+        BenchReport( "bulk", pVariant, BULK_BUFFER_SIZE, BULK_CHUNK_SIZE, "bytes_per_second",
+                     (double)BULK_CHUNK_SIZE * BULK_ROUNDS * 1e9 / (double)transferTime, "B/s" );
+    }
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void BenchBulk( void )
+{
+    CircularBuffer_t circularBuffer;
+    uint8_t          *pMemory     = malloc( BULK_BUFFER_SIZE );
+    uint8_t          *pChunk      = malloc( 2 * BULK_CHUNK_SIZE );
+    size_t           *pWorkingSet = malloc( BULK_WORKING_SET );
+    if ( pMemory == NULL || pChunk == NULL || pWorkingSet == NULL )
+    {
+        fprintf( stderr, "Out of memory\n" );
+        free( pMemory );
+        free( pChunk );
+        free( pWorkingSet );
+        return;
+    }
+
+    // Co-runner chases pointers through one random cycle over all cache lines of its working set, first word of each
+    size_t lines = BULK_WORKING_SET / 64;
+    for ( size_t i = 0; i < lines; ++i )
+    {
+        pWorkingSet[ i * 8 ] = i;
+    }
+    // Sattolo's shuffle, always swapping with an earlier line, leaves a single cycle through all of them
+    uint64_t seed = 88172645463325252u;
+    for ( size_t i = lines - 1; i > 0; --i )
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        size_t j    = (size_t)( seed % i );
+        size_t swap = pWorkingSet[ i * 8 ];
+        pWorkingSet[ i * 8 ] = pWorkingSet[ j * 8 ];
+        pWorkingSet[ j * 8 ] = swap;
+    }
+    memset( pMemory, 0, BULK_BUFFER_SIZE );
+    memset( pChunk, 0x5A, 2 * BULK_CHUNK_SIZE );
+
+    // Co-runner alone first, then next to transfers copied both ways
+    ICircularBuffer_Init( &circularBuffer, pMemory, BULK_BUFFER_SIZE );
+    BenchBulkVariant( "idle", &circularBuffer, pChunk, pWorkingSet, false );
+
+    ICircularBuffer_SetBulkThreshold( &circularBuffer, 0 );
+    BenchBulkVariant( "memcpy", &circularBuffer, pChunk, pWorkingSet, true );
+
+    ICircularBuffer_SetBulkThreshold( &circularBuffer, BULK_THRESHOLD );
+    BenchBulkVariant( "streaming", &circularBuffer, pChunk, pWorkingSet, true );
+
+    free( pMemory );
+    free( pChunk );
+    free( pWorkingSet );
+}
+
+#ifdef ICIRCULARBUFFERSPSC_DWELL
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void BenchDwell( void )
+{
+    static uint8_t                   memory[ SPSC_BUFFER_SIZE ];
+    static CircularBufferSpsc_t      circularBuffer;
+    static CircularBufferSpscStamp_t stamps[ DWELL_STAMPS ];
+    static CircularBufferLatency_t   latency;
+
+    // Plain push and pop of 64 byte messages, without and with every message stamped and its dwell time recorded
+    for ( int traced = 0; traced < 2; ++traced )
+    {
+        pthread_t  producer;
+        pthread_t  consumer;
+        BatchArg_t producerArg = { &circularBuffer, 64, false, benchProducerCore };
+        BatchArg_t consumerArg = { &circularBuffer, 64, false, benchConsumerCore };
+
+        ICircularBufferSpsc_Init( &circularBuffer, memory, sizeof( memory ) );
+        ICircularBufferLatency_Init( &latency );
+        if ( traced != 0 )
+        {
+            ICircularBufferSpsc_TraceDwell( &circularBuffer, stamps, ARR_SIZE( stamps ), &latency );
+        }
+
+        uint64_t start = BenchNanoseconds();
+        pthread_create( &consumer, NULL, BatchConsumer, &consumerArg );
+        pthread_create( &producer, NULL, BatchProducer, &producerArg );
+        pthread_join( producer, NULL );
+        pthread_join( consumer, NULL );
+        uint64_t elapsed = BenchNanoseconds() - start;
+
+        char const *pVariant = ( traced != 0 ) ? "traced" : "untraced";
+        BenchReport( "dwell", pVariant, sizeof( memory ), 64, "messages_per_second",
+                     (double)BATCH_MESSAGES * 1e9 / (double)elapsed, "msg/s" );
+
+        uint64_t p50;
+        uint64_t p99;
+        if ( ICircularBufferLatency_GetPercentile( &latency, 50.0, &p50 ) &&
+             ICircularBufferLatency_GetPercentile( &latency, 99.0, &p99 ) )
+        {
+            BenchReport( "dwell", pVariant, sizeof( memory ), 64, "p50", (double)p50, "ns" );
+            BenchReport( "dwell", pVariant, sizeof( memory ), 64, "p99", (double)p99, "ns" );
+        }
+    }
+}
+#endif
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *MpmcProducer( void *pArg )
+{
+    MpmcArg_t *pMpmcArg = (MpmcArg_t*)pArg;
+    uint8_t   element[ MPMC_ELEMENT_SIZE ];
+    size_t    sent      = 0;
+    size_t    spins     = 0;
+
+    BenchPin( pMpmcArg->core );
+    memset( element, 0x5A, sizeof( element ) );
+
+    while ( sent < pMpmcArg->messages )
+    {
+        bool pushed;
+        if ( pMpmcArg->pMpmc != NULL )
+        {
+            pushed = ICircularBufferMpmc_Push( pMpmcArg->pMpmc, element );
+        }
+        else
+        {
+            // Buffer only ever holds whole elements, so a push either fits completely or not at all
+            pthread_mutex_lock( pMpmcArg->pMutex );
+            pushed = ( ICircularBuffer_Push( pMpmcArg->pLocked, element, sizeof( element ) ) > 0 );
+            pthread_mutex_unlock( pMpmcArg->pMutex );
+        }
+
+        if ( !pushed )
+        {
+            if ( ++spins > MPMC_SPINS )
+            {
+                spins = 0;
+                sched_yield();
+            }
+            continue;
+        }
+        ++sent;
+    }
+
+    return NULL;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *MpmcConsumer( void *pArg )
+{
+    MpmcArg_t *pMpmcArg = (MpmcArg_t*)pArg;
+    uint8_t   element[ MPMC_ELEMENT_SIZE ];
+    size_t    received  = 0;
+    size_t    spins     = 0;
+
+    BenchPin( pMpmcArg->core );
+
+    // Each consumer stops after its own share, nothing shared is touched to find out when everything arrived
+    while ( received < pMpmcArg->messages )
+    {
+        bool popped;
+        if ( pMpmcArg->pMpmc != NULL )
+        {
+            popped = ICircularBufferMpmc_Pop( pMpmcArg->pMpmc, element );
+        }
+        else
+        {
+            pthread_mutex_lock( pMpmcArg->pMutex );
+            popped = ( ICircularBuffer_Pop( pMpmcArg->pLocked, element, sizeof( element ) ) > 0 );
+            pthread_mutex_unlock( pMpmcArg->pMutex );
+        }
+
+        if ( !popped )
+        {
+            if ( ++spins > MPMC_SPINS )
+            {
+                spins = 0;
+                sched_yield();
+            }
+            continue;
+        }
+        ++received;
+    }
+
+    // Consumers run at the same time, benchSink is only added to once they are joined
+    pMpmcArg->sink = element[ 0 ];
+
+    return NULL;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+void BenchMpmc( void )
+{
+    static _Alignas( ICIRCULARBUFFERMPMC_CACHE_LINE_SIZE )
+    uint8_t                     slots[ ICIRCULARBUFFERMPMC_BUFFER_SIZE( MPMC_SLOTS, MPMC_ELEMENT_SIZE ) ];
+    static uint8_t              memory[ MPMC_SLOTS * MPMC_ELEMENT_SIZE ];
+    static CircularBufferMpmc_t mpmc;
+    static CircularBuffer_t     locked;
+    static pthread_mutex_t      mutex = PTHREAD_MUTEX_INITIALIZER;
+    long                        cores = sysconf( _SC_NPROCESSORS_ONLN );
+
+    // Aggregate throughput with as many consumers as producers, lock-free slots against one mutex around the buffer
+    for ( size_t threads = 1; threads <= MPMC_MAX_THREADS; threads *= 2 )
+    {
+        for ( int lockFree = 0; lockFree < 2; ++lockFree )
+        {
+            pthread_t producers[ MPMC_MAX_THREADS ];
+            pthread_t consumers[ MPMC_MAX_THREADS ];
+            MpmcArg_t args[ 2 * MPMC_MAX_THREADS ];
+            char      variant[ 32 ];
+
+            ICircularBufferMpmc_Init( &mpmc, slots, MPMC_SLOTS, MPMC_ELEMENT_SIZE );
+            ICircularBuffer_Init( &locked, memory, sizeof( memory ) );
+
+            uint64_t start = BenchNanoseconds();
+            for ( size_t i = 0; i < threads; ++i )
+            {
+                for ( size_t side = 0; side < 2; ++side )
+                {
+                    MpmcArg_t *pArg = &args[ ( 2 * i ) + side ];
+                    *pArg = (MpmcArg_t){ ( lockFree != 0 ) ? &mpmc : NULL, &locked, &mutex, MPMC_MESSAGES / threads,
+                                         0, ( cores > 0 ) ? (int)( ( ( 2 * i ) + side ) % (size_t)cores ) : -1 };
+                    pthread_create( ( side == 0 ) ? &producers[ i ] : &consumers[ i ], NULL,
+                                    ( side == 0 ) ? MpmcProducer : MpmcConsumer, pArg );
+                }
+            }
+            for ( size_t i = 0; i < threads; ++i )
+            {
+                pthread_join( producers[ i ], NULL );
+                pthread_join( consumers[ i ], NULL );
+                benchSink += args[ ( 2 * i ) + 1 ].sink;
+            }
+            uint64_t elapsed = BenchNanoseconds() - start;
+
+            snprintf( variant, sizeof( variant ), "%s_%zu_threads", ( lockFree != 0 ) ? "Mpmc" : "mutex", threads );
+            BenchReport( "mpmc", variant, sizeof( memory ), MPMC_ELEMENT_SIZE, "messages_per_second",
+                         (double)MPMC_MESSAGES * 1e9 / (double)elapsed, "msg/s" );
+        }
+    }
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Entrypoint
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+int main( int argc, char *argv[] )
+{
+    char const *pCsvPath = BENCH_DEFAULT_CSV;
+    char const *pSuites  = NULL;
+    int        option;
+
+    while ( ( option = getopt( argc, argv, "o:s:p:c:h" ) ) != -1 )
+    {
+        switch ( option )
+        {
+            case 'o': pCsvPath          = optarg;       break;
+            case 's': pSuites           = optarg;       break;
+            case 'p': benchProducerCore = atoi( optarg ); break;
+            case 'c': benchConsumerCore = atoi( optarg ); break;
+            default:
+                fprintf( stderr, "Usage: %s [-o results.csv] [-s suite,suite] [-p producer core] [-c consumer core]\n", argv[ 0 ] );
+                fprintf( stderr, "Suites:" );
+                for ( size_t i = 0; i < ARR_SIZE( benchSuites ); ++i )
+                {
+                    fprintf( stderr, " %s", benchSuites[ i ].pName );
+                }
+                fprintf( stderr, "\n" );
+                return ( option == 'h' ) ? 0 : 1;
+        }
+    }
+
+    pBenchCsv = fopen( pCsvPath, "w" );
+    if ( pBenchCsv == NULL )
+    {
+        perror( pCsvPath );
+        return 1;
+    }
+    fprintf( pBenchCsv, "benchmark,variant,buffer_size,chunk_size,metric,value,unit\n" );
+
+    for ( size_t i = 0; i < ARR_SIZE( benchSuites ); ++i )
+    {
+        // Run all suites, or only those listed with -s
+        if ( pSuites == NULL || strstr( pSuites, benchSuites[ i ].pName ) != NULL )
+        {
+            benchSuites[ i ].pRun();
+        }
+    }
+
+    fclose( pBenchCsv );
+    printf( "Results written to %s\n", pCsvPath );
+
+    return 0;
+}
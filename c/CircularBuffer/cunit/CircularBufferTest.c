@@ -9,12 +9,38 @@
  * ---------------------------------------------------------------------------------------------------------------------
  */
 
+#define _GNU_SOURCE // F_SETPIPE_SZ
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
 #include <CUnit/Basic.h>
 #include <CUnit/Automated.h>
 
 #include "ICircularBuffer.h"
+#include "ICircularBufferSpsc.h"
+#include "ICircularBufferMpmc.h"
+#include "ICircularBufferMirror.h"
+#include "ICircularBufferBroadcast.h"
+#include "ICircularBufferFd.h"
+#include "ICircularBufferShm.h"
+#include "ICircularBufferTyped.h"
+#include "ICircularBufferRecord.h"
+#include "ICircularBufferJournal.h"
+#include "ICircularBufferSharded.h"
+#include "ICircularBufferLatency.h"
 
 /**
  * ---------------------------------------------------------------------------------------------------------------------
@@ -28,12 +54,155 @@
  */
 #define ARR_SIZE(x) ((sizeof(x)/sizeof(0[x])) / ((size_t)(!(sizeof(x) % sizeof(0[x])))))
 
+/**
+ * @def   SPSC_STRESS_BYTES
+ * @brief Number of bytes streamed from producer to consumer thread in SPSC stress test.
+ */
+#define SPSC_STRESS_BYTES ( 4 * 1024 * 1024 )
+
+/**
+ * @def   MPMC_STRESS_THREADS
+ * @brief Number of producer threads, and number of consumer threads, in MPMC stress test.
+ */
+#define MPMC_STRESS_THREADS 4
+
+/**
+ * @def   MPMC_STRESS_ELEMENTS
+ * @brief Number of elements pushed by each producer thread in MPMC stress test.
+ */
+#define MPMC_STRESS_ELEMENTS ( 256 * 1024 )
+
+/**
+ * @def   OVERWRITE_STRESS_BYTES
+ * @brief Number of bytes pushed by producer thread in overwrite mode stress test.
+ */
+#define OVERWRITE_STRESS_BYTES ( 4 * 1024 * 1024 )
+
+/**
+ * @def   BROADCAST_STRESS_READERS
+ * @brief Number of reader threads in broadcast stress test.
+ */
+#define BROADCAST_STRESS_READERS 3
+
+/**
+ * @def   BROADCAST_STRESS_BYTES
+ * @brief Number of bytes streamed from producer to every reader thread in broadcast stress test.
+ */
+#define BROADCAST_STRESS_BYTES ( 2 * 1024 * 1024 )
+
+/**
+ * @def   SHM_STRESS_BYTES
+ * @brief Number of bytes streamed from child to parent process in shared memory test.
+ */
+#define SHM_STRESS_BYTES ( 4 * 1024 * 1024 )
+
+/**
+ * @def   JOURNAL_CRASH_SIZE
+ * @brief Size of journal written by child process in crash recovery test.
+ */
+#define JOURNAL_CRASH_SIZE ( 64 * 1024 )
+
+/**
+ * @def   JOURNAL_CRASH_VALUES
+ * @brief Number of counter values child process pushes before parent starts waiting to kill it.
+ */
+#define JOURNAL_CRASH_VALUES ( 256 * 1024 )
+
+/**
+ * @def   SHARDED_STRESS_PRODUCERS
+ * @brief Number of producer threads, and shards, in sharded stress test.
+ */
+#define SHARDED_STRESS_PRODUCERS 4
+
+/**
+ * @def   SHARDED_STRESS_CONSUMERS
+ * @brief Number of consumer threads in sharded stress test.
+ */
+#define SHARDED_STRESS_CONSUMERS 2
+
+/**
+ * @def   SHARDED_STRESS_ELEMENTS
+ * @brief Number of elements pushed by each producer thread in sharded stress test.
+ */
+#define SHARDED_STRESS_ELEMENTS ( 128 * 1024 )
+
 /**
  * ---------------------------------------------------------------------------------------------------------------------
  * Types
  * ---------------------------------------------------------------------------------------------------------------------
  */
 
+/**
+ * Element passed through MPMC buffer in tests
+ */
+typedef struct MpmcTestElement
+{
+    uint32_t producer; /**< Index of producing thread.         */
+    uint32_t sequence; /**< Sequence number within producer.   */
+} MpmcTestElement_t;
+
+/**
+ * Argument to overwrite mode stress test reader thread
+ */
+typedef struct OverwriteStressArg
+{
+    CircularBuffer_t *pCircularBuffer; /**< Buffer under test.                              */
+    uint64_t         received;         /**< Number of bytes read.                           */
+    uint64_t         lost;             /**< Number of bytes reported lost.                  */
+    size_t           errors;           /**< Number of bytes read with wrong (torn) content. */
+} OverwriteStressArg_t;
+
+/**
+ * Context of counting allocator handed to growable buffers in tests
+ */
+typedef struct GrowableTestAllocator
+{
+    size_t allocations; /**< Number of successful allocations.           */
+    size_t frees;       /**< Number of frees.                            */
+    size_t bytesLive;   /**< Bytes allocated and not yet freed.          */
+    bool   fail;        /**< Fail allocations while set.                 */
+} GrowableTestAllocator_t;
+
+/**
+ * Argument to broadcast stress test reader threads
+ */
+typedef struct BroadcastStressArg
+{
+    CircularBufferBroadcast_t *pCircularBuffer; /**< Buffer under test.                         */
+    size_t                    reader;           /**< Index of reader.                           */
+    size_t                    errors;           /**< Number of bytes read with wrong content.   */
+} BroadcastStressArg_t;
+
+/**
+ * Argument to MPMC stress test threads
+ */
+typedef struct MpmcStressArg
+{
+    CircularBufferMpmc_t *pCircularBuffer; /**< Buffer under test.                        */
+    uint32_t             index;            /**< Index of thread.                          */
+    atomic_size_t        *pConsumed;       /**< Total number of elements consumed.        */
+    size_t               errors;           /**< Number of out of order elements seen.     */
+    uint64_t             sum;              /**< Sum of all sequence numbers consumed.     */
+} MpmcStressArg_t;
+
+/**
+ * Argument to sharded stress test threads
+ */
+typedef struct ShardedStressArg
+{
+    CircularBufferSharded_t *pSharded;   /**< Set under test.                                   */
+    uint32_t                index;       /**< Index of thread.                                  */
+    atomic_size_t           *pConsumed;  /**< Total number of elements consumed.                */
+    size_t                  errors;      /**< Number of out of order or mixed elements seen.    */
+    size_t                  stolen;      /**< Number of batches popped from other than home.    */
+    uint64_t                sum;         /**< Sum of all sequence numbers consumed.             */
+} ShardedStressArg_t;
+
+/**
+ * Typed circular buffer of MPMC test elements, small to make wraparound easy to hit
+ */
+ICIRCULARBUFFERTYPED_DEFINE( TypedTestRing, MpmcTestElement_t, 8 )
+
 /**
  * ---------------------------------------------------------------------------------------------------------------------
  * Prototypes
@@ -43,7 +212,124 @@
 int InitInterfaceSuite( void );
 int CleanInterfaceSuite( void );
 
+int InitSpscSuite( void );
+int CleanSpscSuite( void );
+
 void Test_ICircularBuffer_Init( void );
+void Test_ICircularBuffer_GetCount( void );
+void Test_ICircularBuffer_Peek( void );
+void Test_ICircularBuffer_PeekV( void );
+void Test_ICircularBuffer_Find( void );
+void Test_ICircularBuffer_Pop( void );
+void Test_ICircularBuffer_Push( void );
+void Test_ICircularBuffer_Reserve( void );
+void Test_ICircularBuffer_ReserveV( void );
+void Test_ICircularBuffer_Commit( void );
+void Test_ICircularBuffer_Release( void );
+void Test_ICircularBuffer_Clear( void );
+void Test_ICircularBuffer_Statistics( void );
+void Test_ICircularBuffer_Notify( void );
+void Test_ICircularBuffer_Crc( void );
+void Test_ICircularBuffer_Bulk( void );
+
+void Test_ICircularBufferSpsc_Init( void );
+void Test_ICircularBufferSpsc_PushPop( void );
+void Test_ICircularBufferSpsc_Peek( void );
+void Test_ICircularBufferSpsc_Clear( void );
+void Test_ICircularBufferSpsc_Stress( void );
+void Test_ICircularBufferSpsc_Wait( void );
+void Test_ICircularBufferSpsc_WaitStress( void );
+void Test_ICircularBufferSpsc_Batch( void );
+void Test_ICircularBufferSpsc_BatchStress( void );
+void Test_ICircularBufferSpsc_Dwell( void );
+void Test_ICircularBufferSpsc_DwellStress( void );
+
+int InitMpmcSuite( void );
+int CleanMpmcSuite( void );
+
+void Test_ICircularBufferMpmc_Init( void );
+void Test_ICircularBufferMpmc_PushPop( void );
+void Test_ICircularBufferMpmc_Stress( void );
+
+int InitMirrorSuite( void );
+int CleanMirrorSuite( void );
+
+void Test_ICircularBufferMirror_Init( void );
+void Test_ICircularBufferMirror_Contiguous( void );
+
+int InitOverwriteSuite( void );
+int CleanOverwriteSuite( void );
+
+void Test_ICircularBuffer_InitOverwrite( void );
+void Test_ICircularBuffer_PushOverwrite( void );
+void Test_ICircularBuffer_ReadAt( void );
+void Test_ICircularBuffer_OverwriteStress( void );
+
+int InitBroadcastSuite( void );
+int CleanBroadcastSuite( void );
+
+void Test_ICircularBufferBroadcast_Init( void );
+void Test_ICircularBufferBroadcast_PushPop( void );
+void Test_ICircularBufferBroadcast_PeekRelease( void );
+void Test_ICircularBufferBroadcast_Stress( void );
+
+int InitFdSuite( void );
+int CleanFdSuite( void );
+
+void Test_ICircularBufferFd_ReadFromFd( void );
+void Test_ICircularBufferFd_WriteToFd( void );
+void Test_ICircularBufferFd_Partial( void );
+
+int InitShmSuite( void );
+int CleanShmSuite( void );
+
+void Test_ICircularBufferShm_CreateAttach( void );
+void Test_ICircularBufferShm_PushPop( void );
+void Test_ICircularBufferShm_Process( void );
+
+int InitTypedSuite( void );
+int CleanTypedSuite( void );
+
+void Test_ICircularBufferTyped_PushPop( void );
+void Test_ICircularBufferTyped_PushNPopN( void );
+
+int InitRecordSuite( void );
+int CleanRecordSuite( void );
+
+void Test_ICircularBufferRecord_PushPop( void );
+void Test_ICircularBufferRecord_Batch( void );
+void Test_ICircularBufferRecord_Growable( void );
+void Test_ICircularBufferRecord_Crc( void );
+
+int InitGrowableSuite( void );
+int CleanGrowableSuite( void );
+
+void Test_ICircularBuffer_InitGrowable( void );
+void Test_ICircularBuffer_GrowShrink( void );
+void Test_ICircularBuffer_GrowableAllocator( void );
+void Test_ICircularBuffer_GrowableNotify( void );
+
+int InitJournalSuite( void );
+int CleanJournalSuite( void );
+
+void Test_ICircularBufferJournal_OpenClose( void );
+void Test_ICircularBufferJournal_Sync( void );
+void Test_ICircularBufferJournal_SyncFailed( void );
+void Test_ICircularBufferJournal_CommitOrder( void );
+void Test_ICircularBufferJournal_Crash( void );
+
+int InitShardedSuite( void );
+int CleanShardedSuite( void );
+
+void Test_ICircularBufferSharded_Init( void );
+void Test_ICircularBufferSharded_PushPop( void );
+void Test_ICircularBufferSharded_Stress( void );
+
+int InitLatencySuite( void );
+int CleanLatencySuite( void );
+
+void Test_ICircularBufferLatency_Record( void );
+void Test_ICircularBufferLatency_Percentile( void );
 
 /**
  * ---------------------------------------------------------------------------------------------------------------------
@@ -80,206 +366,4124 @@ int CleanInterfaceSuite( void )
 }
 
 /**
- * ---------------------------------------------------------------------------------------------------------------------
- * Tests
- * ---------------------------------------------------------------------------------------------------------------------
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
  */
+int InitSpscSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
 
 /**
  * *********************************************************************************************************************
- * Test
+ * Function
  * *********************************************************************************************************************
  */
-void Test_ICircularBuffer_Init( void )
+int CleanSpscSuite( void )
 {
-    CircularBuffer_t myBuffer;
-    uint8_t          data;     // We do not need an actual buffer, since we're not writing to it in this test
-
-   // Test bad input
-    CU_ASSERT_FALSE( ICircularBuffer_Init( NULL, NULL, 0 )                   );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, NULL, 0 )              );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, NULL, 256 )            );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 0 ) );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, NULL, 256 )            );
+    // Nothing to do for now
+    return 0;
+}
 
-    // Test valid input
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 256 ) );
-    CU_ASSERT_EQUAL( myBuffer.bufferSize, 256               );
-    CU_ASSERT_EQUAL( myBuffer.pBuffer,    (uint8_t*)&data );
-    CU_ASSERT_EQUAL( myBuffer.pRead,      (uint8_t*)&data );  // Dangerzone, relying on implementation.
-    CU_ASSERT_EQUAL( myBuffer.pWrite,     (uint8_t*)&data );  // Dangerzone, relying on implementation.
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static uint32_t CrcReference( uint8_t const *pData, size_t count )
+{
+    uint32_t crc = UINT32_MAX;
 
-    // Test some valid and invalid buffer sizes (up to about 1TB, probably not reasonable)
-    // Ugly asserts, but quickest way to print actual value it fails on...
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 2 )                   );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 4 )                   );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 8 )                   );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 16 )                  );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 32 )                  );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 64 )                  );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 128 )                 );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 256 )                 );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 512 )                 );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1024 )                );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 2048 )                );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 4096 )                );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 8192 )                );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 16384 )               );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 32768 )               );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 65536 )               );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 131072 )              );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 262144 )              );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 524288 )              );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1048576 )             );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 2097152 )             );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 4194304 )             );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 8388608 )             );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 16777216 )            );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 33554432 )            );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 67108864 )            );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 134217728 )           );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 268435456 )           );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 536870912 )           );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1073741824 )          );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 2147483648 )          );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 4294967296 )          );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 8589934592 )          );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 17179869184 )         );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 34359738368 )         );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 68719476736 )         );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 137438953472 )        );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 274877906944 )        );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 549755813888 )        );
-    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1099511627776 )       );
+    // Bit at a time CRC32C, nothing shared with the implementation under test
+    for ( size_t i = 0; i < count; ++i )
+    {
+        crc ^= pData[ i ];
+        for ( int bit = 0; bit < 8; ++bit )
+        {
+            crc = ( crc & 1 ) ? ( ( crc >> 1 ) ^ 0x82F63B78u ) : ( crc >> 1 );
+        }
+    }
 
-    // Test values around valid sizes (up to about 1TB, probably not reasonable)
-    // Ugly asserts, but quickest way to print actual value it fails on...
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1 )                   );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 3 )                   );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 7 )                   );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 15 )                  );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 31 )                  );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 63 )                  );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 127 )                 );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 255 )                 );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 511 )                 );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1023 )                );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 2047 )                );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 4095 )                );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 8191 )                );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 16383 )               );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 32767 )               );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 65535 )               );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 131071 )              );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 262143 )              );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 524287 )              );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1048575 )             );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 2097151 )             );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 4194303 )             );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 8388607 )             );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 16777215 )            );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 33554431 )            );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 67108863 )            );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 134217727 )           );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 268435455 )           );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 536870911 )           );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1073741823 )          );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 2147483647 )          );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 4294967295 )          );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 8589934591 )          );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 17179869183 )         );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 34359738367 )         );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 68719476735 )         );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 137438953471 )        );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 274877906943 )        );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 549755813887 )        );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1099511627775 )       );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 3 )                   );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 5 )                   );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 9 )                   );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 17 )                  );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 33 )                  );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 65 )                  );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 129 )                 );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 257 )                 );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 513 )                 );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1025 )                );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 2049 )                );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 4097 )                );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 8193 )                );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 16385 )               );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 32769 )               );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 65537 )               );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 131073 )              );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 262145 )              );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 524289 )              );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1048577 )             );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 2097153 )             );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 4194305 )             );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 8388609 )             );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 16777217 )            );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 33554433 )            );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 67108865 )            );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 134217729 )           );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 268435457 )           );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 536870913 )           );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1073741825 )          );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 2147483649 )          );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 4294967297 )          );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 8589934593 )          );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 17179869185 )         );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 34359738369 )         );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 68719476737 )         );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 137438953473 )        );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 274877906945 )        );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 549755813889 )        );
-    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1099511627777 )       );
+    return ~crc;
 }
 
+#ifdef ICIRCULARBUFFER_NOTIFY
 /**
  * *********************************************************************************************************************
- * Test
+ * Function
  * *********************************************************************************************************************
  */
-void Test_ICircularBuffer_GetCount( void )
+static bool NotifyReadable( int fd )
 {
-    CircularBuffer_t myBuffer;
-    uint8_t          data[ 32 ];
+    struct pollfd pollFd = { .fd = fd, .events = POLLIN };
+
+    return ( poll( &pollFd, 1, 0 ) == 1 ) && ( pollFd.revents & POLLIN );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static long NotifyCount( int fd )
+{
+    char path[ 64 ];
+    char line[ 128 ];
+    long count = -1;
+
+    // Count of an eventfd can be seen in fdinfo without reading (and so draining) it
+    snprintf( path, sizeof( path ), "/proc/self/fdinfo/%d", fd );
+    FILE *pFile = fopen( path, "r" );
+    if ( pFile == NULL )
+    {
+        return -1;
+    }
+    while ( fgets( line, sizeof( line ), pFile ) != NULL )
+    {
+        if ( sscanf( line, "eventfd-count: %lx", &count ) == 1 )
+        {
+            break;
+        }
+    }
+    fclose( pFile );
+
+    return count;
+}
+#endif
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *SpscStressProducer( void *pArg )
+{
+    CircularBufferSpsc_t *pCircularBuffer = (CircularBufferSpsc_t*)pArg;
+    uint8_t               chunk[ 61 ];
+    size_t                sent  = 0;
+    size_t                size  = 1;
+
+    while ( sent < SPSC_STRESS_BYTES )
+    {
+        // Vary chunk size to hit every wrap offset
+        size = ( size % sizeof( chunk ) ) + 1;
+        if ( size > ( SPSC_STRESS_BYTES - sent ) )
+        {
+            size = ( SPSC_STRESS_BYTES - sent );
+        }
+
+        for ( size_t i = 0; i < size; ++i )
+        {
+            chunk[ i ] = (uint8_t)( ( sent + i ) % 251 );
+        }
+
+        size_t pushed = 0;
+        while ( pushed < size )
+        {
+            size_t count = ICircularBufferSpsc_Push( pCircularBuffer, chunk + pushed, size - pushed );
+            if ( count == 0 )
+            {
+                // Buffer full, let the consumer run (matters on single core machines)
+                sched_yield();
+            }
+            pushed += count;
+        }
+        sent += size;
+    }
+
+    return NULL;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *SpscStressConsumer( void *pArg )
+{
+    CircularBufferSpsc_t *pCircularBuffer = (CircularBufferSpsc_t*)pArg;
+    uint8_t               chunk[ 37 ];
+    size_t                received = 0;
+    size_t                errors   = 0;
+
+    while ( received < SPSC_STRESS_BYTES )
+    {
+        size_t popped = ICircularBufferSpsc_Pop( pCircularBuffer, chunk, sizeof( chunk ) );
+        if ( popped == 0 )
+        {
+            // Buffer empty, let the producer run (matters on single core machines)
+            sched_yield();
+        }
+        for ( size_t i = 0; i < popped; ++i )
+        {
+            if ( chunk[ i ] != (uint8_t)( ( received + i ) % 251 ) )
+            {
+                ++errors;
+            }
+        }
+        received += popped;
+    }
+
+    return (void*)errors;
+}
+
+#ifdef ICIRCULARBUFFERSPSC_WAIT
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *SpscWaitProducer( void *pArg )
+{
+    CircularBufferSpsc_t *pCircularBuffer = (CircularBufferSpsc_t*)pArg;
+    uint8_t               chunk[ 61 ];
+    size_t                sent  = 0;
+    size_t                size  = 1;
+
+    while ( sent < SPSC_STRESS_BYTES )
+    {
+        size = ( size % sizeof( chunk ) ) + 1;
+        if ( size > ( SPSC_STRESS_BYTES - sent ) )
+        {
+            size = ( SPSC_STRESS_BYTES - sent );
+        }
+
+        for ( size_t i = 0; i < size; ++i )
+        {
+            chunk[ i ] = (uint8_t)( ( sent + i ) % 251 );
+        }
+
+        // Blocks while full, no yielding needed
+        size_t pushed = 0;
+        while ( pushed < size )
+        {
+            pushed += ICircularBufferSpsc_PushWait( pCircularBuffer, chunk + pushed, size - pushed,
+                                                    ICIRCULARBUFFERSPSC_WAIT_FOREVER );
+        }
+        sent += size;
+    }
+
+    return NULL;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *SpscWaitConsumer( void *pArg )
+{
+    CircularBufferSpsc_t *pCircularBuffer = (CircularBufferSpsc_t*)pArg;
+    uint8_t               chunk[ 37 ];
+    size_t                received = 0;
+    size_t                errors   = 0;
+
+    while ( received < SPSC_STRESS_BYTES )
+    {
+        // Blocks while empty, no yielding needed
+        size_t popped = ICircularBufferSpsc_PopWait( pCircularBuffer, chunk, sizeof( chunk ), ICIRCULARBUFFERSPSC_WAIT_FOREVER );
+        for ( size_t i = 0; i < popped; ++i )
+        {
+            if ( chunk[ i ] != (uint8_t)( ( received + i ) % 251 ) )
+            {
+                ++errors;
+            }
+        }
+        received += popped;
+    }
+
+    return (void*)errors;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *SpscWaitOne( void *pArg )
+{
+    CircularBufferSpsc_t *pCircularBuffer = (CircularBufferSpsc_t*)pArg;
+    uint8_t               value           = 0;
+
+    // Parks on the empty buffer until main thread pushes
+    ICircularBufferSpsc_PopWait( pCircularBuffer, &value, 1, 10000 );
+
+    return (void*)(size_t)value;
+}
+#endif
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int InitMpmcSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int CleanMpmcSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *SpscBatchProducer( void *pArg )
+{
+    CircularBufferSpsc_t *pCircularBuffer = (CircularBufferSpsc_t*)pArg;
+    uint64_t              sequence        = 0;
+    size_t                batch           = 1;
+
+    while ( sequence < ( SPSC_STRESS_BYTES / sizeof( sequence ) ) )
+    {
+        // Vary batch size, a batch ends early when the buffer is full
+        batch = ( batch % 13 ) + 1;
+        ICircularBufferSpsc_BeginBatch( pCircularBuffer );
+        for ( size_t i = 0; i < batch && sequence < ( SPSC_STRESS_BYTES / sizeof( sequence ) ); ++i )
+        {
+            if ( ICircularBufferSpsc_PushDeferred( pCircularBuffer, (uint8_t*)&sequence, sizeof( sequence ) ) == 0 )
+            {
+                break;
+            }
+            ++sequence;
+        }
+
+        if ( ICircularBufferSpsc_PublishBatch( pCircularBuffer ) == 0 )
+        {
+            // Buffer full, let the consumer run (matters on single core machines)
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *SpscBatchConsumer( void *pArg )
+{
+    CircularBufferSpsc_t *pCircularBuffer = (CircularBufferSpsc_t*)pArg;
+    uint64_t              items[ 11 ];
+    uint64_t              expected        = 0;
+    size_t                errors          = 0;
+
+    while ( expected < ( SPSC_STRESS_BYTES / sizeof( expected ) ) )
+    {
+        size_t count = ICircularBufferSpsc_PopBatch( pCircularBuffer, (uint8_t*)items, sizeof( items[ 0 ] ),
+                                                     ARR_SIZE( items ) );
+        if ( count == 0 )
+        {
+            // Buffer empty, let the producer run (matters on single core machines)
+            sched_yield();
+        }
+        for ( size_t i = 0; i < count; ++i )
+        {
+            if ( items[ i ] != expected++ )
+            {
+                ++errors;
+            }
+        }
+    }
+
+    return (void*)errors;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *MpmcStressProducer( void *pArg )
+{
+    MpmcStressArg_t   *pStressArg = (MpmcStressArg_t*)pArg;
+    MpmcTestElement_t element     = { .producer = pStressArg->index, .sequence = 0 };
+
+    while ( element.sequence < MPMC_STRESS_ELEMENTS )
+    {
+        if ( ICircularBufferMpmc_Push( pStressArg->pCircularBuffer, (uint8_t*)&element ) )
+        {
+            ++element.sequence;
+        }
+        else
+        {
+            // Buffer full, let the consumers run (matters on single core machines)
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *MpmcStressConsumer( void *pArg )
+{
+    MpmcStressArg_t   *pStressArg = (MpmcStressArg_t*)pArg;
+    MpmcTestElement_t element;
+    int64_t           lastSequence[ MPMC_STRESS_THREADS ];
+
+    for ( size_t i = 0; i < ARR_SIZE( lastSequence ); ++i )
+    {
+        lastSequence[ i ] = -1;
+    }
+
+    while ( atomic_load( pStressArg->pConsumed ) < ( MPMC_STRESS_THREADS * MPMC_STRESS_ELEMENTS ) )
+    {
+        if ( !ICircularBufferMpmc_Pop( pStressArg->pCircularBuffer, (uint8_t*)&element ) )
+        {
+            // Buffer empty, let the producers run (matters on single core machines)
+            sched_yield();
+            continue;
+        }
+
+        // FIFO means one consumer can never see elements from one producer out of order
+        if ( element.producer >= MPMC_STRESS_THREADS || (int64_t)element.sequence <= lastSequence[ element.producer ] )
+        {
+            ++pStressArg->errors;
+        }
+        else
+        {
+            lastSequence[ element.producer ] = element.sequence;
+        }
+
+        pStressArg->sum += element.sequence;
+        atomic_fetch_add( pStressArg->pConsumed, 1 );
+    }
+
+    return NULL;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int InitMirrorSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int CleanMirrorSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int InitOverwriteSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int CleanOverwriteSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int InitBroadcastSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int CleanBroadcastSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int InitFdSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int CleanFdSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int InitShmSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int CleanShmSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int InitTypedSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int CleanTypedSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int InitRecordSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int CleanRecordSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int InitGrowableSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int CleanGrowableSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int InitJournalSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int CleanJournalSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int InitShardedSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int CleanShardedSuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int InitLatencySuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+int CleanLatencySuite( void )
+{
+    // Nothing to do for now
+    return 0;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static size_t RecordFill( uint32_t sequence, uint8_t *pData )
+{
+    // Length and content both follow from the sequence number, so a record checks itself
+    size_t length = 1 + ( ( sequence * 7 ) % 40 );
+    for ( size_t i = 0; i < length; ++i )
+    {
+        pData[ i ] = (uint8_t)( sequence + i );
+    }
+
+    return length;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *GrowableAllocate( size_t size, void *pContext )
+{
+    GrowableTestAllocator_t *pAllocator = (GrowableTestAllocator_t*)pContext;
+    if ( pAllocator->fail )
+    {
+        return NULL;
+    }
+
+    pAllocator->allocations += 1;
+    pAllocator->bytesLive   += size;
+
+    return malloc( size );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void GrowableFree( void *pMemory, size_t size, void *pContext )
+{
+    GrowableTestAllocator_t *pAllocator = (GrowableTestAllocator_t*)pContext;
+
+    pAllocator->frees     += 1;
+    pAllocator->bytesLive -= size;
+    free( pMemory );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *ShardedStressProducer( void *pArg )
+{
+    ShardedStressArg_t *pStressArg = (ShardedStressArg_t*)pArg;
+    MpmcTestElement_t  element     = { .producer = pStressArg->index, .sequence = 0 };
+    size_t             shard;
+
+    if ( !ICircularBufferSharded_Attach( pStressArg->pSharded, &shard ) )
+    {
+        ++pStressArg->errors;
+        return NULL;
+    }
+
+    while ( element.sequence < SHARDED_STRESS_ELEMENTS )
+    {
+        if ( ICircularBufferSharded_Push( pStressArg->pSharded, shard, (uint8_t*)&element, sizeof( element ) ) > 0 )
+        {
+            ++element.sequence;
+        }
+        else
+        {
+            // Shard full, let the consumers run (matters on single core machines)
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *ShardedStressConsumer( void *pArg )
+{
+    ShardedStressArg_t *pStressArg = (ShardedStressArg_t*)pArg;
+    MpmcTestElement_t  batch[ 8 ];
+    int64_t            lastSequence[ SHARDED_STRESS_PRODUCERS ];
+    size_t             shard;
+
+    for ( size_t i = 0; i < ARR_SIZE( lastSequence ); ++i )
+    {
+        lastSequence[ i ] = -1;
+    }
+
+    while ( atomic_load( pStressArg->pConsumed ) < ( SHARDED_STRESS_PRODUCERS * SHARDED_STRESS_ELEMENTS ) )
+    {
+        size_t count = ICircularBufferSharded_Pop( pStressArg->pSharded, pStressArg->index, (uint8_t*)batch,
+                                                   sizeof( batch ), &shard ) / sizeof( batch[ 0 ] );
+        if ( count == 0 )
+        {
+            sched_yield();
+            continue;
+        }
+
+        if ( ( shard % SHARDED_STRESS_CONSUMERS ) != pStressArg->index )
+        {
+            ++pStressArg->stolen;
+        }
+
+        // A batch is from one producer, and one consumer never sees a producer's elements out of order
+        for ( size_t i = 0; i < count; ++i )
+        {
+            MpmcTestElement_t *pElement = &batch[ i ];
+            if (
+                ( pElement->producer >= SHARDED_STRESS_PRODUCERS ) ||
+                ( pElement->producer != batch[ 0 ].producer ) ||
+                ( (int64_t)pElement->sequence <= lastSequence[ pElement->producer ] )
+            )
+            {
+                ++pStressArg->errors;
+                continue;
+            }
+
+            lastSequence[ pElement->producer ] = pElement->sequence;
+            pStressArg->sum                   += pElement->sequence;
+        }
+
+        atomic_fetch_add( pStressArg->pConsumed, count );
+    }
+
+    return NULL;
+}
+
+#ifdef ICIRCULARBUFFER_READERS
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *OverwriteStressProducer( void *pArg )
+{
+    CircularBuffer_t *pCircularBuffer = (CircularBuffer_t*)pArg;
+    uint8_t          chunk[ 61 ];
+    size_t           sent = 0;
+    size_t           size = 1;
+
+    while ( sent < OVERWRITE_STRESS_BYTES )
+    {
+        size = ( size % sizeof( chunk ) ) + 1;
+        if ( size > ( OVERWRITE_STRESS_BYTES - sent ) )
+        {
+            size = ( OVERWRITE_STRESS_BYTES - sent );
+        }
+
+        for ( size_t i = 0; i < size; ++i )
+        {
+            chunk[ i ] = (uint8_t)( ( sent + i ) % 251 );
+        }
+
+        // Never blocks, the reader is lapped whenever it falls behind
+        sent += ICircularBuffer_Push( pCircularBuffer, chunk, size );
+        if ( ( sent % 4096 ) < size )
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *OverwriteStressReader( void *pArg )
+{
+    OverwriteStressArg_t *pStressArg = (OverwriteStressArg_t*)pArg;
+    uint8_t              chunk[ 37 ];
+    uint64_t             position    = 0;
+
+    while ( position < OVERWRITE_STRESS_BYTES )
+    {
+        uint64_t lost = 0;
+        size_t   read = ICircularBuffer_ReadAt( pStressArg->pCircularBuffer, &position, chunk, sizeof( chunk ), &lost );
+        if ( read == 0 )
+        {
+            sched_yield();
+        }
+
+        // Position is past the data read, so every byte can be checked against where it came from
+        for ( size_t i = 0; i < read; ++i )
+        {
+            if ( chunk[ i ] != (uint8_t)( ( position - read + i ) % 251 ) )
+            {
+                ++pStressArg->errors;
+            }
+        }
+        pStressArg->received += read;
+        pStressArg->lost     += lost;
+    }
+
+    return NULL;
+}
+#endif
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *BroadcastStressProducer( void *pArg )
+{
+    CircularBufferBroadcast_t *pCircularBuffer = (CircularBufferBroadcast_t*)pArg;
+    uint8_t                   chunk[ 61 ];
+    size_t                    sent = 0;
+    size_t                    size = 1;
+
+    while ( sent < BROADCAST_STRESS_BYTES )
+    {
+        size = ( size % sizeof( chunk ) ) + 1;
+        if ( size > ( BROADCAST_STRESS_BYTES - sent ) )
+        {
+            size = ( BROADCAST_STRESS_BYTES - sent );
+        }
+
+        for ( size_t i = 0; i < size; ++i )
+        {
+            chunk[ i ] = (uint8_t)( ( sent + i ) % 251 );
+        }
+
+        size_t pushed = 0;
+        while ( pushed < size )
+        {
+            size_t count = ICircularBufferBroadcast_Push( pCircularBuffer, chunk + pushed, size - pushed );
+            if ( count == 0 )
+            {
+                // Slowest reader is a full buffer behind, let it run (matters on single core machines)
+                sched_yield();
+            }
+            pushed += count;
+        }
+        sent += size;
+    }
+
+    return NULL;
+}
+
+/**
+ * *********************************************************************************************************************
+ * Function
+ * *********************************************************************************************************************
+ */
+static void *BroadcastStressReader( void *pArg )
+{
+    BroadcastStressArg_t *pStressArg = (BroadcastStressArg_t*)pArg;
+    uint8_t              chunk[ 37 ];
+    size_t               received    = 0;
+
+    while ( received < BROADCAST_STRESS_BYTES )
+    {
+        // Alternate between copying pop and zero-copy peek/release, readers at different chunk sizes
+        uint8_t const *pData  = chunk;
+        size_t        popped  = 0;
+        if ( ( received & 1 ) == 0 )
+        {
+            popped = ICircularBufferBroadcast_Pop( pStressArg->pCircularBuffer, pStressArg->reader, chunk,
+                                                   sizeof( chunk ) - pStressArg->reader );
+        }
+        else
+        {
+            popped = ICircularBufferBroadcast_Peek( pStressArg->pCircularBuffer, pStressArg->reader, &pData );
+        }
+
+        if ( popped == 0 )
+        {
+            sched_yield();
+        }
+        for ( size_t i = 0; i < popped; ++i )
+        {
+            if ( pData[ i ] != (uint8_t)( ( received + i ) % 251 ) )
+            {
+                ++pStressArg->errors;
+            }
+        }
+        if ( pData != chunk )
+        {
+            ICircularBufferBroadcast_Release( pStressArg->pCircularBuffer, pStressArg->reader, popped );
+        }
+        received += popped;
+    }
+
+    return NULL;
+}
+
+/**
+ * ---------------------------------------------------------------------------------------------------------------------
+ * Tests
+ * ---------------------------------------------------------------------------------------------------------------------
+ */
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_Init( void )
+{
+    CircularBuffer_t myBuffer;
+    uint8_t          data;     // We do not need an actual buffer, since we're not writing to it in this test
+
+   // Test bad input
+    CU_ASSERT_FALSE( ICircularBuffer_Init( NULL, NULL, 0 )                   );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, NULL, 0 )              );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, NULL, 256 )            );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 0 ) );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, NULL, 256 )            );
+
+    // Test valid input
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 256 ) );
+    CU_ASSERT_EQUAL( myBuffer.bufferSize, 256               );
+    CU_ASSERT_EQUAL( myBuffer.pBuffer,    (uint8_t*)&data );
+    CU_ASSERT_EQUAL( myBuffer.read,       0 );                // Dangerzone, relying on implementation.
+    CU_ASSERT_EQUAL( myBuffer.write,      0 );                // Dangerzone, relying on implementation.
+
+    // Test some valid and invalid buffer sizes (up to about 1TB, probably not reasonable)
+    // Ugly asserts, but quickest way to print actual value it fails on...
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 2 )                   );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 4 )                   );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 8 )                   );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 16 )                  );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 32 )                  );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 64 )                  );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 128 )                 );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 256 )                 );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 512 )                 );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1024 )                );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 2048 )                );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 4096 )                );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 8192 )                );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 16384 )               );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 32768 )               );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 65536 )               );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 131072 )              );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 262144 )              );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 524288 )              );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1048576 )             );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 2097152 )             );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 4194304 )             );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 8388608 )             );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 16777216 )            );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 33554432 )            );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 67108864 )            );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 134217728 )           );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 268435456 )           );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 536870912 )           );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1073741824 )          );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 2147483648 )          );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 4294967296 )          );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 8589934592 )          );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 17179869184 )         );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 34359738368 )         );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 68719476736 )         );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 137438953472 )        );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 274877906944 )        );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 549755813888 )        );
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1099511627776 )       );
+
+    // Test values around valid sizes (up to about 1TB, probably not reasonable)
+    // Ugly asserts, but quickest way to print actual value it fails on...
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1 )                   );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 3 )                   );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 7 )                   );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 15 )                  );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 31 )                  );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 63 )                  );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 127 )                 );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 255 )                 );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 511 )                 );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1023 )                );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 2047 )                );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 4095 )                );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 8191 )                );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 16383 )               );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 32767 )               );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 65535 )               );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 131071 )              );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 262143 )              );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 524287 )              );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1048575 )             );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 2097151 )             );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 4194303 )             );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 8388607 )             );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 16777215 )            );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 33554431 )            );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 67108863 )            );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 134217727 )           );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 268435455 )           );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 536870911 )           );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1073741823 )          );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 2147483647 )          );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 4294967295 )          );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 8589934591 )          );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 17179869183 )         );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 34359738367 )         );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 68719476735 )         );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 137438953471 )        );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 274877906943 )        );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 549755813887 )        );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1099511627775 )       );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 3 )                   );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 5 )                   );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 9 )                   );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 17 )                  );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 33 )                  );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 65 )                  );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 129 )                 );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 257 )                 );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 513 )                 );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1025 )                );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 2049 )                );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 4097 )                );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 8193 )                );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 16385 )               );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 32769 )               );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 65537 )               );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 131073 )              );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 262145 )              );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 524289 )              );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1048577 )             );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 2097153 )             );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 4194305 )             );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 8388609 )             );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 16777217 )            );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 33554433 )            );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 67108865 )            );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 134217729 )           );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 268435457 )           );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 536870913 )           );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1073741825 )          );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 2147483649 )          );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 4294967297 )          );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 8589934593 )          );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 17179869185 )         );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 34359738369 )         );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 68719476737 )         );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 137438953473 )        );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 274877906945 )        );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 549755813889 )        );
+    CU_ASSERT_FALSE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, 1099511627777 )       );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_GetCount( void )
+{
+    CircularBuffer_t myBuffer;
+    uint8_t          data[ 32 ];
 
     // Dummy-variables for pushing- and popping data
     uint8_t          dummyBuffer[ 32 ];
-    uint8_t          dummyData[ 32 ] = {
-        0,   1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
-        16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31
+    uint8_t          dummyData[ 32 ] = {
+        0,   1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+        16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31
+    };
+
+    // Initialize circular buffer
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Base case
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 0 );
+
+    // Without wraparound, from start
+    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 10 );  // 10 bytes written
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 10 ); // 0 bytes read
+
+    // Without wraparound, in middle
+    ICircularBuffer_Pop( &myBuffer, (uint8_t*)&dummyBuffer, 10 );
+    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData,  12 ); // 22 bytes written
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 12 ); // 10 bytes read
+
+    // To end of data buffer
+    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData,  10 ); // 32 bytes written
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 22 ); // 10 bytes read
+
+    // Wraparound
+    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData,   1 ); // 33 bytes written
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 23 ); // 10 bytes read
+
+    // Wraparound
+    ICircularBuffer_Pop( &myBuffer, (uint8_t*)&dummyBuffer, 10 );
+    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData,   7 ); // 33 bytes written
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 20 ); // 20 bytes read
+
+    // Full buffer, distinguishable from empty buffer
+    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData,  32 ); // 52 bytes written
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 32 ); // 20 bytes read
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_Peek( void )
+{
+    CircularBuffer_t myBuffer;
+    uint8_t          data[ 16 ];
+    uint8_t const    *pPeek = NULL;
+
+    uint8_t          dummyBuffer[ 16 ];
+    uint8_t          dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Test bad input
+    CU_ASSERT_EQUAL( ICircularBuffer_Peek( NULL, &pPeek ),     0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Peek( &myBuffer, NULL ),  0 );
+
+    // Empty buffer
+    CU_ASSERT_EQUAL( ICircularBuffer_Peek( &myBuffer, &pPeek ), 0 );
+
+    // Without wraparound
+    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 10 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Peek( &myBuffer, &pPeek ), 10 );
+    CU_ASSERT_EQUAL( pPeek, (uint8_t*)&data );
+    CU_ASSERT_EQUAL( memcmp( pPeek, dummyData, 10 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 10 ); // Peek does not remove anything
+
+    // With wraparound, only bytes until end of memory
+    ICircularBuffer_Pop( &myBuffer, (uint8_t*)&dummyBuffer, 8 );
+    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 10 );  // Written 20 bytes, 4 wrapped
+    CU_ASSERT_EQUAL( ICircularBuffer_Peek( &myBuffer, &pPeek ), 8 );
+    CU_ASSERT_EQUAL( pPeek, (uint8_t*)&data[ 8 ] );
+    CU_ASSERT_EQUAL( pPeek[ 0 ], 8 );
+    CU_ASSERT_EQUAL( pPeek[ 2 ], 0 );
+
+    // Remainder after the wrap
+    ICircularBuffer_Pop( &myBuffer, (uint8_t*)&dummyBuffer, 8 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Peek( &myBuffer, &pPeek ), 4 );
+    CU_ASSERT_EQUAL( pPeek, (uint8_t*)&data );
+    CU_ASSERT_EQUAL( memcmp( pPeek, &dummyData[ 6 ], 4 ), 0 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_PeekV( void )
+{
+    CircularBuffer_t        myBuffer;
+    uint8_t                 data[ 16 ];
+    CircularBufferSegment_t segments[ ICIRCULARBUFFER_SEGMENT_COUNT ];
+
+    uint8_t                 dummyBuffer[ 16 ];
+    uint8_t                 dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Test bad input
+    CU_ASSERT_EQUAL( ICircularBuffer_PeekV( NULL, segments ),    0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_PeekV( &myBuffer, NULL ),   0 );
+
+    // Empty buffer
+    CU_ASSERT_EQUAL( ICircularBuffer_PeekV( &myBuffer, segments ), 0 );
+    CU_ASSERT_EQUAL( segments[ 0 ].size, 0 );
+    CU_ASSERT_EQUAL( segments[ 1 ].size, 0 );
+
+    // Without wraparound, everything in first segment
+    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 10 );
+    CU_ASSERT_EQUAL( ICircularBuffer_PeekV( &myBuffer, segments ), 10 );
+    CU_ASSERT_EQUAL( segments[ 0 ].pData, (uint8_t*)&data );
+    CU_ASSERT_EQUAL( segments[ 0 ].size,  10 );
+    CU_ASSERT_EQUAL( segments[ 1 ].size,  0 );
+
+    // With wraparound, second segment from start of buffer memory
+    ICircularBuffer_Pop( &myBuffer, (uint8_t*)&dummyBuffer, 8 );
+    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 10 );   // Written 20 bytes, 4 wrapped
+    CU_ASSERT_EQUAL( ICircularBuffer_PeekV( &myBuffer, segments ), 12 );
+    CU_ASSERT_EQUAL( segments[ 0 ].pData, (uint8_t*)&data[ 8 ] );
+    CU_ASSERT_EQUAL( segments[ 0 ].size,  8 );
+    CU_ASSERT_EQUAL( segments[ 1 ].pData, (uint8_t*)&data );
+    CU_ASSERT_EQUAL( segments[ 1 ].size,  4 );
+    CU_ASSERT_EQUAL( memcmp( segments[ 1 ].pData, &dummyData[ 6 ], 4 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 12 );  // PeekV does not remove anything
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_Find( void )
+{
+    CircularBuffer_t myBuffer;
+    uint8_t          data[ 256 ];
+    uint8_t          dummyBuffer[ 256 ];
+    uint8_t          pattern[] = { '\r', '\n' };
+    size_t           offset;
+
+    memset( dummyBuffer, 'a', sizeof( dummyBuffer ) );
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Test bad input
+    CU_ASSERT_FALSE( ICircularBuffer_Find( NULL, 'a', 0, &offset ) );
+    CU_ASSERT_FALSE( ICircularBuffer_Find( &myBuffer, 'a', 0, NULL ) );
+    CU_ASSERT_FALSE( ICircularBuffer_FindPattern( NULL, pattern, 2, 0, &offset ) );
+    CU_ASSERT_FALSE( ICircularBuffer_FindPattern( &myBuffer, NULL, 2, 0, &offset ) );
+    CU_ASSERT_FALSE( ICircularBuffer_FindPattern( &myBuffer, pattern, 0, 0, &offset ) );
+    CU_ASSERT_FALSE( ICircularBuffer_FindPattern( &myBuffer, pattern, 2, 0, NULL ) );
+
+    // Empty buffer
+    CU_ASSERT_FALSE( ICircularBuffer_Find( &myBuffer, 'a', 0, &offset ) );
+    CU_ASSERT_FALSE( ICircularBuffer_FindPattern( &myBuffer, pattern, 2, 0, &offset ) );
+
+    // For every read position and every place of the byte, including across the wrap, the first one is found
+    for ( size_t start = 0; start < sizeof( data ); start += 37 )
+    {
+        CU_ASSERT_TRUE_FATAL( ICircularBuffer_Clear( &myBuffer ) );
+        ICircularBuffer_Push( &myBuffer, dummyBuffer, start );
+        ICircularBuffer_Release( &myBuffer, start );
+        ICircularBuffer_Push( &myBuffer, dummyBuffer, 200 );
+
+        CU_ASSERT_FALSE( ICircularBuffer_Find( &myBuffer, '\n', 0, &offset ) );
+        for ( size_t i = 0; i < 200; ++i )
+        {
+            data[ ( start + i ) % sizeof( data ) ] = '\n';
+            CU_ASSERT_TRUE( ICircularBuffer_Find( &myBuffer, '\n', 0, &offset ) );
+            CU_ASSERT_EQUAL( offset, i );
+            data[ ( start + i ) % sizeof( data ) ] = 'a';
+        }
+    }
+
+    // Search starts at from, and nothing is found at or past the end of data
+    data[ ( 222 + 10 ) % sizeof( data ) ] = '\n';
+    data[ ( 222 + 60 ) % sizeof( data ) ] = '\n';
+    CU_ASSERT_TRUE( ICircularBuffer_Find( &myBuffer, '\n', 10, &offset ) );
+    CU_ASSERT_EQUAL( offset, 10 );
+    CU_ASSERT_TRUE( ICircularBuffer_Find( &myBuffer, '\n', 11, &offset ) );
+    CU_ASSERT_EQUAL( offset, 60 );
+    CU_ASSERT_FALSE( ICircularBuffer_Find( &myBuffer, '\n', 61, &offset ) );
+    CU_ASSERT_FALSE( ICircularBuffer_Find( &myBuffer, '\n', 200, &offset ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 200 );  // Find does not remove anything
+
+    // Pattern needs all its bytes, a lone first byte is skipped
+    CU_ASSERT_FALSE( ICircularBuffer_FindPattern( &myBuffer, pattern, 2, 0, &offset ) );
+    data[ ( 222 + 59 ) % sizeof( data ) ] = '\r';
+    data[ ( 222 + 20 ) % sizeof( data ) ] = '\r';
+    CU_ASSERT_TRUE( ICircularBuffer_FindPattern( &myBuffer, pattern, 2, 0, &offset ) );
+    CU_ASSERT_EQUAL( offset, 59 );
+    CU_ASSERT_FALSE( ICircularBuffer_FindPattern( &myBuffer, pattern, 2, 60, &offset ) );
+
+    // Pattern split by end of buffer memory, read position 222 puts the wrap at offset 34
+    data[ 255 ] = '\r';
+    data[ 0 ]   = '\n';
+    CU_ASSERT_TRUE( ICircularBuffer_FindPattern( &myBuffer, pattern, 2, 0, &offset ) );
+    CU_ASSERT_EQUAL( offset, 33 );
+
+    // Pattern ending at last byte of data, pattern longer than data
+    data[ ( 222 + 198 ) % sizeof( data ) ] = '\r';
+    data[ ( 222 + 199 ) % sizeof( data ) ] = '\n';
+    CU_ASSERT_TRUE( ICircularBuffer_FindPattern( &myBuffer, pattern, 2, 60, &offset ) );
+    CU_ASSERT_EQUAL( offset, 198 );
+    CU_ASSERT_FALSE( ICircularBuffer_FindPattern( &myBuffer, pattern, 2, 199, &offset ) );
+    CU_ASSERT_FALSE( ICircularBuffer_FindPattern( &myBuffer, dummyBuffer, 201, 0, &offset ) );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_Pop( void )
+{
+    CircularBuffer_t myBuffer;
+    uint8_t          data[ 16 ];
+
+    uint8_t          dummyBuffer[ 16 ];
+    uint8_t          dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Test bad input
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( NULL, (uint8_t*)&dummyBuffer, 1 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, NULL, 1 ),             0 );
+
+    // Empty buffer
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, (uint8_t*)&dummyBuffer, 1 ), 0 );
+
+    // Pop less than available
+    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 12 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, (uint8_t*)&dummyBuffer, 5 ), 5 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData, 5 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 7 );
+
+    // Pop more than available, across wraparound
+    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 6 );   // Written 18 bytes, 2 wrapped
+    memset( dummyBuffer, 0xFF, sizeof( dummyBuffer ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, (uint8_t*)&dummyBuffer, 16 ), 13 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, &dummyData[ 5 ], 7 ), 0 );
+    CU_ASSERT_EQUAL( memcmp( &dummyBuffer[ 7 ], dummyData, 6 ), 0 );
+    CU_ASSERT_EQUAL( dummyBuffer[ 13 ], 0xFF );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 0 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_Push( void )
+{
+    CircularBuffer_t myBuffer;
+    uint8_t          data[ 16 ];
+
+    uint8_t          dummyBuffer[ 16 ];
+    uint8_t          dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Test bad input
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( NULL, (uint8_t*)&dummyData, 1 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, NULL, 1 ),           0 );
+
+    // Push into empty buffer
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 10 ), 10 );
+    CU_ASSERT_EQUAL( memcmp( data, dummyData, 10 ), 0 );
+
+    // Push across wraparound
+    ICircularBuffer_Pop( &myBuffer, (uint8_t*)&dummyBuffer, 10 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 8 ), 8 );
+    CU_ASSERT_EQUAL( memcmp( &data[ 10 ], dummyData, 6 ), 0 );
+    CU_ASSERT_EQUAL( memcmp( data, &dummyData[ 6 ], 2 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 8 );
+
+    // Push more than free, full capacity is usable
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 16 ), 8 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 16 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 1 ),  0 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_Reserve( void )
+{
+    CircularBuffer_t myBuffer;
+    uint8_t          data[ 16 ];
+    uint8_t          *pReserve = NULL;
+
+    uint8_t          dummyBuffer[ 16 ];
+    uint8_t          dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Test bad input
+    CU_ASSERT_EQUAL( ICircularBuffer_Reserve( NULL, &pReserve, 1 ),    0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Reserve( &myBuffer, NULL, 1 ),    0 );
+
+    // Empty buffer, limited by count and by buffer size
+    CU_ASSERT_EQUAL( ICircularBuffer_Reserve( &myBuffer, &pReserve, 4 ),  4 );
+    CU_ASSERT_EQUAL( pReserve, (uint8_t*)&data );
+    CU_ASSERT_EQUAL( ICircularBuffer_Reserve( &myBuffer, &pReserve, 32 ), 16 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 0 );   // Reserve does not add anything
+
+    // Limited by end of data buffer
+    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 12 );
+    ICircularBuffer_Pop( &myBuffer, (uint8_t*)&dummyBuffer, 10 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Reserve( &myBuffer, &pReserve, 16 ), 4 );
+    CU_ASSERT_EQUAL( pReserve, (uint8_t*)&data[ 12 ] );
+
+    // Full buffer
+    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 16 );
+    pReserve = NULL;
+    CU_ASSERT_EQUAL( ICircularBuffer_Reserve( &myBuffer, &pReserve, 16 ), 0 );
+    CU_ASSERT_PTR_NULL( pReserve );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_ReserveV( void )
+{
+    CircularBuffer_t        myBuffer;
+    uint8_t                 data[ 16 ];
+    CircularBufferSegment_t segments[ ICIRCULARBUFFER_SEGMENT_COUNT ];
+
+    uint8_t                 dummyBuffer[ 16 ];
+    uint8_t                 dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Test bad input
+    CU_ASSERT_EQUAL( ICircularBuffer_ReserveV( NULL, segments, 1 ),    0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_ReserveV( &myBuffer, NULL, 1 ),   0 );
+
+    // Empty buffer, limited by buffer size
+    CU_ASSERT_EQUAL( ICircularBuffer_ReserveV( &myBuffer, segments, 32 ), 16 );
+    CU_ASSERT_EQUAL( segments[ 0 ].size, 16 );
+    CU_ASSERT_EQUAL( segments[ 1 ].size, 0  );
+
+    // Free space wraps around, fill both segments and commit in one go
+    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 12 );
+    ICircularBuffer_Pop( &myBuffer, (uint8_t*)&dummyBuffer, 10 );
+    CU_ASSERT_EQUAL( ICircularBuffer_ReserveV( &myBuffer, segments, 10 ), 10 );
+    CU_ASSERT_EQUAL( segments[ 0 ].pData, (uint8_t*)&data[ 12 ] );
+    CU_ASSERT_EQUAL( segments[ 0 ].size,  4 );
+    CU_ASSERT_EQUAL( segments[ 1 ].pData, (uint8_t*)&data );
+    CU_ASSERT_EQUAL( segments[ 1 ].size,  6 );
+    memcpy( segments[ 0 ].pData, dummyData, segments[ 0 ].size );
+    memcpy( segments[ 1 ].pData, &dummyData[ segments[ 0 ].size ], segments[ 1 ].size );
+    CU_ASSERT_EQUAL( ICircularBuffer_Commit( &myBuffer, 10 ), 10 );
+
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, (uint8_t*)&dummyBuffer, 16 ), 12 );
+    CU_ASSERT_EQUAL( memcmp( &dummyBuffer[ 2 ], dummyData, 10 ), 0 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_Commit( void )
+{
+    CircularBuffer_t myBuffer;
+    uint8_t          data[ 16 ];
+    uint8_t          *pReserve = NULL;
+
+    uint8_t          dummyBuffer[ 16 ];
+    uint8_t          dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Test bad input
+    CU_ASSERT_EQUAL( ICircularBuffer_Commit( NULL, 1 ), 0 );
+
+    // Write directly into buffer memory
+    CU_ASSERT_EQUAL_FATAL( ICircularBuffer_Reserve( &myBuffer, &pReserve, 6 ), 6 );
+    memcpy( pReserve, dummyData, 6 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Commit( &myBuffer, 6 ), 6 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 6 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, (uint8_t*)&dummyBuffer, 16 ), 6 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData, 6 ), 0 );
+
+    // Commit wraps around end of data buffer, limited by free space
+    CU_ASSERT_EQUAL( ICircularBuffer_Commit( &myBuffer, 12 ), 12 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Commit( &myBuffer, 12 ), 4  );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 16 );
+    CU_ASSERT_EQUAL( myBuffer.write, 22 );                         // Dangerzone, relying on implementation.
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_Release( void )
+{
+    CircularBuffer_t myBuffer;
+    uint8_t          data[ 16 ];
+    uint8_t const    *pPeek = NULL;
+
+    uint8_t          dummyBuffer[ 16 ];
+    uint8_t          dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Test bad input and empty buffer
+    CU_ASSERT_EQUAL( ICircularBuffer_Release( NULL, 1 ),      0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Release( &myBuffer, 1 ), 0 );
+
+    // Consume data in place through peek
+    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 12 );
+    CU_ASSERT_EQUAL_FATAL( ICircularBuffer_Peek( &myBuffer, &pPeek ), 12 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Release( &myBuffer, 10 ), 10 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 2 );
+
+    // Release wraps around end of data buffer, limited by bytes in buffer
+    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 8 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Release( &myBuffer, 16 ), 10 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, (uint8_t*)&dummyBuffer, 16 ), 0 );
+    CU_ASSERT_EQUAL( myBuffer.read, 20 );                          // Dangerzone, relying on implementation.
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_Clear( void )
+{
+    CircularBuffer_t myBuffer;
+    uint8_t          data[ 16 ];
+
+    uint8_t          dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Test bad input
+    CU_ASSERT_FALSE( ICircularBuffer_Clear( NULL ) );
+
+    // Clear empty and filled buffer
+    CU_ASSERT_TRUE( ICircularBuffer_Clear( &myBuffer ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 0 );
+
+    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 10 );
+    CU_ASSERT_TRUE( ICircularBuffer_Clear( &myBuffer ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 0 );
+
+    // Full capacity available again after clear
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 16 ), 16 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_Statistics( void )
+{
+    CircularBuffer_t           myBuffer;
+    CircularBufferStatistics_t statistics;
+    uint8_t                    data[ 16 ];
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Test bad input
+    CU_ASSERT_FALSE( ICircularBuffer_GetStatistics( NULL, &statistics ) );
+    CU_ASSERT_FALSE( ICircularBuffer_GetStatistics( &myBuffer, NULL ) );
+    CU_ASSERT_FALSE( ICircularBuffer_ResetStatistics( NULL ) );
+
+#ifdef ICIRCULARBUFFER_STATISTICS
+    uint8_t dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    // Fresh buffer has no statistics
+    CU_ASSERT_TRUE( ICircularBuffer_GetStatistics( &myBuffer, &statistics ) );
+    CU_ASSERT_EQUAL( statistics.highWaterMark, 0 );
+    CU_ASSERT_EQUAL( statistics.bytesPushed, 0 );
+    CU_ASSERT_EQUAL( statistics.occupancy[ 0 ], 0 );
+
+    // Empty pop, then fill to 10, 16 (short push of 12) and drain to 0 again
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, (uint8_t*)&dummyData, 4 ), 0 );
+    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 10 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 12 ), 6 );
+    ICircularBuffer_Release( &myBuffer, 13 );
+    ICircularBuffer_Pop( &myBuffer, (uint8_t*)&dummyData, 16 );
+
+    CU_ASSERT_TRUE( ICircularBuffer_GetStatistics( &myBuffer, &statistics ) );
+    CU_ASSERT_EQUAL( statistics.highWaterMark, 16 );
+    CU_ASSERT_EQUAL( statistics.bytesPushed, 16 );
+    CU_ASSERT_EQUAL( statistics.bytesPopped, 16 );
+    CU_ASSERT_EQUAL( statistics.shortPushes, 1 );
+    CU_ASSERT_EQUAL( statistics.emptyPops, 1 );
+
+    // Occupancy after each operation: 0, 10, 16, 3, 0
+    CU_ASSERT_EQUAL( statistics.occupancy[ 0 ], 2 );
+    CU_ASSERT_EQUAL( statistics.occupancy[ 2 ], 1 );
+    CU_ASSERT_EQUAL( statistics.occupancy[ 4 ], 1 );
+    CU_ASSERT_EQUAL( statistics.occupancy[ 5 ], 1 );
+
+    // Reset starts over from current fill level
+    ICircularBuffer_Commit( &myBuffer, 5 );
+    CU_ASSERT_TRUE( ICircularBuffer_ResetStatistics( &myBuffer ) );
+    CU_ASSERT_TRUE( ICircularBuffer_GetStatistics( &myBuffer, &statistics ) );
+    CU_ASSERT_EQUAL( statistics.highWaterMark, 5 );
+    CU_ASSERT_EQUAL( statistics.bytesPushed, 0 );
+    CU_ASSERT_EQUAL( statistics.shortPushes, 0 );
+    CU_ASSERT_EQUAL( statistics.occupancy[ 0 ], 0 );
+#else
+    // Nothing kept unless built in
+    CU_ASSERT_FALSE( ICircularBuffer_GetStatistics( &myBuffer, &statistics ) );
+    CU_ASSERT_FALSE( ICircularBuffer_ResetStatistics( &myBuffer ) );
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_Notify( void )
+{
+    CircularBuffer_t myBuffer;
+    uint8_t          data[ 16 ];
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Test bad input
+    CU_ASSERT_EQUAL( ICircularBuffer_OpenDataFd( NULL ), -1 );
+    CU_ASSERT_EQUAL( ICircularBuffer_OpenSpaceFd( NULL, 8 ), -1 );
+    CU_ASSERT_EQUAL( ICircularBuffer_OpenSpaceFd( &myBuffer, 0 ), -1 );
+    CU_ASSERT_EQUAL( ICircularBuffer_OpenSpaceFd( &myBuffer, 17 ), -1 );
+    CU_ASSERT_FALSE( ICircularBuffer_CloseNotify( NULL ) );
+
+#ifdef ICIRCULARBUFFER_NOTIFY
+    uint8_t dummyBuffer[ 16 ];
+    uint8_t *pReserved;
+    uint8_t dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    int dataFd = ICircularBuffer_OpenDataFd( &myBuffer );
+    CU_ASSERT_FATAL( dataFd >= 0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_OpenDataFd( &myBuffer ), dataFd );
+    CU_ASSERT_FALSE( NotifyReadable( dataFd ) );
+
+    // Burst of pushes is one wakeup
+    ICircularBuffer_Push( &myBuffer, dummyData, 1 );
+    ICircularBuffer_Push( &myBuffer, dummyData, 2 );
+    ICircularBuffer_Push( &myBuffer, dummyData, 3 );
+    CU_ASSERT_TRUE( NotifyReadable( dataFd ) );
+    CU_ASSERT_EQUAL( NotifyCount( dataFd ), 1 );
+
+    // Readable until empty
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, dummyBuffer, 5 ), 5 );
+    CU_ASSERT_TRUE( NotifyReadable( dataFd ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_Release( &myBuffer, 16 ), 1 );
+    CU_ASSERT_FALSE( NotifyReadable( dataFd ) );
+    CU_ASSERT_EQUAL( NotifyCount( dataFd ), 0 );
+
+    // Space fd is readable right away on empty buffer, and follows threshold
+    int spaceFd = ICircularBuffer_OpenSpaceFd( &myBuffer, 8 );
+    CU_ASSERT_FATAL( spaceFd >= 0 );
+    CU_ASSERT_NOT_EQUAL( spaceFd, dataFd );
+    CU_ASSERT_TRUE( NotifyReadable( spaceFd ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_Reserve( &myBuffer, &pReserved, 9 ), 9 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Commit( &myBuffer, 9 ), 9 );
+    CU_ASSERT_FALSE( NotifyReadable( spaceFd ) );
+    CU_ASSERT_TRUE( NotifyReadable( dataFd ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, dummyBuffer, 1 ), 1 );
+    CU_ASSERT_TRUE( NotifyReadable( spaceFd ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, dummyBuffer, 1 ), 1 );
+    CU_ASSERT_EQUAL( NotifyCount( spaceFd ), 1 );
+
+    // Changing threshold updates fd right away
+    CU_ASSERT_EQUAL( ICircularBuffer_OpenSpaceFd( &myBuffer, 10 ), spaceFd );
+    CU_ASSERT_FALSE( NotifyReadable( spaceFd ) );
+
+    // Clear is an edge as well
+    CU_ASSERT_TRUE( ICircularBuffer_Clear( &myBuffer ) );
+    CU_ASSERT_FALSE( NotifyReadable( dataFd ) );
+    CU_ASSERT_TRUE( NotifyReadable( spaceFd ) );
+
+    // Opening with data already in buffer starts readable
+    CU_ASSERT_TRUE( ICircularBuffer_CloseNotify( &myBuffer ) );
+    ICircularBuffer_Push( &myBuffer, dummyData, 16 );
+    dataFd  = ICircularBuffer_OpenDataFd( &myBuffer );
+    spaceFd = ICircularBuffer_OpenSpaceFd( &myBuffer, 1 );
+    CU_ASSERT_TRUE( NotifyReadable( dataFd ) );
+    CU_ASSERT_FALSE( NotifyReadable( spaceFd ) );
+    CU_ASSERT_TRUE( ICircularBuffer_CloseNotify( &myBuffer ) );
+#else
+    // Nothing opened unless built in
+    CU_ASSERT_EQUAL( ICircularBuffer_OpenDataFd( &myBuffer ), -1 );
+    CU_ASSERT_EQUAL( ICircularBuffer_OpenSpaceFd( &myBuffer, 8 ), -1 );
+    CU_ASSERT_FALSE( ICircularBuffer_CloseNotify( &myBuffer ) );
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_Crc( void )
+{
+    CircularBuffer_t myBuffer;
+    uint8_t          data[ 64 ];
+    uint8_t          dummyData[ 256 ];
+    uint8_t          dummyBuffer[ 64 ];
+    uint8_t          *pReserved;
+    uint32_t         crc;
+    uint64_t         length;
+
+    for ( size_t i = 0; i < sizeof( dummyData ); ++i )
+    {
+        dummyData[ i ] = (uint8_t)( i * 31 + 7 );
+    }
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Test bad input
+    CU_ASSERT_FALSE( ICircularBuffer_CrcBegin( NULL ) );
+    CU_ASSERT_FALSE( ICircularBuffer_CrcGet( NULL, &crc, &length ) );
+    CU_ASSERT_FALSE( ICircularBuffer_CrcGet( &myBuffer, NULL, &length ) );
+
+#ifdef ICIRCULARBUFFER_CRC
+    // Empty range, then the CRC32C check value
+    CU_ASSERT_TRUE( ICircularBuffer_CrcGet( &myBuffer, &crc, &length ) );
+    CU_ASSERT_EQUAL( crc, 0 );
+    CU_ASSERT_EQUAL( length, 0 );
+    ICircularBuffer_Push( &myBuffer, (uint8_t*)"123456789", 9 );
+    CU_ASSERT_TRUE( ICircularBuffer_CrcGet( &myBuffer, &crc, NULL ) );
+    CU_ASSERT_EQUAL( crc, 0xE3069283u );
+
+    // Pushes of every length, wrapping around, add up to the CRC of all of it
+    CU_ASSERT_TRUE( ICircularBuffer_CrcBegin( &myBuffer ) );
+    size_t pushed = 0;
+    for ( size_t chunk = 1; ( pushed + chunk ) <= sizeof( dummyData ); ++chunk )
+    {
+        ICircularBuffer_Pop( &myBuffer, dummyBuffer, ICircularBuffer_GetCount( &myBuffer ) );
+        CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, &dummyData[ pushed ], chunk ), chunk );
+        pushed += chunk;
+
+        CU_ASSERT_TRUE( ICircularBuffer_CrcGet( &myBuffer, &crc, &length ) );
+        CU_ASSERT_EQUAL( crc, CrcReference( dummyData, pushed ) );
+        CU_ASSERT_EQUAL( length, pushed );
+    }
+
+    // Data written in place is checksummed when committed, a short push only counts what fit
+    ICircularBuffer_Pop( &myBuffer, dummyBuffer, ICircularBuffer_GetCount( &myBuffer ) );
+    CU_ASSERT_TRUE( ICircularBuffer_CrcBegin( &myBuffer ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_Reserve( &myBuffer, &pReserved, 5 ), 5 );
+    memcpy( pReserved, dummyData, 5 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Commit( &myBuffer, 5 ), 5 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, &dummyData[ 5 ], 100 ), sizeof( data ) - 5 );
+    CU_ASSERT_TRUE( ICircularBuffer_CrcGet( &myBuffer, &crc, &length ) );
+    CU_ASSERT_EQUAL( length, sizeof( data ) );
+    CU_ASSERT_EQUAL( crc, CrcReference( dummyData, sizeof( data ) ) );
+
+    // Popping leaves the checksum alone, it matches the data that came out
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, dummyBuffer, sizeof( dummyBuffer ) ), sizeof( data ) );
+    CU_ASSERT_EQUAL( CrcReference( dummyBuffer, sizeof( data ) ), crc );
+    CU_ASSERT_TRUE( ICircularBuffer_CrcGet( &myBuffer, &crc, &length ) );
+    CU_ASSERT_EQUAL( length, sizeof( data ) );
+
+    // Clear starts over
+    CU_ASSERT_TRUE( ICircularBuffer_Clear( &myBuffer ) );
+    CU_ASSERT_TRUE( ICircularBuffer_CrcGet( &myBuffer, &crc, &length ) );
+    CU_ASSERT_EQUAL( crc, 0 );
+    CU_ASSERT_EQUAL( length, 0 );
+
+    // Overwrite mode covers all data pushed, also what did not fit
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_InitOverwrite( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, dummyData, 100 ), 100 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, &dummyData[ 100 ], 156 ), 156 );
+    CU_ASSERT_TRUE( ICircularBuffer_CrcGet( &myBuffer, &crc, &length ) );
+    CU_ASSERT_EQUAL( length, sizeof( dummyData ) );
+    CU_ASSERT_EQUAL( crc, CrcReference( dummyData, sizeof( dummyData ) ) );
+#else
+    // No checksum unless built in
+    CU_ASSERT_FALSE( ICircularBuffer_CrcBegin( &myBuffer ) );
+    CU_ASSERT_FALSE( ICircularBuffer_CrcGet( &myBuffer, &crc, &length ) );
+    (void)dummyBuffer;
+    (void)pReserved;
+    (void)CrcReference;
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_Bulk( void )
+{
+    CircularBuffer_t myBuffer;
+    uint8_t          data[ 1024 ];
+    uint8_t          dummyData[ 4096 ];
+    uint8_t          dummyBuffer[ 4096 ];
+
+    for ( size_t i = 0; i < sizeof( dummyData ); ++i )
+    {
+        dummyData[ i ] = (uint8_t)( i * 31 + 7 );
+    }
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Test bad input
+    CU_ASSERT_FALSE( ICircularBuffer_SetBulkThreshold( NULL, 64 ) );
+
+    // Streamed pushes and pops of every length, misaligned and wrapping around, keep the data intact
+    for ( size_t threshold = 1; threshold <= 128; threshold *= 8 )
+    {
+        CU_ASSERT_TRUE( ICircularBuffer_SetBulkThreshold( &myBuffer, threshold ) );
+#ifdef ICIRCULARBUFFER_CRC
+        CU_ASSERT_TRUE( ICircularBuffer_CrcBegin( &myBuffer ) );
+#endif
+        size_t pushed = 0;
+        for ( size_t chunk = 1; ( pushed + chunk ) <= sizeof( dummyData ); chunk += 13 )
+        {
+            CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, &dummyData[ pushed ], chunk ), chunk );
+            CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, &dummyBuffer[ pushed ], chunk ), chunk );
+            pushed += chunk;
+        }
+        CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData, pushed ), 0 );
+#ifdef ICIRCULARBUFFER_CRC
+        uint32_t crc;
+        CU_ASSERT_TRUE( ICircularBuffer_CrcGet( &myBuffer, &crc, NULL ) );
+        CU_ASSERT_EQUAL( crc, CrcReference( dummyData, pushed ) );
+#endif
+        memset( dummyBuffer, 0, sizeof( dummyBuffer ) );
+    }
+
+    // A full buffer in one go, then back to memcpy
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, &dummyData[ 3 ], sizeof( dummyData ) ), sizeof( data ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, &dummyBuffer[ 5 ], sizeof( dummyBuffer ) ), sizeof( data ) );
+    CU_ASSERT_EQUAL( memcmp( &dummyBuffer[ 5 ], &dummyData[ 3 ], sizeof( data ) ), 0 );
+    CU_ASSERT_TRUE( ICircularBuffer_SetBulkThreshold( &myBuffer, 0 ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, dummyData, 100 ), 100 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, dummyBuffer, 100 ), 100 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData, 100 ), 0 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferSpsc_Init( void )
+{
+    CircularBufferSpsc_t myBuffer;
+    uint8_t              data;     // We do not need an actual buffer, since we're not writing to it in this test
+
+    // Test bad input
+    CU_ASSERT_FALSE( ICircularBufferSpsc_Init( NULL, NULL, 0 )                 );
+    CU_ASSERT_FALSE( ICircularBufferSpsc_Init( NULL, (uint8_t*)&data, 256 )    );
+    CU_ASSERT_FALSE( ICircularBufferSpsc_Init( &myBuffer, NULL, 256 )          );
+    CU_ASSERT_FALSE( ICircularBufferSpsc_Init( &myBuffer, (uint8_t*)&data, 0 ) );
+    CU_ASSERT_FALSE( ICircularBufferSpsc_Init( &myBuffer, (uint8_t*)&data, 1 ) );
+    CU_ASSERT_FALSE( ICircularBufferSpsc_Init( &myBuffer, (uint8_t*)&data, 255 ) );
+    CU_ASSERT_FALSE( ICircularBufferSpsc_Init( &myBuffer, (uint8_t*)&data, 257 ) );
+
+    // Test valid input
+    CU_ASSERT_TRUE( ICircularBufferSpsc_Init( &myBuffer, (uint8_t*)&data, 256 ) );
+    CU_ASSERT_EQUAL( myBuffer.bufferSize, 256 );
+    CU_ASSERT_EQUAL( myBuffer.pBuffer,    (uint8_t*)&data );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_GetCount( &myBuffer ), 0 );
+
+    // Producer state, consumer state and shared constants on separate cache lines
+    CU_ASSERT( ( (uintptr_t)&myBuffer.read    - (uintptr_t)&myBuffer.write ) >= ICIRCULARBUFFERSPSC_CACHE_LINE_SIZE );
+    CU_ASSERT( ( (uintptr_t)&myBuffer.pBuffer - (uintptr_t)&myBuffer.read  ) >= ICIRCULARBUFFERSPSC_CACHE_LINE_SIZE );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferSpsc_PushPop( void )
+{
+    CircularBufferSpsc_t myBuffer;
+    uint8_t              data[ 16 ];
+
+    uint8_t              dummyBuffer[ 16 ];
+    uint8_t              dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferSpsc_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Test bad input
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Push( NULL, dummyData, 1 ),       0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Push( &myBuffer, NULL, 1 ),       0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Pop( NULL, dummyBuffer, 1 ),      0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Pop( &myBuffer, NULL, 1 ),        0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Pop( &myBuffer, dummyBuffer, 1 ), 0 );
+
+    // Full capacity is usable since indices are free-running
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Push( &myBuffer, dummyData, 10 ), 10 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Push( &myBuffer, dummyData, 10 ), 6  );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_GetCount( &myBuffer ), 16 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Push( &myBuffer, dummyData, 1 ),  0  );
+
+    // Pop across wraparound
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Pop( &myBuffer, dummyBuffer, 12 ), 12 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Push( &myBuffer, dummyData, 8 ),   8  );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Pop( &myBuffer, dummyBuffer, 16 ), 12 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, &dummyData[ 2 ], 4 ), 0 );
+    CU_ASSERT_EQUAL( memcmp( &dummyBuffer[ 4 ], dummyData, 8 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_GetCount( &myBuffer ), 0 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferSpsc_Peek( void )
+{
+    CircularBufferSpsc_t myBuffer;
+    uint8_t              data[ 16 ];
+    uint8_t const        *pPeek = NULL;
+
+    uint8_t              dummyBuffer[ 16 ];
+    uint8_t              dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferSpsc_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Test bad input and empty buffer
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Peek( NULL, &pPeek ),      0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Peek( &myBuffer, NULL ),   0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Peek( &myBuffer, &pPeek ), 0 );
+
+    // With wraparound, only bytes until end of memory
+    ICircularBufferSpsc_Push( &myBuffer, dummyData, 12 );
+    ICircularBufferSpsc_Pop( &myBuffer, dummyBuffer, 10 );
+    ICircularBufferSpsc_Push( &myBuffer, dummyData, 8 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Peek( &myBuffer, &pPeek ), 6 );
+    CU_ASSERT_EQUAL( pPeek, (uint8_t*)&data[ 10 ] );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_GetCount( &myBuffer ), 10 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferSpsc_Clear( void )
+{
+    CircularBufferSpsc_t myBuffer;
+    uint8_t              data[ 16 ];
+
+    uint8_t              dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferSpsc_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    CU_ASSERT_FALSE( ICircularBufferSpsc_Clear( NULL ) );
+
+    ICircularBufferSpsc_Push( &myBuffer, dummyData, 10 );
+    CU_ASSERT_TRUE( ICircularBufferSpsc_Clear( &myBuffer ) );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_GetCount( &myBuffer ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Push( &myBuffer, dummyData, 16 ), 16 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferSpsc_Stress( void )
+{
+    CircularBufferSpsc_t myBuffer;
+    uint8_t              data[ 256 ];
+    pthread_t            producer;
+    pthread_t            consumer;
+    void                 *pErrors = NULL;
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferSpsc_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Stream a known sequence through the buffer from one real thread to another
+    CU_ASSERT_EQUAL_FATAL( pthread_create( &consumer, NULL, SpscStressConsumer, &myBuffer ), 0 );
+    CU_ASSERT_EQUAL_FATAL( pthread_create( &producer, NULL, SpscStressProducer, &myBuffer ), 0 );
+    pthread_join( producer, NULL );
+    pthread_join( consumer, &pErrors );
+
+    CU_ASSERT_EQUAL( (size_t)pErrors, 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_GetCount( &myBuffer ), 0 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferSpsc_Wait( void )
+{
+    CircularBufferSpsc_t myBuffer;
+    uint8_t              data[ 16 ];
+    uint8_t              dummyBuffer[ 16 ];
+    struct timespec      start;
+    struct timespec      end;
+    pthread_t            consumer;
+    void                 *pValue = NULL;
+
+    uint8_t              dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferSpsc_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+#ifdef ICIRCULARBUFFERSPSC_WAIT
+    // Test bad input
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PopWait( NULL, dummyBuffer, 1, ICIRCULARBUFFERSPSC_WAIT_FOREVER ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PopWait( &myBuffer, NULL, 1, ICIRCULARBUFFERSPSC_WAIT_FOREVER ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PopWait( &myBuffer, dummyBuffer, 0, ICIRCULARBUFFERSPSC_WAIT_FOREVER ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PushWait( NULL, dummyData, 1, ICIRCULARBUFFERSPSC_WAIT_FOREVER ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PushWait( &myBuffer, NULL, 1, ICIRCULARBUFFERSPSC_WAIT_FOREVER ), 0 );
+
+    // Zero timeout does not wait, and neither does a negative one other than forever
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PopWait( &myBuffer, dummyBuffer, 16, 0 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PopWait( &myBuffer, dummyBuffer, 16, -2 ), 0 );
+
+    // Empty buffer times out, after at least the timeout
+    clock_gettime( CLOCK_MONOTONIC, &start );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PopWait( &myBuffer, dummyBuffer, 16, 20 ), 0 );
+    clock_gettime( CLOCK_MONOTONIC, &end );
+    CU_ASSERT( ( ( end.tv_sec - start.tv_sec ) * 1000000000L + ( end.tv_nsec - start.tv_nsec ) ) >= 20000000L );
+
+    // Available data and free space are returned without waiting
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PushWait( &myBuffer, dummyData, 16, ICIRCULARBUFFERSPSC_WAIT_FOREVER ), 16 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PopWait( &myBuffer, dummyBuffer, 4, ICIRCULARBUFFERSPSC_WAIT_FOREVER ), 4 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData, 4 ), 0 );
+
+    // Full buffer times out
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PushWait( &myBuffer, dummyData, 16, ICIRCULARBUFFERSPSC_WAIT_FOREVER ), 4 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PushWait( &myBuffer, dummyData, 16, 0 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PushWait( &myBuffer, dummyData, 16, -1000 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PushWait( &myBuffer, dummyData, 16, 20 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PopWait( &myBuffer, dummyBuffer, 16, 20 ), 16 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData + 4, 12 ), 0 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer + 12, dummyData, 4 ), 0 );
+
+    // Parked consumer is woken by a push from another thread
+    CU_ASSERT_EQUAL_FATAL( pthread_create( &consumer, NULL, SpscWaitOne, &myBuffer ), 0 );
+    struct timespec delay = { .tv_sec = 0, .tv_nsec = 20000000L };
+    nanosleep( &delay, NULL );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Push( &myBuffer, &dummyData[ 7 ], 1 ), 1 );
+    pthread_join( consumer, &pValue );
+    CU_ASSERT_EQUAL( (size_t)pValue, 7 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_GetCount( &myBuffer ), 0 );
+#else
+    // Never waits unless built in
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PushWait( &myBuffer, dummyData, 16, ICIRCULARBUFFERSPSC_WAIT_FOREVER ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PopWait( &myBuffer, dummyBuffer, 16, ICIRCULARBUFFERSPSC_WAIT_FOREVER ), 0 );
+    (void)start;
+    (void)end;
+    (void)consumer;
+    (void)pValue;
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferSpsc_WaitStress( void )
+{
+    CircularBufferSpsc_t myBuffer;
+    uint8_t              data[ 64 ];
+    pthread_t            producer;
+    pthread_t            consumer;
+    void                 *pErrors = NULL;
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferSpsc_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+#ifdef ICIRCULARBUFFERSPSC_WAIT
+    // Small buffer makes both sides park often
+    CU_ASSERT_EQUAL_FATAL( pthread_create( &consumer, NULL, SpscWaitConsumer, &myBuffer ), 0 );
+    CU_ASSERT_EQUAL_FATAL( pthread_create( &producer, NULL, SpscWaitProducer, &myBuffer ), 0 );
+    pthread_join( producer, NULL );
+    pthread_join( consumer, &pErrors );
+
+    CU_ASSERT_EQUAL( (size_t)pErrors, 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_GetCount( &myBuffer ), 0 );
+#else
+    // Nothing blocks unless built in
+    (void)producer;
+    (void)consumer;
+    (void)pErrors;
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferSpsc_Batch( void )
+{
+    CircularBufferSpsc_t myBuffer;
+    uint8_t              data[ 16 ];
+
+    uint8_t              dummyBuffer[ 16 ];
+    uint8_t              dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferSpsc_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Test bad input
+    CU_ASSERT_FALSE( ICircularBufferSpsc_BeginBatch( NULL ) );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PushDeferred( NULL, dummyData, 1 ),          0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PushDeferred( &myBuffer, NULL, 1 ),          0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PublishBatch( NULL ),                        0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PopBatch( NULL, dummyBuffer, 4, 1 ),         0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PopBatch( &myBuffer, NULL, 4, 1 ),           0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PopBatch( &myBuffer, dummyBuffer, 0, 1 ),    0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PublishBatch( &myBuffer ),                   0 );
+
+    // Nothing visible before publishing, deferred pushes are all or nothing
+    CU_ASSERT_TRUE( ICircularBufferSpsc_BeginBatch( &myBuffer ) );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PushDeferred( &myBuffer, dummyData, 4 ), 4 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PushDeferred( &myBuffer, dummyData + 4, 8 ), 8 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PushDeferred( &myBuffer, dummyData, 5 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_GetCount( &myBuffer ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PopBatch( &myBuffer, dummyBuffer, 4, 4 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PublishBatch( &myBuffer ), 12 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_GetCount( &myBuffer ), 12 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PublishBatch( &myBuffer ), 0 );
+
+    // Whole items only, up to max
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PopBatch( &myBuffer, dummyBuffer, 5, 4 ), 2 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData, 10 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_GetCount( &myBuffer ), 2 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PopBatch( &myBuffer, dummyBuffer, 1, 1 ), 1 );
+    CU_ASSERT_EQUAL( dummyBuffer[ 0 ], 10 );
+
+    // Batch across wraparound, after a plain push
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Push( &myBuffer, dummyData, 3 ), 3 );
+    CU_ASSERT_TRUE( ICircularBufferSpsc_BeginBatch( &myBuffer ) );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PushDeferred( &myBuffer, dummyData, 8 ), 8 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PublishBatch( &myBuffer ), 8 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PopBatch( &myBuffer, dummyBuffer, 4, 16 ), 3 );
+    CU_ASSERT_EQUAL( dummyBuffer[ 0 ], 11 );
+    CU_ASSERT_EQUAL( memcmp( &dummyBuffer[ 1 ], dummyData, 3 ), 0 );
+    CU_ASSERT_EQUAL( memcmp( &dummyBuffer[ 4 ], dummyData, 8 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_GetCount( &myBuffer ), 0 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferSpsc_BatchStress( void )
+{
+    CircularBufferSpsc_t myBuffer;
+    uint8_t              data[ 256 ];
+    pthread_t            producer;
+    pthread_t            consumer;
+    void                 *pErrors = NULL;
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferSpsc_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Stream a counter through the buffer in batches of varying size from one real thread to another
+    CU_ASSERT_EQUAL_FATAL( pthread_create( &consumer, NULL, SpscBatchConsumer, &myBuffer ), 0 );
+    CU_ASSERT_EQUAL_FATAL( pthread_create( &producer, NULL, SpscBatchProducer, &myBuffer ), 0 );
+    pthread_join( producer, NULL );
+    pthread_join( consumer, &pErrors );
+
+    CU_ASSERT_EQUAL( (size_t)pErrors, 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_GetCount( &myBuffer ), 0 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferSpsc_Dwell( void )
+{
+#ifdef ICIRCULARBUFFERSPSC_DWELL
+    CircularBufferSpsc_t      myBuffer;
+    CircularBufferSpscStamp_t myStamps[ 2 ];
+    CircularBufferLatency_t   myLatency;
+    uint8_t                   data[ 16 ];
+    uint64_t                  dwell;
+
+    uint8_t                   dummyBuffer[ 16 ];
+    uint8_t                   dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+    struct timespec           delay           = { 0, 2 * 1000 * 1000 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferSpsc_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+    CU_ASSERT_TRUE_FATAL( ICircularBufferLatency_Init( &myLatency ) );
+
+    // Test bad input
+    CU_ASSERT_FALSE( ICircularBufferSpsc_TraceDwell( NULL, myStamps, 2, &myLatency ) );
+    CU_ASSERT_FALSE( ICircularBufferSpsc_TraceDwell( &myBuffer, NULL, 2, &myLatency ) );
+    CU_ASSERT_FALSE( ICircularBufferSpsc_TraceDwell( &myBuffer, myStamps, 2, NULL ) );
+    CU_ASSERT_FALSE( ICircularBufferSpsc_TraceDwell( &myBuffer, myStamps, 0, &myLatency ) );
+    CU_ASSERT_FALSE( ICircularBufferSpsc_TraceDwell( &myBuffer, myStamps, 3, &myLatency ) );
+
+    // Data queued before tracing starts is not measured
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Push( &myBuffer, dummyData, 4 ), 4 );
+    CU_ASSERT_TRUE( ICircularBufferSpsc_TraceDwell( &myBuffer, myStamps, ARR_SIZE( myStamps ), &myLatency ) );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Pop( &myBuffer, dummyBuffer, 4 ), 4 );
+    CU_ASSERT_EQUAL( ICircularBufferLatency_GetCount( &myLatency ), 0 );
+
+    // A push is measured once its last byte is popped
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Push( &myBuffer, dummyData, 8 ), 8 );
+    nanosleep( &delay, NULL );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Pop( &myBuffer, dummyBuffer, 5 ), 5 );
+    CU_ASSERT_EQUAL( ICircularBufferLatency_GetCount( &myLatency ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Pop( &myBuffer, dummyBuffer, 5 ), 3 );
+    CU_ASSERT_EQUAL( ICircularBufferLatency_GetCount( &myLatency ), 1 );
+    CU_ASSERT_TRUE( ICircularBufferLatency_GetPercentile( &myLatency, 100.0, &dwell ) );
+    CU_ASSERT( dwell >= 2 * 1000 * 1000 );
+
+    // One pop can finish several pushes, pushes beyond the stamps are not measured
+    CU_ASSERT_TRUE( ICircularBufferLatency_Reset( &myLatency ) );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Push( &myBuffer, dummyData, 2 ), 2 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Push( &myBuffer, dummyData, 2 ), 2 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Push( &myBuffer, dummyData, 2 ), 2 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Pop( &myBuffer, dummyBuffer, 6 ), 6 );
+    CU_ASSERT_EQUAL( ICircularBufferLatency_GetCount( &myLatency ), 2 );
+
+    // A batch is one push, across wraparound
+    CU_ASSERT_TRUE( ICircularBufferSpsc_BeginBatch( &myBuffer ) );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PushDeferred( &myBuffer, dummyData, 4 ), 4 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PushDeferred( &myBuffer, dummyData, 8 ), 8 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PublishBatch( &myBuffer ), 12 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PopBatch( &myBuffer, dummyBuffer, 4, 2 ), 2 );
+    CU_ASSERT_EQUAL( ICircularBufferLatency_GetCount( &myLatency ), 2 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_PopBatch( &myBuffer, dummyBuffer, 4, 2 ), 1 );
+    CU_ASSERT_EQUAL( ICircularBufferLatency_GetCount( &myLatency ), 3 );
+
+    // Cleared data is dropped without being measured, and frees its stamps
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Push( &myBuffer, dummyData, 4 ), 4 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Push( &myBuffer, dummyData, 4 ), 4 );
+    CU_ASSERT_TRUE( ICircularBufferSpsc_Clear( &myBuffer ) );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Push( &myBuffer, dummyData, 4 ), 4 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_Pop( &myBuffer, dummyBuffer, 4 ), 4 );
+    CU_ASSERT_EQUAL( ICircularBufferLatency_GetCount( &myLatency ), 4 );
+#else
+    // Nothing to trace unless built in
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferSpsc_DwellStress( void )
+{
+#ifdef ICIRCULARBUFFERSPSC_DWELL
+    CircularBufferSpsc_t      myBuffer;
+    CircularBufferSpscStamp_t myStamps[ 16 ];
+    CircularBufferLatency_t   myLatency;
+    uint8_t                   data[ 256 ];
+    pthread_t                 producer;
+    pthread_t                 consumer;
+    void                      *pErrors = NULL;
+    uint64_t                  p50;
+    uint64_t                  p99;
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferSpsc_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+    CU_ASSERT_TRUE_FATAL( ICircularBufferLatency_Init( &myLatency ) );
+    CU_ASSERT_TRUE_FATAL( ICircularBufferSpsc_TraceDwell( &myBuffer, myStamps, ARR_SIZE( myStamps ), &myLatency ) );
+
+    // Batches streamed from one real thread to another, with the histogram read while they run
+    CU_ASSERT_EQUAL_FATAL( pthread_create( &consumer, NULL, SpscBatchConsumer, &myBuffer ), 0 );
+    CU_ASSERT_EQUAL_FATAL( pthread_create( &producer, NULL, SpscBatchProducer, &myBuffer ), 0 );
+    for ( int i = 0; i < 100; ++i )
+    {
+        if ( ICircularBufferLatency_GetPercentile( &myLatency, 50.0, &p50 ) &&
+             ICircularBufferLatency_GetPercentile( &myLatency, 99.0, &p99 ) )
+        {
+            CU_ASSERT( p50 <= p99 );
+        }
+        sched_yield();
+    }
+    pthread_join( producer, NULL );
+    pthread_join( consumer, &pErrors );
+
+    CU_ASSERT_EQUAL( (size_t)pErrors, 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSpsc_GetCount( &myBuffer ), 0 );
+    CU_ASSERT( ICircularBufferLatency_GetCount( &myLatency ) > 0 );
+    CU_ASSERT_TRUE( ICircularBufferLatency_GetPercentile( &myLatency, 99.0, &p99 ) );
+#else
+    // Nothing to trace unless built in
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_InitOverwrite( void )
+{
+    CircularBuffer_t myBuffer;
+    uint8_t          data[ 16 ];
+
+    // Test bad input
+    CU_ASSERT_FALSE( ICircularBuffer_InitOverwrite( NULL, (uint8_t*)&data, sizeof( data ) ) );
+    CU_ASSERT_FALSE( ICircularBuffer_InitOverwrite( &myBuffer, NULL, sizeof( data ) ) );
+    CU_ASSERT_FALSE( ICircularBuffer_InitOverwrite( &myBuffer, (uint8_t*)&data, 15 ) );
+
+    CU_ASSERT_TRUE( ICircularBuffer_InitOverwrite( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+    CU_ASSERT_TRUE( myBuffer.overwrite );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetOverwritten( &myBuffer ), 0 );
+
+    // Regular init turns overwrite mode off
+    CU_ASSERT_TRUE( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+    CU_ASSERT_FALSE( myBuffer.overwrite );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_PushOverwrite( void )
+{
+    CircularBuffer_t myBuffer;
+    uint8_t          data[ 16 ];
+    uint8_t          dummyBuffer[ 32 ];
+
+    uint8_t          dummyData[ 32 ];
+
+    for ( size_t i = 0; i < sizeof( dummyData ); ++i )
+    {
+        dummyData[ i ] = (uint8_t)i;
+    }
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_InitOverwrite( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+    // Fill, then push past full: oldest 6 bytes are dropped
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, dummyData, 12 ), 12 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, dummyData + 12, 10 ), 10 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 16 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetOverwritten( &myBuffer ), 6 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, dummyBuffer, sizeof( dummyBuffer ) ), 16 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData + 6, 16 ), 0 );
+
+    // Push larger than buffer keeps the last part only
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, dummyData, 4 ), 4 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, dummyData, 20 ), 20 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetOverwritten( &myBuffer ), 6 + 4 + 4 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, dummyBuffer, sizeof( dummyBuffer ) ), 16 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData + 4, 16 ), 0 );
+
+    // Commit does not overwrite
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, dummyData, 10 ), 10 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Commit( &myBuffer, 10 ), 6 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetOverwritten( &myBuffer ), 14 );
+
+    // Clear starts over
+    CU_ASSERT_TRUE( ICircularBuffer_Clear( &myBuffer ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetOverwritten( &myBuffer ), 0 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_ReadAt( void )
+{
+    CircularBuffer_t myBuffer;
+    uint8_t          data[ 16 ];
+    uint8_t          dummyBuffer[ 32 ];
+    uint64_t         position = 0;
+    uint64_t         lost     = 0;
+
+    uint8_t          dummyData[ 32 ];
+
+    for ( size_t i = 0; i < sizeof( dummyData ); ++i )
+    {
+        dummyData[ i ] = (uint8_t)i;
+    }
+
+    // Test bad input, and only available in overwrite mode
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+    ICircularBuffer_Push( &myBuffer, dummyData, 4 );
+    CU_ASSERT_EQUAL( ICircularBuffer_ReadAt( &myBuffer, &position, dummyBuffer, 4, &lost ), 0 );
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_InitOverwrite( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+#ifdef ICIRCULARBUFFER_READERS
+    CU_ASSERT_EQUAL( ICircularBuffer_ReadAt( NULL, &position, dummyBuffer, 4, &lost ), 0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_ReadAt( &myBuffer, NULL, dummyBuffer, 4, &lost ), 0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_ReadAt( &myBuffer, &position, NULL, 4, &lost ), 0 );
+
+    // Nothing to read yet
+    CU_ASSERT_EQUAL( ICircularBuffer_ReadAt( &myBuffer, &position, dummyBuffer, 4, &lost ), 0 );
+    CU_ASSERT_EQUAL( position, 0 );
+
+    // Reading does not remove data
+    ICircularBuffer_Push( &myBuffer, dummyData, 10 );
+    CU_ASSERT_EQUAL( ICircularBuffer_ReadAt( &myBuffer, &position, dummyBuffer, 4, &lost ), 4 );
+    CU_ASSERT_EQUAL( position, 4 );
+    CU_ASSERT_EQUAL( lost, 0 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData, 4 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 10 );
+
+    // Lapped reader skips to oldest data and reports what it missed
+    ICircularBuffer_Push( &myBuffer, dummyData + 10, 20 );
+    CU_ASSERT_EQUAL( ICircularBuffer_ReadAt( &myBuffer, &position, dummyBuffer, sizeof( dummyBuffer ), &lost ), 16 );
+    CU_ASSERT_EQUAL( lost, 10 );
+    CU_ASSERT_EQUAL( position, 30 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData + 14, 16 ), 0 );
+
+    // Lost count is optional
+    ICircularBuffer_Push( &myBuffer, dummyData, 2 );
+    CU_ASSERT_EQUAL( ICircularBuffer_ReadAt( &myBuffer, &position, dummyBuffer, 4, NULL ), 2 );
+
+    // Clear keeps positions, a reader carries on with new data and a stale one still sees it was lapped
+    CU_ASSERT_TRUE( ICircularBuffer_Clear( &myBuffer ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_ReadAt( &myBuffer, &position, dummyBuffer, 4, &lost ), 0 );
+    CU_ASSERT_EQUAL( position, 32 );
+    ICircularBuffer_Push( &myBuffer, dummyData, 4 );
+    CU_ASSERT_EQUAL( ICircularBuffer_ReadAt( &myBuffer, &position, dummyBuffer, sizeof( dummyBuffer ), &lost ), 4 );
+    CU_ASSERT_EQUAL( lost, 0 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData, 4 ), 0 );
+    position = 4;
+    CU_ASSERT_EQUAL( ICircularBuffer_ReadAt( &myBuffer, &position, dummyBuffer, sizeof( dummyBuffer ), &lost ), 16 );
+    CU_ASSERT_EQUAL( lost, 16 );
+    CU_ASSERT_EQUAL( position, 36 );
+#else
+    // Nothing to read from other threads unless built in
+    ICircularBuffer_Push( &myBuffer, dummyData, 10 );
+    CU_ASSERT_EQUAL( ICircularBuffer_ReadAt( &myBuffer, &position, dummyBuffer, 4, &lost ), 0 );
+    CU_ASSERT_EQUAL( position, 0 );
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_OverwriteStress( void )
+{
+    CircularBuffer_t     myBuffer;
+    uint8_t              data[ 256 ];
+    pthread_t            producer;
+    pthread_t            reader;
+    OverwriteStressArg_t readerArg = { &myBuffer, 0, 0, 0 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_InitOverwrite( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+
+#ifdef ICIRCULARBUFFER_READERS
+    // Producer never waits, reader must never see torn data and must account for every byte
+    CU_ASSERT_EQUAL_FATAL( pthread_create( &reader,   NULL, OverwriteStressReader,   &readerArg ), 0 );
+    CU_ASSERT_EQUAL_FATAL( pthread_create( &producer, NULL, OverwriteStressProducer, &myBuffer  ), 0 );
+    pthread_join( producer, NULL );
+    pthread_join( reader, NULL );
+
+    CU_ASSERT_EQUAL( readerArg.errors, 0 );
+    CU_ASSERT_EQUAL( readerArg.received + readerArg.lost, OVERWRITE_STRESS_BYTES );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetOverwritten( &myBuffer ), OVERWRITE_STRESS_BYTES - sizeof( data ) );
+#else
+    // No concurrent reader unless built in
+    (void)producer;
+    (void)reader;
+    (void)readerArg;
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferBroadcast_Init( void )
+{
+    CircularBufferBroadcast_t       myBuffer;
+    CircularBufferBroadcastReader_t readers[ 3 ];
+    uint8_t                         data;     // We do not need an actual buffer, since we're not writing to it in this test
+
+    // Test bad input
+    CU_ASSERT_FALSE( ICircularBufferBroadcast_Init( NULL, (uint8_t*)&data, 256, readers, 3 )      );
+    CU_ASSERT_FALSE( ICircularBufferBroadcast_Init( &myBuffer, NULL, 256, readers, 3 )            );
+    CU_ASSERT_FALSE( ICircularBufferBroadcast_Init( &myBuffer, (uint8_t*)&data, 256, NULL, 3 )    );
+    CU_ASSERT_FALSE( ICircularBufferBroadcast_Init( &myBuffer, (uint8_t*)&data, 256, readers, 0 ) );
+    CU_ASSERT_FALSE( ICircularBufferBroadcast_Init( &myBuffer, (uint8_t*)&data, 0, readers, 3 )   );
+    CU_ASSERT_FALSE( ICircularBufferBroadcast_Init( &myBuffer, (uint8_t*)&data, 255, readers, 3 ) );
+
+    // Test valid input
+    CU_ASSERT_TRUE( ICircularBufferBroadcast_Init( &myBuffer, (uint8_t*)&data, 256, readers, 3 ) );
+    CU_ASSERT_EQUAL( myBuffer.bufferSize,  256 );
+    CU_ASSERT_EQUAL( myBuffer.readerCount, 3 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_GetCount( &myBuffer, 0 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_GetCount( &myBuffer, 3 ), 0 );
+
+    // Every reader cursor on its own cache line
+    CU_ASSERT( ( (uintptr_t)&readers[ 1 ].read - (uintptr_t)&readers[ 0 ].read ) >= ICIRCULARBUFFERBROADCAST_CACHE_LINE_SIZE );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferBroadcast_PushPop( void )
+{
+    CircularBufferBroadcast_t       myBuffer;
+    CircularBufferBroadcastReader_t readers[ 2 ];
+    uint8_t                         data[ 16 ];
+    uint8_t                         dummyBuffer[ 16 ];
+
+    uint8_t                         dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferBroadcast_Init( &myBuffer, (uint8_t*)&data, sizeof( data ), readers, 2 ) );
+
+    // Test bad input
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Push( NULL, dummyData, 4 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Push( &myBuffer, NULL, 4 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Pop( NULL, 0, dummyBuffer, 4 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Pop( &myBuffer, 0, NULL, 4 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Pop( &myBuffer, 2, dummyBuffer, 4 ), 0 );
+
+    // Every reader sees every byte
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Push( &myBuffer, dummyData, 10 ), 10 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_GetCount( &myBuffer, 0 ), 10 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_GetCount( &myBuffer, 1 ), 10 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Pop( &myBuffer, 0, dummyBuffer, 10 ), 10 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData, 10 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_GetCount( &myBuffer, 0 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_GetCount( &myBuffer, 1 ), 10 );
+
+    // Producer is throttled by the slowest reader
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Push( &myBuffer, dummyData, 16 ), 6 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Pop( &myBuffer, 1, dummyBuffer, 4 ), 4 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData, 4 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Push( &myBuffer, dummyData + 6, 10 ), 4 );
+
+    // Data wraps around the end of the buffer memory for both readers
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Pop( &myBuffer, 1, dummyBuffer, 16 ), 16 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData + 4, 6 ), 0 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer + 6, dummyData, 10 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Pop( &myBuffer, 0, dummyBuffer, 16 ), 10 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData, 10 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Push( &myBuffer, dummyData, 16 ), 16 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferBroadcast_PeekRelease( void )
+{
+    CircularBufferBroadcast_t       myBuffer;
+    CircularBufferBroadcastReader_t readers[ 2 ];
+    uint8_t                         data[ 16 ];
+    uint8_t const                   *pPeek = NULL;
+
+    uint8_t                         dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferBroadcast_Init( &myBuffer, (uint8_t*)&data, sizeof( data ), readers, 2 ) );
+
+    // Test bad input
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Peek( NULL, 0, &pPeek ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Peek( &myBuffer, 0, NULL ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Peek( &myBuffer, 2, &pPeek ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Release( NULL, 0, 4 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Release( &myBuffer, 2, 4 ), 0 );
+
+    // Both readers peek at the same bytes in buffer memory
+    ICircularBufferBroadcast_Push( &myBuffer, dummyData, 12 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Peek( &myBuffer, 0, &pPeek ), 12 );
+    CU_ASSERT_EQUAL( pPeek, data );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Release( &myBuffer, 0, 8 ), 8 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Peek( &myBuffer, 0, &pPeek ), 4 );
+    CU_ASSERT_EQUAL( pPeek, data + 8 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Peek( &myBuffer, 1, &pPeek ), 12 );
+    CU_ASSERT_EQUAL( pPeek, data );
+
+    // Peek stops at end of buffer memory, release is limited to what is available
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Release( &myBuffer, 1, 20 ), 12 );
+    ICircularBufferBroadcast_Push( &myBuffer, dummyData, 8 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Peek( &myBuffer, 1, &pPeek ), 4 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Release( &myBuffer, 1, 4 ), 4 );
+    CU_ASSERT_EQUAL( ICircularBufferBroadcast_Peek( &myBuffer, 1, &pPeek ), 4 );
+    CU_ASSERT_EQUAL( pPeek, data );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferBroadcast_Stress( void )
+{
+    CircularBufferBroadcast_t       myBuffer;
+    CircularBufferBroadcastReader_t readers[ BROADCAST_STRESS_READERS ];
+    BroadcastStressArg_t            readerArgs[ BROADCAST_STRESS_READERS ];
+    pthread_t                       readerThreads[ BROADCAST_STRESS_READERS ];
+    pthread_t                       producer;
+    uint8_t                         data[ 256 ];
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferBroadcast_Init( &myBuffer, (uint8_t*)&data, sizeof( data ), readers,
+                                                         BROADCAST_STRESS_READERS ) );
+
+    // Every reader must see the whole stream, in order
+    for ( size_t i = 0; i < BROADCAST_STRESS_READERS; ++i )
+    {
+        readerArgs[ i ].pCircularBuffer = &myBuffer;
+        readerArgs[ i ].reader          = i;
+        readerArgs[ i ].errors          = 0;
+        CU_ASSERT_EQUAL_FATAL( pthread_create( &readerThreads[ i ], NULL, BroadcastStressReader, &readerArgs[ i ] ), 0 );
+    }
+    CU_ASSERT_EQUAL_FATAL( pthread_create( &producer, NULL, BroadcastStressProducer, &myBuffer ), 0 );
+
+    pthread_join( producer, NULL );
+    for ( size_t i = 0; i < BROADCAST_STRESS_READERS; ++i )
+    {
+        pthread_join( readerThreads[ i ], NULL );
+        CU_ASSERT_EQUAL( readerArgs[ i ].errors, 0 );
+        CU_ASSERT_EQUAL( ICircularBufferBroadcast_GetCount( &myBuffer, i ), 0 );
+    }
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferFd_ReadFromFd( void )
+{
+    CircularBuffer_t myBuffer;
+    uint8_t          data[ 16 ];
+    uint8_t          dummyBuffer[ 16 ];
+    int              fds[ 2 ];
+
+    uint8_t          dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+    CU_ASSERT_EQUAL_FATAL( socketpair( AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, fds ), 0 );
+
+    // Test bad input
+    CU_ASSERT_EQUAL( ICircularBufferFd_ReadFromFd( NULL, fds[ 0 ], 16 ), -1 );
+    CU_ASSERT_EQUAL( errno, EINVAL );
+    CU_ASSERT_EQUAL( ICircularBufferFd_ReadFromFd( &myBuffer, -1, 16 ), -1 );
+    CU_ASSERT_EQUAL( errno, EBADF );
+    CU_ASSERT_EQUAL( ICircularBufferFd_ReadFromFd( &myBuffer, fds[ 0 ], 0 ), 0 );
+
+    // Nothing to read on non-blocking socket
+    CU_ASSERT_EQUAL( ICircularBufferFd_ReadFromFd( &myBuffer, fds[ 0 ], 16 ), -1 );
+    CU_ASSERT( errno == EAGAIN || errno == EWOULDBLOCK );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 0 );
+
+    // Read limited by max, then by what is available
+    CU_ASSERT_EQUAL( write( fds[ 1 ], dummyData, 12 ), 12 );
+    CU_ASSERT_EQUAL( ICircularBufferFd_ReadFromFd( &myBuffer, fds[ 0 ], 4 ), 4 );
+    CU_ASSERT_EQUAL( ICircularBufferFd_ReadFromFd( &myBuffer, fds[ 0 ], 16 ), 8 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 12 );
+
+    // Read into free space wrapping around the end of buffer memory
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, dummyBuffer, 12 ), 12 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData, 12 ), 0 );
+    CU_ASSERT_EQUAL( write( fds[ 1 ], dummyData, 16 ), 16 );
+    CU_ASSERT_EQUAL( ICircularBufferFd_ReadFromFd( &myBuffer, fds[ 0 ], 16 ), 16 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, dummyBuffer, 16 ), 16 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData, 16 ), 0 );
+
+    // Full buffer is reported instead of looking like end of file
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, dummyData, 16 ), 16 );
+    CU_ASSERT_EQUAL( ICircularBufferFd_ReadFromFd( &myBuffer, fds[ 0 ], 16 ), -1 );
+    CU_ASSERT_EQUAL( errno, ENOBUFS );
+
+    // End of file
+    ICircularBuffer_Clear( &myBuffer );
+    close( fds[ 1 ] );
+    CU_ASSERT_EQUAL( ICircularBufferFd_ReadFromFd( &myBuffer, fds[ 0 ], 16 ), 0 );
+    close( fds[ 0 ] );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferFd_WriteToFd( void )
+{
+    CircularBuffer_t myBuffer;
+    uint8_t          data[ 16 ];
+    uint8_t          dummyBuffer[ 16 ];
+    int              fds[ 2 ];
+
+    uint8_t          dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+    CU_ASSERT_EQUAL_FATAL( pipe2( fds, O_NONBLOCK ), 0 );
+
+    // Test bad input
+    CU_ASSERT_EQUAL( ICircularBufferFd_WriteToFd( NULL, fds[ 1 ], 16 ), -1 );
+    CU_ASSERT_EQUAL( errno, EINVAL );
+
+    // Nothing to write
+    CU_ASSERT_EQUAL( ICircularBufferFd_WriteToFd( &myBuffer, fds[ 1 ], 16 ), 0 );
+
+    // Write limited by max
+    ICircularBuffer_Push( &myBuffer, dummyData, 12 );
+    CU_ASSERT_EQUAL( ICircularBufferFd_WriteToFd( &myBuffer, fds[ 1 ], 5 ), 5 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 7 );
+
+    // Data wrapping around the end of buffer memory goes out in one call, max cutting into second segment
+    ICircularBuffer_Push( &myBuffer, dummyData + 12, 4 );
+    ICircularBuffer_Push( &myBuffer, dummyData, 5 );
+    CU_ASSERT_EQUAL( ICircularBufferFd_WriteToFd( &myBuffer, fds[ 1 ], 13 ), 13 );
+    CU_ASSERT_EQUAL( ICircularBufferFd_WriteToFd( &myBuffer, fds[ 1 ], 16 ), 3 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 0 );
+
+    CU_ASSERT_EQUAL( read( fds[ 0 ], dummyBuffer, sizeof( dummyBuffer ) ), 16 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData, 16 ), 0 );
+    CU_ASSERT_EQUAL( read( fds[ 0 ], dummyBuffer, sizeof( dummyBuffer ) ), 5 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData, 5 ), 0 );
+
+    close( fds[ 0 ] );
+    close( fds[ 1 ] );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferFd_Partial( void )
+{
+    static uint8_t   data[ 4 * 4096 ];
+    static uint8_t   dummyData[ 4 * 4096 ];
+    static uint8_t   dummyBuffer[ 4 * 4096 ];
+    CircularBuffer_t myBuffer;
+    int              fds[ 2 ];
+    int              pipeSize;
+
+    for ( size_t i = 0; i < sizeof( dummyData ); ++i )
+    {
+        dummyData[ i ] = (uint8_t)( i % 251 );
+    }
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+    CU_ASSERT_EQUAL_FATAL( pipe2( fds, O_NONBLOCK ), 0 );
+
+    // Shrink pipe to one page, so writing the whole buffer only partially succeeds
+    pipeSize = fcntl( fds[ 1 ], F_SETPIPE_SZ, 4096 );
+    CU_ASSERT_FATAL( pipeSize > 0 && pipeSize < (int)sizeof( data ) );
+
+    // Start off wrapped
+    ICircularBuffer_Push( &myBuffer, dummyData, 100 );
+    ICircularBuffer_Release( &myBuffer, 100 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, dummyData, sizeof( dummyData ) ), sizeof( dummyData ) );
+
+    // Partial write only removes what the pipe took, full pipe gives EAGAIN and keeps the rest
+    CU_ASSERT_EQUAL( ICircularBufferFd_WriteToFd( &myBuffer, fds[ 1 ], sizeof( data ) ), pipeSize );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), sizeof( data ) - pipeSize );
+    CU_ASSERT_EQUAL( ICircularBufferFd_WriteToFd( &myBuffer, fds[ 1 ], sizeof( data ) ), -1 );
+    CU_ASSERT( errno == EAGAIN || errno == EWOULDBLOCK );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), sizeof( data ) - pipeSize );
+
+    // Alternate draining the pipe and writing more, the stream must survive being split over calls
+    size_t received = 0;
+    while ( received < sizeof( dummyData ) )
+    {
+        CU_ASSERT_EQUAL_FATAL( read( fds[ 0 ], dummyBuffer + received, sizeof( dummyBuffer ) - received ), pipeSize );
+        received += pipeSize;
+        if ( received < sizeof( dummyData ) )
+        {
+            CU_ASSERT_EQUAL_FATAL( ICircularBufferFd_WriteToFd( &myBuffer, fds[ 1 ], sizeof( data ) ), pipeSize );
+        }
+    }
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData, sizeof( dummyData ) ), 0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 0 );
+
+    close( fds[ 0 ] );
+    close( fds[ 1 ] );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferShm_CreateAttach( void )
+{
+    CircularBufferShm_t myProducer;
+    CircularBufferShm_t myConsumer;
+    char                name[ 64 ];
+
+    snprintf( name, sizeof( name ), "/CircularBufferTest%d", (int)getpid() );
+    ICircularBufferShm_Unlink( name );
+
+    // Test bad input
+    CU_ASSERT_FALSE( ICircularBufferShm_Create( NULL, name, 64 ) );
+    CU_ASSERT_FALSE( ICircularBufferShm_Create( &myProducer, NULL, 64 ) );
+    CU_ASSERT_FALSE( ICircularBufferShm_Create( &myProducer, name, 0 ) );
+    CU_ASSERT_FALSE( ICircularBufferShm_Create( &myProducer, name, 63 ) );
+    CU_ASSERT_FALSE( ICircularBufferShm_Attach( NULL, name ) );
+    CU_ASSERT_FALSE( ICircularBufferShm_Attach( &myConsumer, NULL ) );
+    CU_ASSERT_FALSE( ICircularBufferShm_Detach( NULL ) );
+    CU_ASSERT_FALSE( ICircularBufferShm_Unlink( NULL ) );
+
+    // Nothing to attach to yet
+    CU_ASSERT_FALSE( ICircularBufferShm_Attach( &myConsumer, name ) );
+
+    // Create once, second create with same name fails
+    CU_ASSERT_TRUE_FATAL( ICircularBufferShm_Create( &myProducer, name, 64 ) );
+    CU_ASSERT_FALSE( ICircularBufferShm_Create( &myConsumer, name, 64 ) );
+    CU_ASSERT_EQUAL( ICircularBufferShm_GetCount( &myProducer ), 0 );
+
+    // Attach checks magic number and layout version
+    atomic_store( &myProducer.pHeader->magic, 0 );
+    CU_ASSERT_FALSE( ICircularBufferShm_Attach( &myConsumer, name ) );
+    atomic_store( &myProducer.pHeader->magic, ICIRCULARBUFFERSHM_MAGIC );
+    myProducer.pHeader->version = ICIRCULARBUFFERSHM_VERSION + 1;
+    CU_ASSERT_FALSE( ICircularBufferShm_Attach( &myConsumer, name ) );
+    myProducer.pHeader->version = ICIRCULARBUFFERSHM_VERSION;
+
+    // Attach checks sizes against mapping, without overflowing, and data alignment
+    myProducer.pHeader->bufferSize = 128;
+    CU_ASSERT_FALSE( ICircularBufferShm_Attach( &myConsumer, name ) );
+    myProducer.pHeader->bufferSize = (uint64_t)1 << 63;
+    myProducer.pHeader->dataOffset = ( (uint64_t)1 << 63 ) + ICIRCULARBUFFERSHM_CACHE_LINE_SIZE;
+    CU_ASSERT_FALSE( ICircularBufferShm_Attach( &myConsumer, name ) );
+    myProducer.pHeader->bufferSize = 64;
+    myProducer.pHeader->dataOffset = sizeof( CircularBufferShmHeader_t ) + 1;
+    CU_ASSERT_FALSE( ICircularBufferShm_Attach( &myConsumer, name ) );
+    myProducer.pHeader->dataOffset = (uint64_t)( (uint8_t*)myProducer.pBuffer - (uint8_t*)myProducer.pHeader );
+
+    // Second mapping of same memory, at another address
+    CU_ASSERT_TRUE_FATAL( ICircularBufferShm_Attach( &myConsumer, name ) );
+    CU_ASSERT_NOT_EQUAL( (void*)myConsumer.pHeader, (void*)myProducer.pHeader );
+    CU_ASSERT_EQUAL( myConsumer.bufferSize, 64 );
+
+    // Detach, only once
+    CU_ASSERT_TRUE( ICircularBufferShm_Detach( &myConsumer ) );
+    CU_ASSERT_FALSE( ICircularBufferShm_Detach( &myConsumer ) );
+    CU_ASSERT_EQUAL( ICircularBufferShm_Pop( &myConsumer, (uint8_t*)name, 1 ), 0 );
+    CU_ASSERT_TRUE( ICircularBufferShm_Detach( &myProducer ) );
+
+    // Unlinked name can no longer be attached to
+    CU_ASSERT_TRUE( ICircularBufferShm_Unlink( name ) );
+    CU_ASSERT_FALSE( ICircularBufferShm_Unlink( name ) );
+    CU_ASSERT_FALSE( ICircularBufferShm_Attach( &myConsumer, name ) );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferShm_PushPop( void )
+{
+    CircularBufferShm_t myProducer;
+    CircularBufferShm_t myConsumer;
+    char                name[ 64 ];
+    uint8_t             dummyBuffer[ 16 ];
+
+    uint8_t             dummyData[ 16 ] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+    snprintf( name, sizeof( name ), "/CircularBufferTest%d", (int)getpid() );
+    ICircularBufferShm_Unlink( name );
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferShm_Create( &myProducer, name, 16 ) );
+    CU_ASSERT_TRUE_FATAL( ICircularBufferShm_Attach( &myConsumer, name ) );
+
+    // Test bad input
+    CU_ASSERT_EQUAL( ICircularBufferShm_Push( NULL, dummyData, 1 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferShm_Push( &myProducer, NULL, 1 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferShm_Pop( NULL, dummyBuffer, 1 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferShm_Pop( &myConsumer, NULL, 1 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferShm_GetCount( NULL ), 0 );
+
+    // Data pushed through one mapping is popped through the other
+    CU_ASSERT_EQUAL( ICircularBufferShm_Pop( &myConsumer, dummyBuffer, 16 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferShm_Push( &myProducer, dummyData, 10 ), 10 );
+    CU_ASSERT_EQUAL( ICircularBufferShm_GetCount( &myConsumer ), 10 );
+    CU_ASSERT_EQUAL( ICircularBufferShm_Pop( &myConsumer, dummyBuffer, 16 ), 10 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData, 10 ), 0 );
+
+    // Wrap around end of buffer memory, limited by free space
+    CU_ASSERT_EQUAL( ICircularBufferShm_Push( &myProducer, dummyData, 16 ), 16 );
+    CU_ASSERT_EQUAL( ICircularBufferShm_Push( &myProducer, dummyData, 16 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferShm_GetCount( &myProducer ), 16 );
+    CU_ASSERT_EQUAL( ICircularBufferShm_Pop( &myConsumer, dummyBuffer, 4 ), 4 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData, 4 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferShm_Push( &myProducer, dummyData, 16 ), 4 );
+    CU_ASSERT_EQUAL( ICircularBufferShm_Pop( &myConsumer, dummyBuffer, 16 ), 16 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData + 4, 12 ), 0 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer + 12, dummyData, 4 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferShm_GetCount( &myConsumer ), 0 );
+
+    ICircularBufferShm_Detach( &myConsumer );
+    ICircularBufferShm_Detach( &myProducer );
+    ICircularBufferShm_Unlink( name );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferShm_Process( void )
+{
+    CircularBufferShm_t myConsumer;
+    char                name[ 64 ];
+    uint8_t             chunk[ 333 ];
+    size_t              received = 0;
+    size_t              errors   = 0;
+    int                 status   = -1;
+
+    snprintf( name, sizeof( name ), "/CircularBufferTest%d", (int)getpid() );
+    ICircularBufferShm_Unlink( name );
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferShm_Create( &myConsumer, name, 4096 ) );
+
+    pid_t child = fork();
+    CU_ASSERT_FATAL( child >= 0 );
+    if ( child == 0 )
+    {
+        // Child process attaches by name and produces a counting byte pattern, odd sized chunks to hit every wrap
+        CircularBufferShm_t myProducer;
+        if ( !ICircularBufferShm_Attach( &myProducer, name ) )
+        {
+            _exit( 1 );
+        }
+
+        uint8_t pattern[ 251 ];
+        size_t  sent = 0;
+        while ( sent < SHM_STRESS_BYTES )
+        {
+            size_t count = ( ( SHM_STRESS_BYTES - sent ) < sizeof( pattern ) ) ? ( SHM_STRESS_BYTES - sent ) : sizeof( pattern );
+            for ( size_t i = 0; i < count; ++i )
+            {
+                pattern[ i ] = (uint8_t)( ( sent + i ) % 251 );
+            }
+
+            size_t pushed = 0;
+            while ( pushed < count )
+            {
+                size_t n = ICircularBufferShm_Push( &myProducer, pattern + pushed, count - pushed );
+                if ( n == 0 )
+                {
+                    sched_yield();
+                }
+                pushed += n;
+            }
+            sent += count;
+        }
+
+        ICircularBufferShm_Detach( &myProducer );
+        _exit( 0 );
+    }
+
+    while ( received < SHM_STRESS_BYTES )
+    {
+        size_t count = ICircularBufferShm_Pop( &myConsumer, chunk, sizeof( chunk ) );
+        if ( count == 0 )
+        {
+            if ( waitpid( child, &status, WNOHANG ) == child )
+            {
+                // Child gone, drain what is left and stop
+                child = -1;
+                count = ICircularBufferShm_Pop( &myConsumer, chunk, sizeof( chunk ) );
+                if ( count == 0 )
+                {
+                    break;
+                }
+            }
+            else
+            {
+                sched_yield();
+            }
+        }
+
+        for ( size_t i = 0; i < count; ++i )
+        {
+            if ( chunk[ i ] != (uint8_t)( ( received + i ) % 251 ) )
+            {
+                ++errors;
+            }
+        }
+        received += count;
+    }
+
+    if ( child > 0 )
+    {
+        waitpid( child, &status, 0 );
+    }
+
+    CU_ASSERT_TRUE( WIFEXITED( status ) );
+    CU_ASSERT_EQUAL( WEXITSTATUS( status ), 0 );
+    CU_ASSERT_EQUAL( received, SHM_STRESS_BYTES );
+    CU_ASSERT_EQUAL( errors, 0 );
+    CU_ASSERT_EQUAL( ICircularBufferShm_GetCount( &myConsumer ), 0 );
+
+    ICircularBufferShm_Detach( &myConsumer );
+    ICircularBufferShm_Unlink( name );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferTyped_PushPop( void )
+{
+    TypedTestRing_t   myBuffer;
+    MpmcTestElement_t element;
+
+    // Test bad input
+    CU_ASSERT_FALSE( TypedTestRing_Init( NULL ) );
+    CU_ASSERT_TRUE_FATAL( TypedTestRing_Init( &myBuffer ) );
+    CU_ASSERT_FALSE( TypedTestRing_Push( NULL, &element ) );
+    CU_ASSERT_FALSE( TypedTestRing_Push( &myBuffer, NULL ) );
+    CU_ASSERT_FALSE( TypedTestRing_Pop( NULL, &element ) );
+    CU_ASSERT_FALSE( TypedTestRing_Pop( &myBuffer, NULL ) );
+    CU_ASSERT_EQUAL( TypedTestRing_GetCount( NULL ), 0 );
+    CU_ASSERT_PTR_NULL( TypedTestRing_Peek( NULL ) );
+
+    // Empty
+    CU_ASSERT_FALSE( TypedTestRing_Pop( &myBuffer, &element ) );
+    CU_ASSERT_PTR_NULL( TypedTestRing_Peek( &myBuffer ) );
+
+    // Fill up, one more does not fit
+    for ( uint32_t i = 0; i < 8; ++i )
+    {
+        element.producer = 1;
+        element.sequence = i;
+        CU_ASSERT_TRUE( TypedTestRing_Push( &myBuffer, &element ) );
+    }
+    CU_ASSERT_FALSE( TypedTestRing_Push( &myBuffer, &element ) );
+    CU_ASSERT_EQUAL( TypedTestRing_GetCount( &myBuffer ), 8 );
+
+    // Elements come out in order, also after wrapping around
+    for ( uint32_t i = 0; i < 20; ++i )
+    {
+        CU_ASSERT_PTR_NOT_NULL_FATAL( TypedTestRing_Peek( &myBuffer ) );
+        CU_ASSERT_EQUAL( TypedTestRing_Peek( &myBuffer )->sequence, i );
+        CU_ASSERT_TRUE( TypedTestRing_Pop( &myBuffer, &element ) );
+        CU_ASSERT_EQUAL( element.sequence, i );
+
+        element.sequence = i + 8;
+        CU_ASSERT_TRUE( TypedTestRing_Push( &myBuffer, &element ) );
+    }
+    CU_ASSERT_EQUAL( TypedTestRing_GetCount( &myBuffer ), 8 );
+
+    CU_ASSERT_FALSE( TypedTestRing_Clear( NULL ) );
+    CU_ASSERT_TRUE( TypedTestRing_Clear( &myBuffer ) );
+    CU_ASSERT_EQUAL( TypedTestRing_GetCount( &myBuffer ), 0 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferTyped_PushNPopN( void )
+{
+    TypedTestRing_t   myBuffer;
+    MpmcTestElement_t elements[ 12 ];
+    MpmcTestElement_t popped[ 12 ];
+
+    for ( uint32_t i = 0; i < ARR_SIZE( elements ); ++i )
+    {
+        elements[ i ].producer = 2;
+        elements[ i ].sequence = i;
+    }
+
+    CU_ASSERT_TRUE_FATAL( TypedTestRing_Init( &myBuffer ) );
+
+    // Test bad input
+    CU_ASSERT_EQUAL( TypedTestRing_PushN( NULL, elements, 1 ), 0 );
+    CU_ASSERT_EQUAL( TypedTestRing_PushN( &myBuffer, NULL, 1 ), 0 );
+    CU_ASSERT_EQUAL( TypedTestRing_PopN( NULL, popped, 1 ), 0 );
+    CU_ASSERT_EQUAL( TypedTestRing_PopN( &myBuffer, NULL, 1 ), 0 );
+
+    // Limited by free space and by available elements
+    CU_ASSERT_EQUAL( TypedTestRing_PushN( &myBuffer, elements, 12 ), 8 );
+    CU_ASSERT_EQUAL( TypedTestRing_PopN( &myBuffer, popped, 5 ), 5 );
+    CU_ASSERT_EQUAL( memcmp( popped, elements, 5 * sizeof( popped[ 0 ] ) ), 0 );
+
+    // Push and pop wrapping around end of element storage
+    CU_ASSERT_EQUAL( TypedTestRing_PushN( &myBuffer, &elements[ 8 ], 4 ), 4 );
+    CU_ASSERT_EQUAL( TypedTestRing_PopN( &myBuffer, popped, 12 ), 7 );
+    CU_ASSERT_EQUAL( memcmp( popped, &elements[ 5 ], 7 * sizeof( popped[ 0 ] ) ), 0 );
+    CU_ASSERT_EQUAL( TypedTestRing_GetCount( &myBuffer ), 0 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferRecord_PushPop( void )
+{
+    CircularBuffer_t myBuffer;
+    uint8_t          buffer[ 64 ];
+    uint8_t          data[ 64 ];
+    uint8_t const    *pRecord;
+    size_t           length;
+
+    for ( size_t i = 0; i < sizeof( data ); ++i )
+    {
+        data[ i ] = (uint8_t)i;
+    }
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, buffer, sizeof( buffer ) ) );
+
+    // Test bad input
+    CU_ASSERT_FALSE( ICircularBufferRecord_Push( NULL, data, 1 ) );
+    CU_ASSERT_FALSE( ICircularBufferRecord_Push( &myBuffer, NULL, 1 ) );
+    CU_ASSERT_FALSE( ICircularBufferRecord_Peek( NULL, &pRecord, &length ) );
+    CU_ASSERT_FALSE( ICircularBufferRecord_Peek( &myBuffer, NULL, &length ) );
+    CU_ASSERT_FALSE( ICircularBufferRecord_Peek( &myBuffer, &pRecord, NULL ) );
+    CU_ASSERT_FALSE( ICircularBufferRecord_Pop( NULL ) );
+
+    // Larger than buffer memory never fits, empty buffer has no record
+    CU_ASSERT_FALSE( ICircularBufferRecord_Push( &myBuffer, data, sizeof( buffer ) - 3 ) );
+    CU_ASSERT_FALSE( ICircularBufferRecord_Peek( &myBuffer, &pRecord, &length ) );
+    CU_ASSERT_FALSE( ICircularBufferRecord_Pop( &myBuffer ) );
+
+    // Zero length record takes a header only
+    CU_ASSERT_TRUE( ICircularBufferRecord_Push( &myBuffer, NULL, 0 ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), ICIRCULARBUFFERRECORD_ALIGNMENT );
+    CU_ASSERT_TRUE( ICircularBufferRecord_Peek( &myBuffer, &pRecord, &length ) );
+    CU_ASSERT_EQUAL( length, 0 );
+    CU_ASSERT_TRUE( ICircularBufferRecord_Pop( &myBuffer ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 0 );
+
+    // Records are padded to alignment and read in place
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Clear( &myBuffer ) );
+    for ( uint8_t i = 0; i < 3; ++i )
+    {
+        CU_ASSERT_TRUE( ICircularBufferRecord_Push( &myBuffer, &data[ i ], 11 ) );
+    }
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 3 * ICIRCULARBUFFERRECORD_SIZE( 11 ) );
+    for ( uint8_t i = 0; i < 2; ++i )
+    {
+        CU_ASSERT_TRUE_FATAL( ICircularBufferRecord_Peek( &myBuffer, &pRecord, &length ) );
+        CU_ASSERT_PTR_EQUAL( pRecord, &buffer[ i * 16 + 4 ] );
+        CU_ASSERT_EQUAL( length, 11 );
+        CU_ASSERT_EQUAL( memcmp( pRecord, &data[ i ], 11 ), 0 );
+        CU_ASSERT_TRUE( ICircularBufferRecord_Pop( &myBuffer ) );
+    }
+
+    // 16 bytes left before end of buffer memory, record of 24 is put at the start behind a skip marker
+    CU_ASSERT_TRUE( ICircularBufferRecord_Push( &myBuffer, &data[ 20 ], 20 ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 16 + 16 + 24 );
+    CU_ASSERT_TRUE( ICircularBufferRecord_Pop( &myBuffer ) );
+    CU_ASSERT_TRUE_FATAL( ICircularBufferRecord_Peek( &myBuffer, &pRecord, &length ) );
+    CU_ASSERT_PTR_EQUAL( pRecord, &buffer[ 4 ] );
+    CU_ASSERT_EQUAL( length, 20 );
+    CU_ASSERT_EQUAL( memcmp( pRecord, &data[ 20 ], 20 ), 0 );
+
+    // All or nothing, a record that does not fit leaves the buffer untouched
+    CU_ASSERT_FALSE( ICircularBufferRecord_Push( &myBuffer, data, 21 ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 16 + 24 );
+
+    // Popping the record retires the skip marker before it too
+    CU_ASSERT_TRUE( ICircularBufferRecord_Pop( &myBuffer ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 0 );
+
+    // Empty buffer starts over at the beginning, so a record of the whole buffer fits anywhere
+    CU_ASSERT_TRUE( ICircularBufferRecord_Push( &myBuffer, data, sizeof( buffer ) - 4 ) );
+    CU_ASSERT_TRUE_FATAL( ICircularBufferRecord_Peek( &myBuffer, &pRecord, &length ) );
+    CU_ASSERT_PTR_EQUAL( pRecord, &buffer[ 4 ] );
+    CU_ASSERT_EQUAL( length, sizeof( buffer ) - 4 );
+    CU_ASSERT_EQUAL( memcmp( pRecord, data, length ), 0 );
+    CU_ASSERT_FALSE( ICircularBufferRecord_Push( &myBuffer, NULL, 0 ) );
+
+#if SIZE_MAX > UINT32_MAX
+    // Header holds 32 bits and all ones is the skip marker, refused before buffer memory is touched
+    // Dangerzone, relying on implementation.
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Clear( &myBuffer ) );
+    myBuffer.bufferSize = (size_t)1 << 33;
+    CU_ASSERT_FALSE( ICircularBufferRecord_Push( &myBuffer, data, UINT32_MAX ) );
+    CU_ASSERT_FALSE( ICircularBufferRecord_Push( &myBuffer, data, (size_t)UINT32_MAX + 1 ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 0 );
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferRecord_Batch( void )
+{
+    CircularBuffer_t        myBuffer;
+    uint8_t                 buffer[ 256 ];
+    uint8_t                 data[ 64 ];
+    CircularBufferSegment_t records[ 8 ];
+    uint32_t                pushed = 0;
+    uint32_t                popped = 0;
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, buffer, sizeof( buffer ) ) );
+
+    // Test bad input
+    CU_ASSERT_EQUAL( ICircularBufferRecord_PeekBatch( NULL, records, ARR_SIZE( records ) ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferRecord_PeekBatch( &myBuffer, NULL, ARR_SIZE( records ) ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferRecord_PopBatch( NULL, 1 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferRecord_PeekBatch( &myBuffer, records, ARR_SIZE( records ) ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferRecord_PopBatch( &myBuffer, 1 ), 0 );
+
+    // Stream records of varying length through the buffer, many times around
+    while ( popped < 2000 )
+    {
+        size_t length = RecordFill( pushed, data );
+        while ( ICircularBufferRecord_Push( &myBuffer, data, length ) )
+        {
+            length = RecordFill( ++pushed, data );
+        }
+
+        size_t count = ICircularBufferRecord_PeekBatch( &myBuffer, records, ARR_SIZE( records ) );
+        CU_ASSERT_FATAL( count > 0 );
+        CU_ASSERT_EQUAL( count, ( ( pushed - popped ) < ARR_SIZE( records ) ) ? ( pushed - popped ) : ARR_SIZE( records ) );
+        for ( size_t i = 0; i < count; ++i )
+        {
+            length = RecordFill( popped + (uint32_t)i, data );
+            CU_ASSERT_EQUAL( records[ i ].size, length );
+            CU_ASSERT_EQUAL( memcmp( records[ i ].pData, data, length ), 0 );
+        }
+
+        // Retire a varying number of them, at most as many as there are
+        size_t retire = 1 + ( popped % ARR_SIZE( records ) );
+        size_t expect = ( retire < ( pushed - popped ) ) ? retire : ( pushed - popped );
+        CU_ASSERT_EQUAL( ICircularBufferRecord_PopBatch( &myBuffer, retire ), expect );
+        popped += (uint32_t)expect;
+    }
+
+    CU_ASSERT_EQUAL( ICircularBufferRecord_PopBatch( &myBuffer, SIZE_MAX ), pushed - popped );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 0 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferRecord_Growable( void )
+{
+    CircularBuffer_t       myBuffer;
+    CircularBufferGrowth_t growth = { .minSize = 16, .maxSize = 256, .highWatermark = 75, .lowWatermark = 25 };
+    uint8_t                data[ 8 ] = { 0 };
+    uint8_t const          *pRecord;
+    size_t                 length;
+
+    // A resize would break framing, so records are refused and the buffer is left untouched
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_InitGrowable( &myBuffer, &growth ) );
+    CU_ASSERT_FALSE( ICircularBufferRecord_Push( &myBuffer, data, sizeof( data ) ) );
+    CU_ASSERT_FALSE( ICircularBufferRecord_Push( &myBuffer, NULL, 0 ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetSize( &myBuffer ), 16 );
+    CU_ASSERT_FALSE( ICircularBufferRecord_Peek( &myBuffer, &pRecord, &length ) );
+    CU_ASSERT_TRUE( ICircularBuffer_DeinitGrowable( &myBuffer ) );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferRecord_Crc( void )
+{
+    CircularBuffer_t myBuffer;
+    uint8_t          buffer[ 64 ];
+    uint8_t          data[ 36 ];
+    uint8_t          stored[ 2 * ICIRCULARBUFFERRECORD_SIZE( sizeof( data ) ) ];
+
+    for ( size_t i = 0; i < sizeof( data ); ++i )
+    {
+        data[ i ] = (uint8_t)( i * 7 );
+    }
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, buffer, sizeof( buffer ) ) );
+
+#ifdef ICIRCULARBUFFER_CRC
+    uint32_t crc;
+    uint64_t length;
+
+    // First record as stored, header included
+    CU_ASSERT_TRUE_FATAL( ICircularBufferRecord_Push( &myBuffer, data, sizeof( data ) ) );
+    memcpy( stored, buffer, ICIRCULARBUFFERRECORD_SIZE( sizeof( data ) ) );
+    CU_ASSERT_TRUE( ICircularBufferRecord_Pop( &myBuffer ) );
+
+    // Second does not fit before end of buffer memory, empty buffer skips ahead without starting a new range
+    CU_ASSERT_TRUE_FATAL( ICircularBufferRecord_Push( &myBuffer, data, sizeof( data ) ) );
+    memcpy( stored + ICIRCULARBUFFERRECORD_SIZE( sizeof( data ) ), buffer, ICIRCULARBUFFERRECORD_SIZE( sizeof( data ) ) );
+
+    // Dangerzone, relying on implementation.
+    CU_ASSERT_EQUAL( myBuffer.read, sizeof( buffer ) );
+    CU_ASSERT_EQUAL( myBuffer.write, sizeof( buffer ) + ICIRCULARBUFFERRECORD_SIZE( sizeof( data ) ) );
+
+    CU_ASSERT_TRUE( ICircularBuffer_CrcGet( &myBuffer, &crc, &length ) );
+    CU_ASSERT_EQUAL( length, sizeof( stored ) );
+    CU_ASSERT_EQUAL( crc, CrcReference( stored, sizeof( stored ) ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), ICIRCULARBUFFERRECORD_SIZE( sizeof( data ) ) );
+#else
+    // Nothing to checksum unless built in
+    CU_ASSERT_TRUE( ICircularBufferRecord_Push( &myBuffer, data, sizeof( data ) ) );
+    (void)stored;
+#endif
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_InitGrowable( void )
+{
+    CircularBuffer_t       myBuffer;
+    uint8_t                data[ 16 ];
+    CircularBufferGrowth_t growth = { .minSize = 16, .maxSize = 256, .highWatermark = 100, .lowWatermark = 25 };
+    CircularBufferGrowth_t bad;
+
+    // Test bad input
+    CU_ASSERT_FALSE( ICircularBuffer_InitGrowable( NULL, &growth ) );
+    CU_ASSERT_FALSE( ICircularBuffer_InitGrowable( &myBuffer, NULL ) );
+    bad = growth; bad.minSize = 1;
+    CU_ASSERT_FALSE( ICircularBuffer_InitGrowable( &myBuffer, &bad ) );
+    bad = growth; bad.minSize = 24;
+    CU_ASSERT_FALSE( ICircularBuffer_InitGrowable( &myBuffer, &bad ) );
+    bad = growth; bad.maxSize = 8;
+    CU_ASSERT_FALSE( ICircularBuffer_InitGrowable( &myBuffer, &bad ) );
+    bad = growth; bad.maxSize = 100;
+    CU_ASSERT_FALSE( ICircularBuffer_InitGrowable( &myBuffer, &bad ) );
+    bad = growth; bad.highWatermark = 0;
+    CU_ASSERT_FALSE( ICircularBuffer_InitGrowable( &myBuffer, &bad ) );
+    bad = growth; bad.highWatermark = 101;
+    CU_ASSERT_FALSE( ICircularBuffer_InitGrowable( &myBuffer, &bad ) );
+    bad = growth; bad.lowWatermark = 50;
+    CU_ASSERT_FALSE( ICircularBuffer_InitGrowable( &myBuffer, &bad ) );
+    bad = growth; bad.allocator.pAllocate = GrowableAllocate;
+    CU_ASSERT_FALSE( ICircularBuffer_InitGrowable( &myBuffer, &bad ) );
+    CU_ASSERT_FALSE( ICircularBuffer_DeinitGrowable( NULL ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetSize( NULL ), 0 );
+
+    // Fixed size buffer is not growable
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetSize( &myBuffer ), sizeof( data ) );
+    CU_ASSERT_FALSE( ICircularBuffer_DeinitGrowable( &myBuffer ) );
+
+    // Starts at minimum size, gone after deinit
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_InitGrowable( &myBuffer, &growth ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetSize( &myBuffer ), 16 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 0 );
+    CU_ASSERT_TRUE( ICircularBuffer_DeinitGrowable( &myBuffer ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetSize( &myBuffer ), 0 );
+    CU_ASSERT_FALSE( ICircularBuffer_DeinitGrowable( &myBuffer ) );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_GrowShrink( void )
+{
+    CircularBuffer_t       myBuffer;
+    CircularBufferGrowth_t growth = { .minSize = 16, .maxSize = 256, .highWatermark = 75, .lowWatermark = 25 };
+    uint8_t                dummyData[ 300 ];
+    uint8_t                dummyBuffer[ 300 ];
+    uint8_t                *pReserved;
+    uint8_t                next     = 0;
+    uint8_t                expected = 0;
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_InitGrowable( &myBuffer, &growth ) );
+
+    // Wrap data around end of 16 byte memory, then grow: data comes out in order from the new memory
+    for ( size_t i = 0; i < sizeof( dummyData ); ++i )
+    {
+        dummyData[ i ] = next++;
+    }
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, dummyData, 10 ), 10 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, dummyBuffer, 7 ), 7 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetSize( &myBuffer ), 16 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, &dummyData[ 10 ], 9 ), 9 );   // 12 bytes, wraps
+    CU_ASSERT_EQUAL( ICircularBuffer_GetSize( &myBuffer ), 16 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, &dummyData[ 19 ], 1 ), 1 );   // 13 of 16 is above 75 %
+    CU_ASSERT_EQUAL( ICircularBuffer_GetSize( &myBuffer ), 32 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, dummyBuffer, 5 ), 5 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, &dummyData[ 7 ], 5 ), 0 );
+
+    // Big push grows several steps at once, up to maximum size and no further
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, &dummyData[ 20 ], 150 ), 150 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetSize( &myBuffer ), 256 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, &dummyData[ 170 ], 130 ), 256 - 158 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetSize( &myBuffer ), 256 );
+
+    // Popping shrinks, by more than half at once when the buffer drains
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, dummyBuffer, 200 ), 200 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, &dummyData[ 12 ], 200 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 56 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetSize( &myBuffer ), 128 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Release( &myBuffer, 50 ), 50 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetSize( &myBuffer ), 16 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, dummyBuffer, 16 ), 6 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, &dummyData[ 262 ], 6 ), 0 );
+
+    // Reserve grows too, and Clear shrinks back to minimum size
+    CU_ASSERT_EQUAL( ICircularBuffer_Reserve( &myBuffer, &pReserved, 100 ), 100 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetSize( &myBuffer ), 256 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Commit( &myBuffer, 100 ), 100 );
+    CU_ASSERT_TRUE( ICircularBuffer_Clear( &myBuffer ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetSize( &myBuffer ), 16 );
+
+    // Stream of pushes and pops of varying size never loses or reorders a byte, and stays within the sizes
+    expected = next = 0;
+    for ( uint32_t i = 0; i < 5000; ++i )
+    {
+        size_t pushCount = ( i * 37 ) % 97;
+        size_t popCount  = ( i * 53 ) % 89;
+        for ( size_t n = 0; n < pushCount; ++n )
+        {
+            dummyData[ n ] = (uint8_t)( next + n );
+        }
+        next += (uint8_t)ICircularBuffer_Push( &myBuffer, dummyData, pushCount );
+
+        size_t popped = ICircularBuffer_Pop( &myBuffer, dummyBuffer, popCount );
+        for ( size_t n = 0; n < popped; ++n )
+        {
+            CU_ASSERT_EQUAL_FATAL( dummyBuffer[ n ], expected );
+            ++expected;
+        }
+        CU_ASSERT_FATAL( ICircularBuffer_GetSize( &myBuffer ) >= growth.minSize );
+        CU_ASSERT_FATAL( ICircularBuffer_GetSize( &myBuffer ) <= growth.maxSize );
+    }
+    CU_ASSERT_EQUAL( (uint8_t)( next - expected ), (uint8_t)ICircularBuffer_GetCount( &myBuffer ) );
+
+    CU_ASSERT_TRUE( ICircularBuffer_DeinitGrowable( &myBuffer ) );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_GrowableAllocator( void )
+{
+    CircularBuffer_t        myBuffer;
+    GrowableTestAllocator_t allocator = { 0 };
+    CircularBufferGrowth_t  growth    = {
+        .minSize       = 16,
+        .maxSize       = 64,
+        .highWatermark = 100,
+        .lowWatermark  = 0,
+        .allocator     = { .pAllocate = GrowableAllocate, .pFree = GrowableFree, .pContext = &allocator },
     };
+    uint8_t                 dummyData[ 64 ] = { 0 };
+
+    // Out of memory at init
+    allocator.fail = true;
+    CU_ASSERT_FALSE( ICircularBuffer_InitGrowable( &myBuffer, &growth ) );
+    allocator.fail = false;
+
+    // All memory comes from the allocator
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_InitGrowable( &myBuffer, &growth ) );
+    CU_ASSERT_EQUAL( allocator.allocations, 1 );
+    CU_ASSERT_EQUAL( allocator.bytesLive, 16 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, dummyData, 20 ), 20 );
+    CU_ASSERT_EQUAL( allocator.allocations, 2 );
+    CU_ASSERT_EQUAL( allocator.frees, 1 );
+    CU_ASSERT_EQUAL( allocator.bytesLive, 32 );
+
+    // Failing to grow is no error, push is short as for a fixed size buffer
+    allocator.fail = true;
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, dummyData, 20 ), 12 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetSize( &myBuffer ), 32 );
+    allocator.fail = false;
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, dummyData, 20 ), 20 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetSize( &myBuffer ), 64 );
+
+    // Low watermark 0 never shrinks
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, dummyData, 64 ), 52 );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetSize( &myBuffer ), 64 );
+
+    CU_ASSERT_TRUE( ICircularBuffer_DeinitGrowable( &myBuffer ) );
+    CU_ASSERT_EQUAL( allocator.allocations, allocator.frees );
+    CU_ASSERT_EQUAL( allocator.bytesLive, 0 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBuffer_GrowableNotify( void )
+{
+    CircularBuffer_t       myBuffer;
+    CircularBufferGrowth_t growth = { .minSize = 16, .maxSize = 256, .highWatermark = 75, .lowWatermark = 25 };
+    uint8_t                dummyData[ 100 ] = { 0 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBuffer_InitGrowable( &myBuffer, &growth ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, dummyData, sizeof( dummyData ) ), sizeof( dummyData ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetSize( &myBuffer ), 256 );
+
+#ifdef ICIRCULARBUFFER_NOTIFY
+    int spaceFd = ICircularBuffer_OpenSpaceFd( &myBuffer, 200 );
+    CU_ASSERT_FATAL( spaceFd >= 0 );
+    CU_ASSERT_FALSE( NotifyReadable( spaceFd ) );
+
+    // Shrinking below the threshold lowers it, so the drained buffer still signals space
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, dummyData, sizeof( dummyData ) ), sizeof( dummyData ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetSize( &myBuffer ), 16 );
+    CU_ASSERT_TRUE( NotifyReadable( spaceFd ) );
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, dummyData, 1 ), 1 );
+    CU_ASSERT_FALSE( NotifyReadable( spaceFd ) );
+    CU_ASSERT_TRUE( ICircularBuffer_CloseNotify( &myBuffer ) );
+#else
+    // Nothing opened unless built in
+    CU_ASSERT_EQUAL( ICircularBuffer_OpenSpaceFd( &myBuffer, 200 ), -1 );
+#endif
+
+    CU_ASSERT_TRUE( ICircularBuffer_DeinitGrowable( &myBuffer ) );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferJournal_OpenClose( void )
+{
+    CircularBufferJournal_t myJournal;
+    CircularBufferJournal_t otherJournal;
+    char                    path[ 64 ];
+    uint8_t                 data[ 100 ];
+    uint8_t                 check[ 100 ];
+
+    snprintf( path, sizeof( path ), "/tmp/CircularBufferTest%d.journal", (int)getpid() );
+    unlink( path );
+
+    for ( size_t i = 0; i < sizeof( data ); ++i )
+    {
+        data[ i ] = (uint8_t)( i * 7 );
+    }
+
+    // Bad arguments
+    CU_ASSERT_FALSE( ICircularBufferJournal_Open( NULL, path, 256, NULL ) );
+    CU_ASSERT_FALSE( ICircularBufferJournal_Open( &myJournal, NULL, 256, NULL ) );
+    CU_ASSERT_FALSE( ICircularBufferJournal_Open( &myJournal, path, 100, NULL ) );
+    CU_ASSERT_FALSE( ICircularBufferJournal_Close( NULL ) );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Push( NULL, data, 1 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Pop( NULL, check, 1 ), 0 );
+
+    // Create, leave data in it and close. Only one open at a time, even within a process
+    CU_ASSERT_TRUE_FATAL( ICircularBufferJournal_Open( &myJournal, path, 256, NULL ) );
+    CU_ASSERT_FALSE( ICircularBufferJournal_Open( &otherJournal, path, 256, NULL ) );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_GetCount( &myJournal ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Push( &myJournal, data, sizeof( data ) ), sizeof( data ) );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Pop( &myJournal, check, 40 ), 40 );
+    CU_ASSERT_EQUAL( memcmp( check, data, 40 ), 0 );
+    CU_ASSERT_TRUE( ICircularBufferJournal_Close( &myJournal ) );
+    CU_ASSERT_FALSE( ICircularBufferJournal_Close( &myJournal ) );
+
+    // Reopen picks up where it left off, also across the wrap
+    CU_ASSERT_TRUE_FATAL( ICircularBufferJournal_Open( &myJournal, path, 256, NULL ) );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_GetCount( &myJournal ), 60 );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Push( &myJournal, data, sizeof( data ) ), sizeof( data ) );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Push( &myJournal, data, sizeof( data ) ), 96 );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_GetCount( &myJournal ), 256 );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Pop( &myJournal, check, 60 ), 60 );
+    CU_ASSERT_EQUAL( memcmp( check, data + 40, 60 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Pop( &myJournal, check, 100 ), 100 );
+    CU_ASSERT_EQUAL( memcmp( check, data, 100 ), 0 );
+    CU_ASSERT_TRUE( ICircularBufferJournal_Close( &myJournal ) );
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferJournal_Open( &myJournal, path, 256, NULL ) );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_GetCount( &myJournal ), 96 );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Pop( &myJournal, check, sizeof( check ) ), 96 );
+    CU_ASSERT_EQUAL( memcmp( check, data, 96 ), 0 );
+    CU_ASSERT_TRUE( ICircularBufferJournal_Close( &myJournal ) );
+
+    // Size has to match the file
+    CU_ASSERT_FALSE( ICircularBufferJournal_Open( &myJournal, path, 512, NULL ) );
+
+    // Damaged header is refused
+    CU_ASSERT_TRUE_FATAL( ICircularBufferJournal_Open( &myJournal, path, 256, NULL ) );
+    myJournal.pHeader->version = ICIRCULARBUFFERJOURNAL_VERSION + 1;  // Dangerzone, relying on implementation.
+    CU_ASSERT_TRUE( ICircularBufferJournal_Close( &myJournal ) );
+    CU_ASSERT_FALSE( ICircularBufferJournal_Open( &myJournal, path, 256, NULL ) );
+    unlink( path );
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferJournal_Open( &myJournal, path, 256, NULL ) );
+    myJournal.pHeader->write = myJournal.pHeader->read + 257;         // Dangerzone, relying on implementation.
+    CU_ASSERT_TRUE( ICircularBufferJournal_Close( &myJournal ) );
+    CU_ASSERT_FALSE( ICircularBufferJournal_Open( &myJournal, path, 256, NULL ) );
+    unlink( path );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferJournal_Sync( void )
+{
+    CircularBufferJournal_t     myJournal;
+    CircularBufferJournalSync_t mySync;
+    char                        path[ 64 ];
+    uint8_t                     data[ 10 ] = { 0 };
+
+    snprintf( path, sizeof( path ), "/tmp/CircularBufferTest%d.journal", (int)getpid() );
+    unlink( path );
+
+    mySync.mode      = (CircularBufferJournalSyncMode_t)( ICIRCULARBUFFERJOURNAL_SYNC_INTERVAL + 1 );
+    mySync.threshold = 0;
+    CU_ASSERT_FALSE( ICircularBufferJournal_Open( &myJournal, path, 256, &mySync ) );
+
+    // Only when asked to
+    CU_ASSERT_TRUE_FATAL( ICircularBufferJournal_Open( &myJournal, path, 256, NULL ) );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Push( &myJournal, data, sizeof( data ) ), sizeof( data ) );
+    CU_ASSERT_EQUAL( myJournal.syncedWrite, 0 );                      // Dangerzone, relying on implementation.
+    CU_ASSERT_TRUE( ICircularBufferJournal_Sync( &myJournal ) );
+    CU_ASSERT_EQUAL( myJournal.syncedWrite, 10 );                     // Dangerzone, relying on implementation.
+    CU_ASSERT_TRUE( ICircularBufferJournal_Close( &myJournal ) );
+
+    // Every push and pop
+    mySync.mode = ICIRCULARBUFFERJOURNAL_SYNC_COMMIT;
+    CU_ASSERT_TRUE_FATAL( ICircularBufferJournal_Open( &myJournal, path, 256, &mySync ) );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Push( &myJournal, data, sizeof( data ) ), sizeof( data ) );
+    CU_ASSERT_EQUAL( myJournal.syncedWrite, 20 );                     // Dangerzone, relying on implementation.
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Pop( &myJournal, data, 5 ), 5 );
+    CU_ASSERT_EQUAL( myJournal.syncedRead, 5 );                       // Dangerzone, relying on implementation.
+    CU_ASSERT_TRUE( ICircularBufferJournal_Close( &myJournal ) );
+
+    // Every threshold bytes moved, pushed and popped together
+    mySync.mode      = ICIRCULARBUFFERJOURNAL_SYNC_BYTES;
+    mySync.threshold = 16;
+    CU_ASSERT_TRUE_FATAL( ICircularBufferJournal_Open( &myJournal, path, 256, &mySync ) );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Push( &myJournal, data, sizeof( data ) ), sizeof( data ) );
+    CU_ASSERT_EQUAL( myJournal.syncedWrite, 20 );                     // Dangerzone, relying on implementation.
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Pop( &myJournal, data, 5 ), 5 );
+    CU_ASSERT_EQUAL( myJournal.syncedWrite, 20 );                     // Dangerzone, relying on implementation.
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Pop( &myJournal, data, 1 ), 1 );
+    CU_ASSERT_EQUAL( myJournal.syncedWrite, 30 );                     // Dangerzone, relying on implementation.
+    CU_ASSERT_EQUAL( myJournal.syncedRead, 11 );                      // Dangerzone, relying on implementation.
+    CU_ASSERT_TRUE( ICircularBufferJournal_Close( &myJournal ) );
+
+    // Every interval, never within a long one
+    mySync.mode      = ICIRCULARBUFFERJOURNAL_SYNC_INTERVAL;
+    mySync.threshold = UINT64_MAX;
+    CU_ASSERT_TRUE_FATAL( ICircularBufferJournal_Open( &myJournal, path, 256, &mySync ) );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Push( &myJournal, data, sizeof( data ) ), sizeof( data ) );
+    CU_ASSERT_EQUAL( myJournal.syncedWrite, 30 );                     // Dangerzone, relying on implementation.
+    CU_ASSERT_TRUE( ICircularBufferJournal_Close( &myJournal ) );
+
+    mySync.threshold = 0;
+    CU_ASSERT_TRUE_FATAL( ICircularBufferJournal_Open( &myJournal, path, 256, &mySync ) );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Push( &myJournal, data, sizeof( data ) ), sizeof( data ) );
+    CU_ASSERT_EQUAL( myJournal.syncedWrite, 50 );                     // Dangerzone, relying on implementation.
+    CU_ASSERT_TRUE( ICircularBufferJournal_Close( &myJournal ) );
+
+    unlink( path );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferJournal_SyncFailed( void )
+{
+    CircularBufferJournal_t     myJournal;
+    size_t                      pageSize = (size_t)sysconf( _SC_PAGESIZE );
+    CircularBufferJournalSync_t mySync   = { ICIRCULARBUFFERJOURNAL_SYNC_BYTES, 2 * pageSize };
+    char                        path[ 64 ];
+    uint8_t                     *pData   = calloc( 1, pageSize );
+
+    snprintf( path, sizeof( path ), "/tmp/CircularBufferTest%d.journal", (int)getpid() );
+    unlink( path );
+    CU_ASSERT_PTR_NOT_NULL_FATAL( pData );
+
+    // Bad arguments
+    CU_ASSERT_FALSE( ICircularBufferJournal_SyncFailed( NULL ) );
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferJournal_Open( &myJournal, path, 4 * pageSize, &mySync ) );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Push( &myJournal, pData, pageSize ), pageSize );
+    CU_ASSERT_FALSE( ICircularBufferJournal_SyncFailed( &myJournal ) );
+
+    // Unmapping the first data page makes msync of it fail, the push is kept and the failure is reported
+    CU_ASSERT_EQUAL_FATAL( munmap( myJournal.pBuffer, pageSize ), 0 ); // Dangerzone, relying on implementation.
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Push( &myJournal, pData, pageSize ), pageSize );
+    CU_ASSERT_TRUE( ICircularBufferJournal_SyncFailed( &myJournal ) );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_GetCount( &myJournal ), 2 * pageSize );
+
+    // Sticky, even once the page is back and syncs succeed again
+    int fd = open( path, O_RDWR );
+    CU_ASSERT_FATAL( fd >= 0 );
+    CU_ASSERT_FATAL( mmap( myJournal.pBuffer, pageSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd,
+                           (off_t)myJournal.pHeader->dataOffset ) == myJournal.pBuffer );
+    close( fd );
+    CU_ASSERT_TRUE( ICircularBufferJournal_Sync( &myJournal ) );
+    CU_ASSERT_TRUE( ICircularBufferJournal_SyncFailed( &myJournal ) );
+    CU_ASSERT_TRUE( ICircularBufferJournal_Close( &myJournal ) );
+
+    // Reopening starts over
+    CU_ASSERT_TRUE_FATAL( ICircularBufferJournal_Open( &myJournal, path, 4 * pageSize, &mySync ) );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_GetCount( &myJournal ), 2 * pageSize );
+    CU_ASSERT_FALSE( ICircularBufferJournal_SyncFailed( &myJournal ) );
+    CU_ASSERT_TRUE( ICircularBufferJournal_Close( &myJournal ) );
+
+    free( pData );
+    unlink( path );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferJournal_CommitOrder( void )
+{
+    CircularBufferJournal_t     myJournal;
+    size_t                      pageSize = (size_t)sysconf( _SC_PAGESIZE );
+    CircularBufferJournalSync_t mySync   = { ICIRCULARBUFFERJOURNAL_SYNC_COMMIT, 0 };
+    char                        path[ 64 ];
+    uint8_t                     *pData   = calloc( 1, pageSize );
+
+    snprintf( path, sizeof( path ), "/tmp/CircularBufferTest%d.journal", (int)getpid() );
+    unlink( path );
+    CU_ASSERT_PTR_NOT_NULL_FATAL( pData );
+
+    // Leave the first data page unsynced, then make msync of it fail
+    CU_ASSERT_TRUE_FATAL( ICircularBufferJournal_Open( &myJournal, path, 4 * pageSize, NULL ) );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Push( &myJournal, pData, pageSize ), pageSize );
+    CU_ASSERT_EQUAL_FATAL( munmap( myJournal.pBuffer, pageSize ), 0 ); // Dangerzone, relying on implementation.
+    myJournal.sync = mySync;                                            // Dangerzone, relying on implementation.
+
+    // Data is written out before the position moves, so a push the header could not safely cover is not made
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Push( &myJournal, pData, pageSize ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_GetCount( &myJournal ), pageSize );
+    CU_ASSERT_TRUE( ICircularBufferJournal_SyncFailed( &myJournal ) );
+
+    // Once data can be written out again the push is made, data and header synced
+    int fd = open( path, O_RDWR );
+    CU_ASSERT_FATAL( fd >= 0 );
+    CU_ASSERT_FATAL( mmap( myJournal.pBuffer, pageSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd,
+                           (off_t)myJournal.pHeader->dataOffset ) == myJournal.pBuffer );
+    close( fd );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Push( &myJournal, pData, pageSize ), pageSize );
+    CU_ASSERT_EQUAL( ICircularBufferJournal_GetCount( &myJournal ), 2 * pageSize );
+    CU_ASSERT_EQUAL( myJournal.syncedWrite, 2 * pageSize );             // Dangerzone, relying on implementation.
+    CU_ASSERT_EQUAL( myJournal.syncedRead, 0 );                         // Dangerzone, relying on implementation.
+    CU_ASSERT_TRUE( ICircularBufferJournal_Close( &myJournal ) );
+
+    free( pData );
+    unlink( path );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferJournal_Crash( void )
+{
+    CircularBufferJournal_t     myJournal;
+    CircularBufferJournalSync_t mySync = { ICIRCULARBUFFERJOURNAL_SYNC_BYTES, JOURNAL_CRASH_SIZE / 4 };
+    char                        path[ 64 ];
+    int                         ready[ 2 ];
+    char                        token;
+    uint32_t                    value;
+    uint32_t                    expected;
+    size_t                      errors = 0;
+    int                         status = -1;
+
+    snprintf( path, sizeof( path ), "/tmp/CircularBufferTest%d.journal", (int)getpid() );
+    unlink( path );
+    CU_ASSERT_FATAL( pipe( ready ) == 0 );
+
+    pid_t child = fork();
+    CU_ASSERT_FATAL( child >= 0 );
+    if ( child == 0 )
+    {
+        // Child streams a counter until killed, dropping the oldest values to make room
+        close( ready[ 0 ] );
+        if ( !ICircularBufferJournal_Open( &myJournal, path, JOURNAL_CRASH_SIZE, &mySync ) )
+        {
+            _exit( 1 );
+        }
+
+        for ( uint32_t i = 0; ; ++i )
+        {
+            while ( ICircularBufferJournal_Push( &myJournal, (uint8_t*)&i, sizeof( i ) ) == 0 )
+            {
+                ICircularBufferJournal_Pop( &myJournal, (uint8_t*)&value, sizeof( value ) );
+            }
+
+            if ( i == JOURNAL_CRASH_VALUES && write( ready[ 1 ], "x", 1 ) != 1 )
+            {
+                _exit( 1 );
+            }
+        }
+    }
+
+    // Kill it somewhere mid-stream, well after it has wrapped
+    close( ready[ 1 ] );
+    CU_ASSERT_EQUAL( read( ready[ 0 ], &token, 1 ), 1 );
+    close( ready[ 0 ] );
+    usleep( 1000 );
+    kill( child, SIGKILL );
+    waitpid( child, &status, 0 );
+    CU_ASSERT_TRUE( WIFSIGNALED( status ) );
+
+    // Whatever was queued at the kill is a run of consecutive values, without torn or stale ones
+    CU_ASSERT_TRUE_FATAL( ICircularBufferJournal_Open( &myJournal, path, JOURNAL_CRASH_SIZE, &mySync ) );
+    size_t count = ICircularBufferJournal_GetCount( &myJournal );
+    CU_ASSERT_EQUAL( count % sizeof( value ), 0 );
+    CU_ASSERT_FATAL( count > 0 );
+
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Pop( &myJournal, (uint8_t*)&expected, sizeof( expected ) ), sizeof( expected ) );
+    while ( ICircularBufferJournal_Pop( &myJournal, (uint8_t*)&value, sizeof( value ) ) == sizeof( value ) )
+    {
+        if ( value != ++expected )
+        {
+            ++errors;
+        }
+    }
+    CU_ASSERT_EQUAL( errors, 0 );
+    CU_ASSERT( expected >= JOURNAL_CRASH_VALUES );
+
+    // Recovered journal keeps working
+    value = 0xC0FFEE;
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Push( &myJournal, (uint8_t*)&value, sizeof( value ) ), sizeof( value ) );
+    CU_ASSERT_TRUE( ICircularBufferJournal_Close( &myJournal ) );
+    CU_ASSERT_TRUE_FATAL( ICircularBufferJournal_Open( &myJournal, path, JOURNAL_CRASH_SIZE, &mySync ) );
+    value = 0;
+    CU_ASSERT_EQUAL( ICircularBufferJournal_Pop( &myJournal, (uint8_t*)&value, sizeof( value ) ), sizeof( value ) );
+    CU_ASSERT_EQUAL( value, 0xC0FFEE );
+    CU_ASSERT_TRUE( ICircularBufferJournal_Close( &myJournal ) );
+
+    unlink( path );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferSharded_Init( void )
+{
+    CircularBufferSharded_t mySharded;
+    CircularBufferShard_t   myShards[ 4 ];
+    uint8_t                 data[ 4 * 64 ];
+    uint8_t                 element[ 8 ] = { 0 };
+    size_t                  shard;
+
+    // Test bad input
+    CU_ASSERT_FALSE( ICircularBufferSharded_Init( NULL, myShards, 4, data, sizeof( data ), 8, 2,
+                                                  ICIRCULARBUFFERSHARDED_PICK_ROUND_ROBIN ) );
+    CU_ASSERT_FALSE( ICircularBufferSharded_Init( &mySharded, NULL, 4, data, sizeof( data ), 8, 2,
+                                                  ICIRCULARBUFFERSHARDED_PICK_ROUND_ROBIN ) );
+    CU_ASSERT_FALSE( ICircularBufferSharded_Init( &mySharded, myShards, 4, NULL, sizeof( data ), 8, 2,
+                                                  ICIRCULARBUFFERSHARDED_PICK_ROUND_ROBIN ) );
+    CU_ASSERT_FALSE( ICircularBufferSharded_Init( &mySharded, myShards, 0, data, sizeof( data ), 8, 1,
+                                                  ICIRCULARBUFFERSHARDED_PICK_ROUND_ROBIN ) );
+    CU_ASSERT_FALSE( ICircularBufferSharded_Init( &mySharded, myShards, 4, data, sizeof( data ), 8, 0,
+                                                  ICIRCULARBUFFERSHARDED_PICK_ROUND_ROBIN ) );
+    CU_ASSERT_FALSE( ICircularBufferSharded_Init( &mySharded, myShards, 4, data, sizeof( data ), 8, 5,
+                                                  ICIRCULARBUFFERSHARDED_PICK_ROUND_ROBIN ) );  // More consumers than shards
+    CU_ASSERT_FALSE( ICircularBufferSharded_Init( &mySharded, myShards, 4, data, sizeof( data ), 0, 2,
+                                                  ICIRCULARBUFFERSHARDED_PICK_ROUND_ROBIN ) );
+    CU_ASSERT_FALSE( ICircularBufferSharded_Init( &mySharded, myShards, 4, data, sizeof( data ), 128, 2,
+                                                  ICIRCULARBUFFERSHARDED_PICK_ROUND_ROBIN ) );  // Element bigger than shard
+    CU_ASSERT_FALSE( ICircularBufferSharded_Init( &mySharded, myShards, 3, data, sizeof( data ), 8, 2,
+                                                  ICIRCULARBUFFERSHARDED_PICK_ROUND_ROBIN ) );  // Uneven split
+    CU_ASSERT_FALSE( ICircularBufferSharded_Init( &mySharded, myShards, 4, data, 4 * 48, 8, 2,
+                                                  ICIRCULARBUFFERSHARDED_PICK_ROUND_ROBIN ) );  // Shard not power of 2
+    CU_ASSERT_FALSE( ICircularBufferSharded_Attach( NULL, &shard ) );
+    CU_ASSERT_FALSE( ICircularBufferSharded_Detach( NULL, 0 ) );
+
+    // Round robin hands out every shard once, then none
+    CU_ASSERT_TRUE_FATAL( ICircularBufferSharded_Init( &mySharded, myShards, 4, data, sizeof( data ), 8, 2,
+                                                       ICIRCULARBUFFERSHARDED_PICK_ROUND_ROBIN ) );
+    for ( size_t i = 0; i < 4; ++i )
+    {
+        CU_ASSERT_TRUE( ICircularBufferSharded_Attach( &mySharded, &shard ) );
+        CU_ASSERT_EQUAL( shard, i );
+    }
+    CU_ASSERT_FALSE( ICircularBufferSharded_Attach( &mySharded, &shard ) );
+    CU_ASSERT_FALSE( ICircularBufferSharded_Detach( &mySharded, 4 ) );
+    CU_ASSERT_TRUE( ICircularBufferSharded_Detach( &mySharded, 1 ) );
+    CU_ASSERT_FALSE( ICircularBufferSharded_Detach( &mySharded, 1 ) );
+    CU_ASSERT_TRUE( ICircularBufferSharded_Attach( &mySharded, &shard ) );
+    CU_ASSERT_EQUAL( shard, 1 );
+
+    // Least loaded takes the free shard with the least data left in it
+    CU_ASSERT_TRUE_FATAL( ICircularBufferSharded_Init( &mySharded, myShards, 4, data, sizeof( data ), 8, 2,
+                                                       ICIRCULARBUFFERSHARDED_PICK_LEAST_LOADED ) );
+    for ( size_t i = 0; i < 4; ++i )
+    {
+        CU_ASSERT_TRUE( ICircularBufferSharded_Attach( &mySharded, &shard ) );
+        for ( size_t j = 0; j < ( 4 - i ); ++j )
+        {
+            CU_ASSERT_EQUAL( ICircularBufferSharded_Push( &mySharded, shard, element, sizeof( element ) ), 8 );
+        }
+    }
+    CU_ASSERT_TRUE( ICircularBufferSharded_Detach( &mySharded, 0 ) );
+    CU_ASSERT_TRUE( ICircularBufferSharded_Detach( &mySharded, 2 ) );
+    CU_ASSERT_TRUE( ICircularBufferSharded_Detach( &mySharded, 3 ) );
+    CU_ASSERT_TRUE( ICircularBufferSharded_Attach( &mySharded, &shard ) );
+    CU_ASSERT_EQUAL( shard, 3 );
+    CU_ASSERT_TRUE( ICircularBufferSharded_Attach( &mySharded, &shard ) );
+    CU_ASSERT_EQUAL( shard, 2 );
+    CU_ASSERT_EQUAL( ICircularBufferSharded_GetCount( &mySharded ), ( 4 + 3 + 2 + 1 ) * 8 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferSharded_PushPop( void )
+{
+    CircularBufferSharded_t mySharded;
+    CircularBufferShard_t   myShards[ 4 ];
+    uint8_t                 data[ 4 * 64 ];
+    uint8_t                 elements[ 64 ];
+    uint8_t                 popped[ 64 ];
+    size_t                  shard;
+
+    for ( size_t i = 0; i < sizeof( elements ); ++i )
+    {
+        elements[ i ] = (uint8_t)i;
+    }
+
+    // Two consumers, shards 0 and 2 are home to consumer 0, shards 1 and 3 to consumer 1
+    CU_ASSERT_TRUE_FATAL( ICircularBufferSharded_Init( &mySharded, myShards, 4, data, sizeof( data ), 4, 2,
+                                                       ICIRCULARBUFFERSHARDED_PICK_ROUND_ROBIN ) );
+    CU_ASSERT_EQUAL( ICircularBufferSharded_Push( NULL, 0, elements, 4 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSharded_Push( &mySharded, 4, elements, 4 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSharded_Pop( &mySharded, 2, popped, sizeof( popped ), NULL ), 0 );
+
+    // Whole elements only
+    CU_ASSERT_EQUAL( ICircularBufferSharded_Push( &mySharded, 1, elements, 10 ), 8 );
+    CU_ASSERT_EQUAL( ICircularBufferSharded_Push( &mySharded, 2, elements, 4 ), 4 );
+    CU_ASSERT_EQUAL( ICircularBufferSharded_Push( &mySharded, 3, elements, 64 ), 64 );
+    CU_ASSERT_EQUAL( ICircularBufferSharded_Push( &mySharded, 3, elements, 4 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSharded_Pop( &mySharded, 0, popped, 3, NULL ), 0 );
+
+    // Home shard first
+    CU_ASSERT_EQUAL( ICircularBufferSharded_Pop( &mySharded, 0, popped, sizeof( popped ), &shard ), 4 );
+    CU_ASSERT_EQUAL( shard, 2 );
+
+    // Then steal, from the fullest other shard
+    CU_ASSERT_EQUAL( ICircularBufferSharded_Pop( &mySharded, 0, popped, 10, &shard ), 8 );
+    CU_ASSERT_EQUAL( shard, 3 );
+    CU_ASSERT_EQUAL( memcmp( popped, elements, 8 ), 0 );
+
+    // Home consumer takes the fullest of its own and gets the rest in order
+    CU_ASSERT_EQUAL( ICircularBufferSharded_Pop( &mySharded, 1, popped, sizeof( popped ), &shard ), 56 );
+    CU_ASSERT_EQUAL( shard, 3 );
+    CU_ASSERT_EQUAL( memcmp( popped, elements + 8, 56 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBufferSharded_Pop( &mySharded, 1, popped, sizeof( popped ), &shard ), 8 );
+    CU_ASSERT_EQUAL( shard, 1 );
+    CU_ASSERT_EQUAL( ICircularBufferSharded_GetCount( &mySharded ), 0 );
+
+    // A shard some other consumer is popping from is left alone
+    CU_ASSERT_EQUAL( ICircularBufferSharded_Push( &mySharded, 0, elements, 8 ), 8 );
+    atomic_store( &myShards[ 0 ].locked, true );                      // Dangerzone, relying on implementation.
+    CU_ASSERT_EQUAL( ICircularBufferSharded_Pop( &mySharded, 0, popped, sizeof( popped ), NULL ), 0 );
+    atomic_store( &myShards[ 0 ].locked, false );                     // Dangerzone, relying on implementation.
+    CU_ASSERT_EQUAL( ICircularBufferSharded_Pop( &mySharded, 1, popped, sizeof( popped ), &shard ), 8 );
+    CU_ASSERT_EQUAL( shard, 0 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferSharded_Stress( void )
+{
+    CircularBufferSharded_t mySharded;
+    CircularBufferShard_t   myShards[ SHARDED_STRESS_PRODUCERS ];
+    static uint8_t          data[ SHARDED_STRESS_PRODUCERS * 256 ];
+    atomic_size_t           consumed = 0;
+    pthread_t               producers[ SHARDED_STRESS_PRODUCERS ];
+    pthread_t               consumers[ SHARDED_STRESS_CONSUMERS ];
+    ShardedStressArg_t      producerArgs[ SHARDED_STRESS_PRODUCERS ];
+    ShardedStressArg_t      consumerArgs[ SHARDED_STRESS_CONSUMERS ];
+    size_t                  errors = 0;
+    uint64_t                sum    = 0;
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferSharded_Init( &mySharded, myShards, SHARDED_STRESS_PRODUCERS, data,
+                                                       sizeof( data ), sizeof( MpmcTestElement_t ),
+                                                       SHARDED_STRESS_CONSUMERS,
+                                                       ICIRCULARBUFFERSHARDED_PICK_LEAST_LOADED ) );
+
+    for ( uint32_t i = 0; i < SHARDED_STRESS_CONSUMERS; ++i )
+    {
+        consumerArgs[ i ] = (ShardedStressArg_t){ .pSharded = &mySharded, .index = i, .pConsumed = &consumed };
+        CU_ASSERT_EQUAL_FATAL( pthread_create( &consumers[ i ], NULL, ShardedStressConsumer, &consumerArgs[ i ] ), 0 );
+    }
+    for ( uint32_t i = 0; i < SHARDED_STRESS_PRODUCERS; ++i )
+    {
+        producerArgs[ i ] = (ShardedStressArg_t){ .pSharded = &mySharded, .index = i, .pConsumed = &consumed };
+        CU_ASSERT_EQUAL_FATAL( pthread_create( &producers[ i ], NULL, ShardedStressProducer, &producerArgs[ i ] ), 0 );
+    }
+
+    for ( uint32_t i = 0; i < SHARDED_STRESS_PRODUCERS; ++i )
+    {
+        pthread_join( producers[ i ], NULL );
+        errors += producerArgs[ i ].errors;
+    }
+    for ( uint32_t i = 0; i < SHARDED_STRESS_CONSUMERS; ++i )
+    {
+        pthread_join( consumers[ i ], NULL );
+        errors += consumerArgs[ i ].errors;
+        sum    += consumerArgs[ i ].sum;
+    }
+
+    // Every element seen exactly once
+    CU_ASSERT_EQUAL( errors, 0 );
+    CU_ASSERT_EQUAL( atomic_load( &consumed ), SHARDED_STRESS_PRODUCERS * SHARDED_STRESS_ELEMENTS );
+    CU_ASSERT_EQUAL( sum, (uint64_t)SHARDED_STRESS_PRODUCERS * ( (uint64_t)SHARDED_STRESS_ELEMENTS * ( SHARDED_STRESS_ELEMENTS - 1 ) / 2 ) );
+    CU_ASSERT_EQUAL( ICircularBufferSharded_GetCount( &mySharded ), 0 );
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferLatency_Record( void )
+{
+    CircularBufferLatency_t myLatency;
+    uint64_t                value;
 
-    // Initialize circular buffer
-    CU_ASSERT_TRUE_FATAL( ICircularBuffer_Init( &myBuffer, (uint8_t*)&data, sizeof( data ) ) );
+    // Test bad input
+    CU_ASSERT_FALSE( ICircularBufferLatency_Init( NULL ) );
+    CU_ASSERT_FALSE( ICircularBufferLatency_Reset( NULL ) );
+    CU_ASSERT_FALSE( ICircularBufferLatency_Record( NULL, 1 ) );
+    CU_ASSERT_EQUAL( ICircularBufferLatency_GetCount( NULL ), 0 );
 
-    // Base case
-    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 0 );
+    CU_ASSERT_TRUE_FATAL( ICircularBufferLatency_Init( &myLatency ) );
+    CU_ASSERT_EQUAL( ICircularBufferLatency_GetCount( &myLatency ), 0 );
+    CU_ASSERT_FALSE( ICircularBufferLatency_GetPercentile( &myLatency, 50.0, &value ) );
 
-    // Without wraparound, from start
-    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData, 10 );  // 10 bytes written
-    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 10 ); // 0 bytes read
+    // Small values are exact, the extremes of the range have buckets too
+    CU_ASSERT_TRUE( ICircularBufferLatency_Record( &myLatency, 0 ) );
+    CU_ASSERT_TRUE( ICircularBufferLatency_Record( &myLatency, 7 ) );
+    CU_ASSERT_TRUE( ICircularBufferLatency_Record( &myLatency, UINT64_MAX ) );
+    CU_ASSERT_EQUAL( ICircularBufferLatency_GetCount( &myLatency ), 3 );
+    CU_ASSERT_TRUE( ICircularBufferLatency_GetPercentile( &myLatency, 0.0, &value ) );
+    CU_ASSERT_EQUAL( value, 0 );
+    CU_ASSERT_TRUE( ICircularBufferLatency_GetPercentile( &myLatency, 50.0, &value ) );
+    CU_ASSERT_EQUAL( value, 7 );
+    CU_ASSERT_TRUE( ICircularBufferLatency_GetPercentile( &myLatency, 100.0, &value ) );
+    CU_ASSERT_EQUAL( value, UINT64_MAX );
 
-    // Without wraparound, in middle
-    ICircularBuffer_Pop( &myBuffer, (uint8_t*)&dummyBuffer, 10 );
-    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData,  12 ); // 22 bytes written
-    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 12 ); // 10 bytes read
+    // Reset empties it
+    CU_ASSERT_TRUE( ICircularBufferLatency_Reset( &myLatency ) );
+    CU_ASSERT_EQUAL( ICircularBufferLatency_GetCount( &myLatency ), 0 );
+    CU_ASSERT_FALSE( ICircularBufferLatency_GetPercentile( &myLatency, 100.0, &value ) );
+}
 
-    // To end of data buffer
-    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData,  10 ); // 32 bytes written
-    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 22 ); // 10 bytes read
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferLatency_Percentile( void )
+{
+    CircularBufferLatency_t myLatency;
+    uint64_t                value;
 
-    // Wraparound
-    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData,   1 ); // 33 bytes written
-    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 23 ); // 10 bytes read
+    CU_ASSERT_TRUE_FATAL( ICircularBufferLatency_Init( &myLatency ) );
 
-    // Wraparound
-    ICircularBuffer_Pop( &myBuffer, (uint8_t*)&dummyBuffer, 10 );
-    ICircularBuffer_Push( &myBuffer, (uint8_t*)&dummyData,   7 ); // 33 bytes written
-    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 20 ); // 20 bytes read
+    // Test bad input
+    CU_ASSERT_TRUE( ICircularBufferLatency_Record( &myLatency, 1 ) );
+    CU_ASSERT_FALSE( ICircularBufferLatency_GetPercentile( NULL, 50.0, &value ) );
+    CU_ASSERT_FALSE( ICircularBufferLatency_GetPercentile( &myLatency, 50.0, NULL ) );
+    CU_ASSERT_FALSE( ICircularBufferLatency_GetPercentile( &myLatency, -1.0, &value ) );
+    CU_ASSERT_FALSE( ICircularBufferLatency_GetPercentile( &myLatency, 101.0, &value ) );
+    CU_ASSERT_TRUE( ICircularBufferLatency_Reset( &myLatency ) );
+
+    // 1 to 100000 ns once each: every percentile is at or above the exact one, by at most a sixteenth
+    for ( uint64_t i = 1; i <= 100000; ++i )
+    {
+        ICircularBufferLatency_Record( &myLatency, i );
+    }
+    CU_ASSERT_EQUAL( ICircularBufferLatency_GetCount( &myLatency ), 100000 );
+
+    static double const percentiles[] = { 1.0, 10.0, 50.0, 90.0, 99.0, 99.9, 99.99 };
+    for ( size_t i = 0; i < ARR_SIZE( percentiles ); ++i )
+    {
+        uint64_t exact = (uint64_t)( percentiles[ i ] * 1000.0 + 0.5 );
+        CU_ASSERT_TRUE( ICircularBufferLatency_GetPercentile( &myLatency, percentiles[ i ], &value ) );
+        CU_ASSERT( value >= exact );
+        CU_ASSERT( value <= exact + ( exact / ICIRCULARBUFFERLATENCY_SUB_BUCKETS ) );
+    }
+    CU_ASSERT_TRUE( ICircularBufferLatency_GetPercentile( &myLatency, 100.0, &value ) );
+    CU_ASSERT_EQUAL( value, 100000 );
 }
 
 /**
@@ -287,9 +4491,27 @@ void Test_ICircularBuffer_GetCount( void )
  * Test
  * *********************************************************************************************************************
  */
-void Test_ICircularBuffer_Peek( void )
+void Test_ICircularBufferMpmc_Init( void )
 {
-    CU_FAIL( "Not implemented..." );
+    CircularBufferMpmc_t myBuffer;
+    atomic_size_t        data[ 16 ];
+
+    // Test bad input
+    CU_ASSERT_FALSE( ICircularBufferMpmc_Init( NULL, (uint8_t*)data, 4, 4 )          );
+    CU_ASSERT_FALSE( ICircularBufferMpmc_Init( &myBuffer, NULL, 4, 4 )               );
+    CU_ASSERT_FALSE( ICircularBufferMpmc_Init( &myBuffer, (uint8_t*)data, 0, 4 )     );
+    CU_ASSERT_FALSE( ICircularBufferMpmc_Init( &myBuffer, (uint8_t*)data, 1, 4 )     );
+    CU_ASSERT_FALSE( ICircularBufferMpmc_Init( &myBuffer, (uint8_t*)data, 3, 4 )     );
+    CU_ASSERT_FALSE( ICircularBufferMpmc_Init( &myBuffer, (uint8_t*)data, 4, 0 )     );
+    CU_ASSERT_FALSE( ICircularBufferMpmc_Init( &myBuffer, (uint8_t*)data + 1, 4, 4 ) ); // Misaligned
+
+    // Test valid input
+    CU_ASSERT_EQUAL( ICIRCULARBUFFERMPMC_SLOT_SIZE( 1 ),  2 * sizeof( atomic_size_t ) );
+    CU_ASSERT_EQUAL( ICIRCULARBUFFERMPMC_SLOT_SIZE( sizeof( atomic_size_t ) ),  2 * sizeof( atomic_size_t ) );
+    CU_ASSERT_EQUAL( ICIRCULARBUFFERMPMC_BUFFER_SIZE( 8, 1 ), sizeof( data ) );
+    CU_ASSERT_TRUE( ICircularBufferMpmc_Init( &myBuffer, (uint8_t*)data, 8, 1 ) );
+    CU_ASSERT_EQUAL( myBuffer.slotCount, 8 );
+    CU_ASSERT_EQUAL( ICircularBufferMpmc_GetCount( &myBuffer ), 0 );
 }
 
 /**
@@ -297,9 +4519,41 @@ void Test_ICircularBuffer_Peek( void )
  * Test
  * *********************************************************************************************************************
  */
-void Test_ICircularBuffer_Pop( void )
+void Test_ICircularBufferMpmc_PushPop( void )
 {
-    CU_FAIL( "Not implemented..." );
+    CircularBufferMpmc_t myBuffer;
+    atomic_size_t        data[ ICIRCULARBUFFERMPMC_BUFFER_SIZE( 4, sizeof( MpmcTestElement_t ) ) / sizeof( atomic_size_t ) ];
+    MpmcTestElement_t    element = { .producer = 0, .sequence = 0 };
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferMpmc_Init( &myBuffer, (uint8_t*)data, 4, sizeof( MpmcTestElement_t ) ) );
+
+    // Test bad input and empty buffer
+    CU_ASSERT_FALSE( ICircularBufferMpmc_Push( NULL, (uint8_t*)&element ) );
+    CU_ASSERT_FALSE( ICircularBufferMpmc_Push( &myBuffer, NULL )          );
+    CU_ASSERT_FALSE( ICircularBufferMpmc_Pop( NULL, (uint8_t*)&element )  );
+    CU_ASSERT_FALSE( ICircularBufferMpmc_Pop( &myBuffer, NULL )           );
+    CU_ASSERT_FALSE( ICircularBufferMpmc_Pop( &myBuffer, (uint8_t*)&element ) );
+
+    // Fill every slot, then one more
+    for ( element.sequence = 0; element.sequence < 4; ++element.sequence )
+    {
+        CU_ASSERT_TRUE( ICircularBufferMpmc_Push( &myBuffer, (uint8_t*)&element ) );
+    }
+    CU_ASSERT_FALSE( ICircularBufferMpmc_Push( &myBuffer, (uint8_t*)&element ) );
+    CU_ASSERT_EQUAL( ICircularBufferMpmc_GetCount( &myBuffer ), 4 );
+
+    // Elements come out in order, also across laps of the slot array
+    CU_ASSERT_TRUE( ICircularBufferMpmc_Pop( &myBuffer, (uint8_t*)&element ) );
+    CU_ASSERT_EQUAL( element.sequence, 0 );
+    element.sequence = 4;
+    CU_ASSERT_TRUE( ICircularBufferMpmc_Push( &myBuffer, (uint8_t*)&element ) );
+    for ( uint32_t i = 1; i <= 4; ++i )
+    {
+        CU_ASSERT_TRUE( ICircularBufferMpmc_Pop( &myBuffer, (uint8_t*)&element ) );
+        CU_ASSERT_EQUAL( element.sequence, i );
+    }
+    CU_ASSERT_FALSE( ICircularBufferMpmc_Pop( &myBuffer, (uint8_t*)&element ) );
+    CU_ASSERT_EQUAL( ICircularBufferMpmc_GetCount( &myBuffer ), 0 );
 }
 
 /**
@@ -307,9 +4561,41 @@ void Test_ICircularBuffer_Pop( void )
  * Test
  * *********************************************************************************************************************
  */
-void Test_ICircularBuffer_Push( void )
+void Test_ICircularBufferMpmc_Stress( void )
 {
-    CU_FAIL( "Not implemented..." );
+    CircularBufferMpmc_t myBuffer;
+    static atomic_size_t data[ ICIRCULARBUFFERMPMC_BUFFER_SIZE( 64, sizeof( MpmcTestElement_t ) ) / sizeof( atomic_size_t ) ];
+    atomic_size_t        consumed = 0;
+    pthread_t            producers[ MPMC_STRESS_THREADS ];
+    pthread_t            consumers[ MPMC_STRESS_THREADS ];
+    MpmcStressArg_t      producerArgs[ MPMC_STRESS_THREADS ];
+    MpmcStressArg_t      consumerArgs[ MPMC_STRESS_THREADS ];
+    size_t               errors = 0;
+    uint64_t             sum    = 0;
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferMpmc_Init( &myBuffer, (uint8_t*)data, 64, sizeof( MpmcTestElement_t ) ) );
+
+    for ( uint32_t i = 0; i < MPMC_STRESS_THREADS; ++i )
+    {
+        producerArgs[ i ] = (MpmcStressArg_t){ .pCircularBuffer = &myBuffer, .index = i, .pConsumed = &consumed };
+        consumerArgs[ i ] = (MpmcStressArg_t){ .pCircularBuffer = &myBuffer, .index = i, .pConsumed = &consumed };
+        CU_ASSERT_EQUAL_FATAL( pthread_create( &consumers[ i ], NULL, MpmcStressConsumer, &consumerArgs[ i ] ), 0 );
+        CU_ASSERT_EQUAL_FATAL( pthread_create( &producers[ i ], NULL, MpmcStressProducer, &producerArgs[ i ] ), 0 );
+    }
+
+    for ( uint32_t i = 0; i < MPMC_STRESS_THREADS; ++i )
+    {
+        pthread_join( producers[ i ], NULL );
+        pthread_join( consumers[ i ], NULL );
+        errors += consumerArgs[ i ].errors;
+        sum    += consumerArgs[ i ].sum;
+    }
+
+    // Every element seen exactly once
+    CU_ASSERT_EQUAL( errors, 0 );
+    CU_ASSERT_EQUAL( atomic_load( &consumed ), MPMC_STRESS_THREADS * MPMC_STRESS_ELEMENTS );
+    CU_ASSERT_EQUAL( sum, (uint64_t)MPMC_STRESS_THREADS * ( (uint64_t)MPMC_STRESS_ELEMENTS * ( MPMC_STRESS_ELEMENTS - 1 ) / 2 ) );
+    CU_ASSERT_EQUAL( ICircularBufferMpmc_GetCount( &myBuffer ), 0 );
 }
 
 /**
@@ -317,9 +4603,83 @@ void Test_ICircularBuffer_Push( void )
  * Test
  * *********************************************************************************************************************
  */
-void Test_ICircularBuffer_Clear( void )
+void Test_ICircularBufferMirror_Init( void )
+{
+    CircularBuffer_t myBuffer;
+
+    // Test bad input
+    CU_ASSERT_FALSE( ICircularBufferMirror_Init( NULL, 4096 )          );
+    CU_ASSERT_FALSE( ICircularBufferMirror_Init( &myBuffer, 0 )        );
+    CU_ASSERT_FALSE( ICircularBufferMirror_Init( &myBuffer, 256 )      );  // Not a multiple of page size
+    CU_ASSERT_FALSE( ICircularBufferMirror_Init( &myBuffer, 3 * 4096 ) );  // Not power of 2
+    CU_ASSERT_FALSE( ICircularBufferMirror_Deinit( NULL )              );
+
+    // Test valid input
+    CU_ASSERT_TRUE_FATAL( ICircularBufferMirror_Init( &myBuffer, 4096 ) );
+    CU_ASSERT_PTR_NOT_NULL( myBuffer.pBuffer );
+    CU_ASSERT_EQUAL( myBuffer.bufferSize, 4096 );
+    CU_ASSERT_TRUE( myBuffer.mirrored );
+    CU_ASSERT_EQUAL( ICircularBuffer_GetCount( &myBuffer ), 0 );
+
+    // Both halves are the same memory
+    myBuffer.pBuffer[ 10 ] = 0xA5;
+    CU_ASSERT_EQUAL( myBuffer.pBuffer[ 4096 + 10 ], 0xA5 );
+
+    CU_ASSERT_TRUE( ICircularBufferMirror_Deinit( &myBuffer ) );
+    CU_ASSERT_FALSE( ICircularBufferMirror_Deinit( &myBuffer ) );   // Already released
+}
+
+/**
+ * *********************************************************************************************************************
+ * Test
+ * *********************************************************************************************************************
+ */
+void Test_ICircularBufferMirror_Contiguous( void )
 {
-    CU_FAIL( "Not implemented..." );
+    CircularBuffer_t        myBuffer;
+    uint8_t const           *pPeek    = NULL;
+    uint8_t                 *pReserve = NULL;
+    CircularBufferSegment_t segments[ ICIRCULARBUFFER_SEGMENT_COUNT ];
+
+    static uint8_t          dummyBuffer[ 4096 ];
+    static uint8_t          dummyData[ 4096 ];
+
+    for ( size_t i = 0; i < sizeof( dummyData ); ++i )
+    {
+        dummyData[ i ] = (uint8_t)( i % 251 );
+    }
+
+    CU_ASSERT_TRUE_FATAL( ICircularBufferMirror_Init( &myBuffer, 4096 ) );
+
+    // Move read and write pointers close to the end of buffer memory
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, dummyData, 4000 ), 4000 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, dummyBuffer, 4000 ), 4000 );
+
+    // Reserve is one span across the wraparound
+    CU_ASSERT_EQUAL( ICircularBuffer_Reserve( &myBuffer, &pReserve, 200 ), 200 );
+    CU_ASSERT_EQUAL( pReserve, myBuffer.pBuffer + 4000 );
+    memcpy( pReserve, dummyData, 200 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Commit( &myBuffer, 200 ), 200 );
+
+    // Peek is one span across the wraparound, wrapped part also visible at start of buffer memory
+    CU_ASSERT_EQUAL( ICircularBuffer_Peek( &myBuffer, &pPeek ), 200 );
+    CU_ASSERT_EQUAL( pPeek, myBuffer.pBuffer + 4000 );
+    CU_ASSERT_EQUAL( memcmp( pPeek, dummyData, 200 ), 0 );
+    CU_ASSERT_EQUAL( memcmp( myBuffer.pBuffer, &dummyData[ 96 ], 104 ), 0 );
+
+    // PeekV never needs a second segment
+    CU_ASSERT_EQUAL( ICircularBuffer_PeekV( &myBuffer, segments ), 200 );
+    CU_ASSERT_EQUAL( segments[ 0 ].size, 200 );
+    CU_ASSERT_EQUAL( segments[ 1 ].size, 0   );
+
+    // Copying push and pop still work across the wraparound
+    CU_ASSERT_EQUAL( ICircularBuffer_Push( &myBuffer, dummyData, 4096 ), 4096 - 200 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, dummyBuffer, 200 ), 200 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData, 200 ), 0 );
+    CU_ASSERT_EQUAL( ICircularBuffer_Pop( &myBuffer, dummyBuffer, 4096 ), 4096 - 200 );
+    CU_ASSERT_EQUAL( memcmp( dummyBuffer, dummyData, 4096 - 200 ), 0 );
+
+    CU_ASSERT_TRUE( ICircularBufferMirror_Deinit( &myBuffer ) );
 }
 
 /**
@@ -348,12 +4708,267 @@ int main()
 
     // Add tests to the suite
     if (
-        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_Init",      Test_ICircularBuffer_Init       ) ) ||
-        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_GetCount",  Test_ICircularBuffer_GetCount   ) ) ||
-        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_Peek",      Test_ICircularBuffer_Peek       ) ) ||
-        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_Pop",       Test_ICircularBuffer_Pop        ) ) ||
-        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_Push",      Test_ICircularBuffer_Push       ) ) ||
-        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_Clear",     Test_ICircularBuffer_Clear      ) )
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_Init",                   Test_ICircularBuffer_Init       ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_GetCount",               Test_ICircularBuffer_GetCount   ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_Peek",                   Test_ICircularBuffer_Peek       ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_PeekV",                  Test_ICircularBuffer_PeekV      ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_Find/FindPattern",       Test_ICircularBuffer_Find       ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_Pop",                    Test_ICircularBuffer_Pop        ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_Push",                   Test_ICircularBuffer_Push       ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_Reserve",                Test_ICircularBuffer_Reserve    ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_ReserveV",               Test_ICircularBuffer_ReserveV   ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_Commit",                 Test_ICircularBuffer_Commit     ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_Release",                Test_ICircularBuffer_Release    ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_Clear",                  Test_ICircularBuffer_Clear      ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_Statistics",             Test_ICircularBuffer_Statistics ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_OpenDataFd/OpenSpaceFd", Test_ICircularBuffer_Notify     ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_CrcBegin/CrcGet",        Test_ICircularBuffer_Crc        ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_SetBulkThreshold",       Test_ICircularBuffer_Bulk       ) )
+    )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    // Add single-producer/single-consumer suite to registry
+    pSuite = CU_add_suite( "Spsc", InitSpscSuite, CleanSpscSuite );
+    if ( NULL == pSuite )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    if (
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferSpsc_Init",             Test_ICircularBufferSpsc_Init        ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferSpsc_Push/Pop",         Test_ICircularBufferSpsc_PushPop     ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferSpsc_Peek",             Test_ICircularBufferSpsc_Peek        ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferSpsc_Clear",            Test_ICircularBufferSpsc_Clear       ) ) ||
+        ( NULL == CU_add_test( pSuite, "Stress of ICircularBufferSpsc threads",        Test_ICircularBufferSpsc_Stress      ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferSpsc_PopWait/PushWait", Test_ICircularBufferSpsc_Wait        ) ) ||
+        ( NULL == CU_add_test( pSuite, "Stress of ICircularBufferSpsc blocking calls", Test_ICircularBufferSpsc_WaitStress  ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferSpsc batches",          Test_ICircularBufferSpsc_Batch       ) ) ||
+        ( NULL == CU_add_test( pSuite, "Stress of ICircularBufferSpsc batches",        Test_ICircularBufferSpsc_BatchStress ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferSpsc_TraceDwell",       Test_ICircularBufferSpsc_Dwell       ) ) ||
+        ( NULL == CU_add_test( pSuite, "Stress of ICircularBufferSpsc dwell tracing",  Test_ICircularBufferSpsc_DwellStress ) )
+    )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    // Add multi-producer/multi-consumer suite to registry
+    pSuite = CU_add_suite( "Mpmc", InitMpmcSuite, CleanMpmcSuite );
+    if ( NULL == pSuite )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    if (
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferMpmc_Init",      Test_ICircularBufferMpmc_Init       ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferMpmc_Push/Pop",  Test_ICircularBufferMpmc_PushPop    ) ) ||
+        ( NULL == CU_add_test( pSuite, "Stress of ICircularBufferMpmc threads", Test_ICircularBufferMpmc_Stress     ) )
+    )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    // Add mirrored memory suite to registry
+    pSuite = CU_add_suite( "Mirror", InitMirrorSuite, CleanMirrorSuite );
+    if ( NULL == pSuite )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    if (
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferMirror_Init",    Test_ICircularBufferMirror_Init       ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of contiguous mirrored access",    Test_ICircularBufferMirror_Contiguous ) )
+    )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    // Add overwrite mode suite to registry
+    pSuite = CU_add_suite( "Overwrite", InitOverwriteSuite, CleanOverwriteSuite );
+    if ( NULL == pSuite )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    if (
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_InitOverwrite", Test_ICircularBuffer_InitOverwrite  ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of overwriting push",              Test_ICircularBuffer_PushOverwrite  ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_ReadAt",        Test_ICircularBuffer_ReadAt         ) ) ||
+        ( NULL == CU_add_test( pSuite, "Stress of overwriting push and reader", Test_ICircularBuffer_OverwriteStress ) )
+    )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    // Add broadcast suite to registry
+    pSuite = CU_add_suite( "Broadcast", InitBroadcastSuite, CleanBroadcastSuite );
+    if ( NULL == pSuite )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    if (
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferBroadcast_Init",         Test_ICircularBufferBroadcast_Init        ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferBroadcast_Push/Pop",     Test_ICircularBufferBroadcast_PushPop     ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferBroadcast_Peek/Release", Test_ICircularBufferBroadcast_PeekRelease ) ) ||
+        ( NULL == CU_add_test( pSuite, "Stress of ICircularBufferBroadcast threads",    Test_ICircularBufferBroadcast_Stress      ) )
+    )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    // Add file descriptor I/O suite to registry
+    pSuite = CU_add_suite( "Fd", InitFdSuite, CleanFdSuite );
+    if ( NULL == pSuite )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    if (
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferFd_ReadFromFd", Test_ICircularBufferFd_ReadFromFd ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferFd_WriteToFd",  Test_ICircularBufferFd_WriteToFd  ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of partial fd I/O and EAGAIN",    Test_ICircularBufferFd_Partial    ) )
+    )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    // Add shared memory suite to registry
+    pSuite = CU_add_suite( "Shm", InitShmSuite, CleanShmSuite );
+    if ( NULL == pSuite )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    if (
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferShm_Create/Attach", Test_ICircularBufferShm_CreateAttach ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferShm_Push/Pop",      Test_ICircularBufferShm_PushPop      ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferShm across fork",   Test_ICircularBufferShm_Process      ) )
+    )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    // Add typed element suite to registry
+    pSuite = CU_add_suite( "Typed", InitTypedSuite, CleanTypedSuite );
+    if ( NULL == pSuite )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    if (
+        ( NULL == CU_add_test( pSuite, "Test of typed Push/Pop/Peek", Test_ICircularBufferTyped_PushPop   ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of typed PushN/PopN",    Test_ICircularBufferTyped_PushNPopN ) )
+    )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    // Add record suite to registry
+    pSuite = CU_add_suite( "Record", InitRecordSuite, CleanRecordSuite );
+    if ( NULL == pSuite )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    if (
+        ( NULL == CU_add_test( pSuite, "Test of record Push/Peek/Pop",       Test_ICircularBufferRecord_PushPop   ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of record PeekBatch/PopBatch",  Test_ICircularBufferRecord_Batch     ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of records on growable buffer", Test_ICircularBufferRecord_Growable  ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of records with running CRC",   Test_ICircularBufferRecord_Crc       ) )
+    )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    // Add growable mode suite to registry
+    pSuite = CU_add_suite( "Growable", InitGrowableSuite, CleanGrowableSuite );
+    if ( NULL == pSuite )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    if (
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBuffer_InitGrowable",   Test_ICircularBuffer_InitGrowable      ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of growable grow and shrink",       Test_ICircularBuffer_GrowShrink        ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of growable with custom allocator", Test_ICircularBuffer_GrowableAllocator ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of growable with notifications",    Test_ICircularBuffer_GrowableNotify    ) )
+    )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    // Add journal suite to registry
+    pSuite = CU_add_suite( "Journal", InitJournalSuite, CleanJournalSuite );
+    if ( NULL == pSuite )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    if (
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferJournal_Open and Close", Test_ICircularBufferJournal_OpenClose  ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferJournal sync policies",  Test_ICircularBufferJournal_Sync       ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferJournal_SyncFailed",     Test_ICircularBufferJournal_SyncFailed ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferJournal commit ordering", Test_ICircularBufferJournal_CommitOrder ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferJournal writer crash",   Test_ICircularBufferJournal_Crash      ) )
+    )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    // Add sharded suite to registry
+    pSuite = CU_add_suite( "Sharded", InitShardedSuite, CleanShardedSuite );
+    if ( NULL == pSuite )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    if (
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferSharded_Init and Attach", Test_ICircularBufferSharded_Init    ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferSharded push and pop",    Test_ICircularBufferSharded_PushPop ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferSharded stress",          Test_ICircularBufferSharded_Stress  ) )
+    )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    // Add latency histogram suite to registry
+    pSuite = CU_add_suite( "Latency", InitLatencySuite, CleanLatencySuite );
+    if ( NULL == pSuite )
+    {
+        CU_cleanup_registry();
+        return CU_get_error();
+    }
+
+    if (
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferLatency_Record",        Test_ICircularBufferLatency_Record     ) ) ||
+        ( NULL == CU_add_test( pSuite, "Test of ICircularBufferLatency_GetPercentile", Test_ICircularBufferLatency_Percentile ) )
     )
     {
         CU_cleanup_registry();